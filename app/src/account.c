@@ -17,6 +17,8 @@
 #include "zxmacros.h"
 #include "stdbool.h"
 #include "apdu_codes.h"
+#include "crypto.h"
+#include <os_io_seproxyhal.h>
 
 typedef enum {
     SLOT_OP_SET,
@@ -32,10 +34,77 @@ slot_store_t NV_CONST
 N_slot_store_impl __attribute__ ((aligned(64)));
 #define N_slot_store (*(NV_VOLATILE slot_store_t *)PIC(&N_slot_store_impl))
 
+// The slot store as it will be once the staged import is approved.
+// committing is set while it is copied to N_slot_store, an interrupted copy is finished at start.
+typedef struct {
+    slot_store_t store;
+    uint8_t committing;
+} slot_import_store_t;
+
+slot_import_store_t NV_CONST
+N_slot_import_impl __attribute__ ((aligned(64)));
+#define N_slot_import (*(NV_VOLATILE slot_import_store_t *)PIC(&N_slot_import_impl))
+
+// Slots changed by the staged import, one bit per slot
+typedef struct {
+    uint8_t count;
+    uint8_t staged[SLOT_COUNT / 8];
+} slot_import_t;
+
+slot_import_t slot_import;
+
 uint8_t slot_is_empty(const account_slot_t *tmp) {
     return tmp->path.data[0] == 0;
 }
 
+// Reverse index from account to slot, open addressing over twice as many buckets as slots.
+// A bucket holds the slot index plus one, zero marks it as free.
+#define SLOT_INDEX_SIZE         (2 * SLOT_COUNT)
+uint8_t slot_index[SLOT_INDEX_SIZE];
+
+__Z_INLINE uint8_t slot_indexBucket(const uint8_t *account) {
+    uint8_t h = 0;
+    for (uint8_t i = 0; i < SLOT_ACCOUNT_SIZE; i++) {
+        h = (uint8_t) (h * 31 + account[i]);
+    }
+    return h & (SLOT_INDEX_SIZE - 1);
+}
+
+void slot_indexRebuild(void) {
+    MEMZERO(slot_index, sizeof(slot_index));
+    for (uint8_t i = 0; i < SLOT_COUNT; i++) {
+        const account_slot_t *tmp = &N_slot_store.slot[i];
+        if (slot_is_empty(tmp)) {
+            continue;
+        }
+        // There are more buckets than slots, a free one is always found
+        uint8_t b = slot_indexBucket(tmp->account.data);
+        while (slot_index[b] != 0) {
+            b = (b + 1) & (SLOT_INDEX_SIZE - 1);
+        }
+        slot_index[b] = i + 1;
+    }
+}
+
+zxerr_t slot_findAccount(const uint8_t account[SLOT_ACCOUNT_SIZE], uint8_t *slotIdx) {
+    // Slots were inserted in order, so the first match is the lowest slot
+    for (uint8_t b = slot_indexBucket(account); slot_index[b] != 0; b = (b + 1) & (SLOT_INDEX_SIZE - 1)) {
+        const account_slot_t *tmp = &N_slot_store.slot[slot_index[b] - 1];
+        if (MEMCMP(tmp->account.data, account, SLOT_ACCOUNT_SIZE) == 0) {
+            *slotIdx = slot_index[b] - 1;
+            return zxerr_ok;
+        }
+    }
+    return zxerr_no_data;
+}
+
+static bool slot_path_is_valid(const account_slot_t *tmp) {
+    const bool mainnet = tmp->path.data[0] == HDPATH_0_DEFAULT && tmp->path.data[1] == HDPATH_1_DEFAULT;
+    const bool testnet = tmp->path.data[0] == HDPATH_0_TESTNET && tmp->path.data[1] == HDPATH_1_TESTNET;
+    const bool empty = tmp->path.data[0] == 0 && tmp->path.data[1] == 0;
+    return mainnet || testnet || empty;
+}
+
 zxerr_t slot_getNumItems(uint8_t *num_items) {
     *num_items = 0;
     switch (tmp_slotop) {
@@ -188,6 +257,37 @@ zxerr_t slot_getSlot(uint8_t slotIndex, uint8_t *out, uint16_t outLen) {
     return zxerr_ok;
 }
 
+zxerr_t slot_export(uint8_t first, uint8_t *out, uint16_t outLen, uint16_t *written) {
+    *written = 0;
+    if (first > SLOT_COUNT) {
+        return zxerr_out_of_bounds;
+    }
+    if (outLen < 1 + SLOT_EXPORT_ENTRY_SIZE) {
+        return zxerr_buffer_too_small;
+    }
+
+    uint16_t pos = 1;
+    uint8_t i = first;
+    for (; i < SLOT_COUNT && pos + SLOT_EXPORT_ENTRY_SIZE <= outLen; i++) {
+        const account_slot_t *tmp = &N_slot_store.slot[i];
+        if (slot_is_empty(tmp)) {
+            continue;
+        }
+        out[pos] = i;
+        MEMCPY(out + pos + 1, tmp, sizeof(account_slot_t));
+        pos += SLOT_EXPORT_ENTRY_SIZE;
+    }
+
+    // Empty slots after the last entry need not be visited again
+    while (i < SLOT_COUNT && slot_is_empty(&N_slot_store.slot[i])) {
+        i++;
+    }
+
+    out[0] = i;
+    *written = pos;
+    return zxerr_ok;
+}
+
 zxerr_t slot_parseSlot(uint8_t *buffer, uint16_t bufferLen) {
     zemu_log_stack("slot_parseSlot");
     char bufferUI[50];
@@ -206,11 +306,7 @@ zxerr_t slot_parseSlot(uint8_t *buffer, uint16_t bufferLen) {
 
     MEMCPY(&tmp_slot, buffer + 1, sizeof(account_slot_t));
 
-    const bool mainnet = tmp_slot.path.data[0] == HDPATH_0_DEFAULT && tmp_slot.path.data[1] == HDPATH_1_DEFAULT;
-    const bool testnet = tmp_slot.path.data[0] == HDPATH_0_TESTNET && tmp_slot.path.data[1] == HDPATH_1_TESTNET;
-    const bool empty = tmp_slot.path.data[0] == 0 && tmp_slot.path.data[1] == 0;
-
-    if (!mainnet && !testnet && !empty) {
+    if (!slot_path_is_valid(&tmp_slot)) {
         array_to_hexstr(bufferUI, sizeof(bufferUI), tmp_slot.account.data, 8);
         zemu_log(bufferUI);
         zemu_log("\n");
@@ -235,6 +331,184 @@ zxerr_t slot_parseSlot(uint8_t *buffer, uint16_t bufferLen) {
 
 void app_slot_setSlot() {
     MEMCPY_NV(&N_slot_store.slot[tmp_slotIdx], &tmp_slot, sizeof(account_slot_t));
+    // The staged import copied the store before this change
+    slot_importReset();
+    slot_indexRebuild();
+    crypto_pubkeyCacheClear();
+    set_code(G_io_apdu_buffer, 0, APDU_CODE_OK);
+    io_exchange(CHANNEL_APDU | IO_RETURN_AFTER_TX, 2);
+}
+
+void slot_importReset() {
+    MEMZERO(&slot_import, sizeof(slot_import));
+}
+
+uint8_t slot_importCount() {
+    return slot_import.count;
+}
+
+__Z_INLINE bool slot_importStaged(uint8_t index) {
+    return (slot_import.staged[index / 8] & (1u << (index % 8))) != 0;
+}
+
+zxerr_t slot_importAdd(const uint8_t *buffer, uint16_t bufferLen) {
+    if (bufferLen == 0 || bufferLen % SLOT_EXPORT_ENTRY_SIZE != 0) {
+        return zxerr_encoding_failed;
+    }
+
+    // Everything is checked first so a rejected request stages nothing
+    uint8_t newEntries = 0;
+    for (uint16_t pos = 0; pos < bufferLen; pos += SLOT_EXPORT_ENTRY_SIZE) {
+        account_slot_t tmp;
+        MEMCPY(&tmp, buffer + pos + 1, sizeof(account_slot_t));
+        if (buffer[pos] >= SLOT_COUNT || !slot_path_is_valid(&tmp)) {
+            return zxerr_out_of_bounds;
+        }
+
+        bool staged = slot_importStaged(buffer[pos]);
+        for (uint16_t prev = 0; prev < pos && !staged; prev += SLOT_EXPORT_ENTRY_SIZE) {
+            staged = buffer[prev] == buffer[pos];
+        }
+        newEntries += staged ? 0 : 1;
+    }
+    if (slot_import.count + newEntries > SLOT_IMPORT_MAX) {
+        return zxerr_buffer_too_small;
+    }
+
+    // The first change starts the staged store from the current one
+    if (slot_import.count == 0) {
+        MEMCPY_NV(&N_slot_import.store, &N_slot_store, sizeof(slot_store_t));
+    }
+
+    for (uint16_t pos = 0; pos < bufferLen; pos += SLOT_EXPORT_ENTRY_SIZE) {
+        const uint8_t index = buffer[pos];
+        if (!slot_importStaged(index)) {
+            slot_import.staged[index / 8] |= (uint8_t) (1u << (index % 8));
+            slot_import.count++;
+        }
+        MEMCPY_NV(&N_slot_import.store.slot[index], buffer + pos + 1, sizeof(account_slot_t));
+    }
+
+    return zxerr_ok;
+}
+
+__Z_INLINE slotop_t slot_importOp(uint8_t index) {
+    if (slot_is_empty(&N_slot_import.store.slot[index])) {
+        return SLOT_UP_DELETE;
+    }
+    return slot_is_empty(&N_slot_store.slot[index]) ? SLOT_OP_SET : SLOT_OP_UPDATE;
+}
+
+// Slots, then set / update / delete counts, then operation and account of each slot and its path unless deleted
+#define SLOT_IMPORT_SUMMARY_ITEMS 4
+
+#if SLOT_IMPORT_SUMMARY_ITEMS + 2 * SLOT_IMPORT_MAX > 127
+#error "the import review does not fit the int8_t item index of the view"
+#endif
+
+__Z_INLINE uint8_t slot_importEntryItems(uint8_t index) {
+    return slot_importOp(index) == SLOT_UP_DELETE ? 1 : 2;
+}
+
+zxerr_t slot_importGetNumItems(uint8_t *num_items) {
+    *num_items = SLOT_IMPORT_SUMMARY_ITEMS;
+    for (uint8_t i = 0; i < SLOT_COUNT; i++) {
+        if (slot_importStaged(i)) {
+            *num_items += slot_importEntryItems(i);
+        }
+    }
+    return zxerr_ok;
+}
+
+zxerr_t slot_importGetItem(int8_t displayIdx,
+                           char *outKey, uint16_t outKeyLen,
+                           char *outVal, uint16_t outValLen,
+                           uint8_t pageIdx, uint8_t *pageCount) {
+    *pageCount = 1;
+    if (displayIdx < 0) {
+        return zxerr_no_data;
+    }
+
+    if (displayIdx < SLOT_IMPORT_SUMMARY_ITEMS) {
+        const char *const keys[] = {"Import", "Set", "Update", "Delete"};
+        uint8_t counts[SLOT_IMPORT_SUMMARY_ITEMS] = {slot_import.count, 0, 0, 0};
+        for (uint8_t i = 0; i < SLOT_COUNT; i++) {
+            if (slot_importStaged(i)) {
+                counts[1 + slot_importOp(i)]++;
+            }
+        }
+        snprintf(outKey, outKeyLen, "%s", keys[displayIdx]);
+        snprintf(outVal, outValLen, displayIdx == 0 ? "%d slots" : "%d", counts[displayIdx]);
+        return zxerr_ok;
+    }
+
+    uint8_t item = (uint8_t) (displayIdx - SLOT_IMPORT_SUMMARY_ITEMS);
+    for (uint8_t i = 0; i < SLOT_COUNT; i++) {
+        if (!slot_importStaged(i)) {
+            continue;
+        }
+        const account_slot_t *staged = &N_slot_import.store.slot[i];
+        const uint8_t n = slot_importEntryItems(i);
+        if (item >= n) {
+            item -= n;
+            continue;
+        }
+
+        if (item == 0) {
+            const char *const ops[] = {"Set", "Update", "Delete"};
+            const account_slot_t *shown = slot_importOp(i) == SLOT_UP_DELETE ? &N_slot_store.slot[i] : staged;
+            char account[2 * SLOT_ACCOUNT_SIZE + 1];
+            array_to_hexstr(account, sizeof(account), shown->account.data, SLOT_ACCOUNT_SIZE);
+            snprintf(outKey, outKeyLen, "%s %d", ops[slot_importOp(i)], i);
+            snprintf(outVal, outValLen, "%s", account);
+            return zxerr_ok;
+        }
+
+        char bufferUI[130];
+        snprintf(outKey, outKeyLen, "Path %d", i);
+        bip32_to_str(bufferUI, sizeof(bufferUI), staged->path.data, HDPATH_LEN_DEFAULT);
+        pageString(outVal, outValLen, bufferUI, pageIdx, pageCount);
+        return zxerr_ok;
+    }
+
+    return zxerr_no_data;
+}
+
+// Copies the staged store over the slots from first to last, then clears the commit flag
+static void slot_importCopy(uint8_t first, uint8_t last) {
+    const uint8_t idle = 0;
+    MEMCPY_NV(&N_slot_store.slot[first], &N_slot_import.store.slot[first],
+              (last - first + 1) * sizeof(account_slot_t));
+    MEMCPY_NV(&N_slot_import.committing, &idle, sizeof(idle));
+}
+
+void slot_importFinish(void) {
+    if (N_slot_import.committing == 1) {
+        slot_importCopy(0, SLOT_COUNT - 1);
+    }
+}
+
+void app_slot_import() {
+    uint8_t lo = SLOT_COUNT;
+    uint8_t hi = 0;
+    for (uint8_t i = 0; i < SLOT_COUNT; i++) {
+        if (slot_importStaged(i)) {
+            lo = i < lo ? i : lo;
+            hi = i;
+        }
+    }
+
+    // The flag makes the commit a single step: once it is set, the staged store is copied, even after a restart.
+    // Only the range between the first and last changed slot is written.
+    if (lo < SLOT_COUNT) {
+        const uint8_t committing = 1;
+        MEMCPY_NV(&N_slot_import.committing, &committing, sizeof(committing));
+        slot_importCopy(lo, hi);
+    }
+
+    slot_importReset();
+    slot_indexRebuild();
+    crypto_pubkeyCacheClear();
     set_code(G_io_apdu_buffer, 0, APDU_CODE_OK);
     io_exchange(CHANNEL_APDU | IO_RETURN_AFTER_TX, 2);
 }
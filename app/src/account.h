@@ -57,10 +57,51 @@ zxerr_t slot_status(uint8_t *out, uint16_t outLen);
 
 zxerr_t slot_getSlot(uint8_t slotIndex, uint8_t *out, uint16_t outLen);
 
+// Export entry: slot index followed by the slot
+#define SLOT_EXPORT_ENTRY_SIZE  (1 + sizeof(account_slot_t))
+
+/// Packs the occupied slots from first on as [next][index, account, path]...
+/// next is the index to continue from, SLOT_COUNT once every slot was visited
+zxerr_t slot_export(uint8_t first, uint8_t *out, uint16_t outLen, uint16_t *written);
+
+/// Rebuilds the account to slot index from flash, needed after every slot change
+void slot_indexRebuild(void);
+
+/// Looks up the lowest slot holding account
+/// \return zxerr_no_data when no slot holds it
+zxerr_t slot_findAccount(const uint8_t account[SLOT_ACCOUNT_SIZE], uint8_t *slotIdx);
+
 zxerr_t slot_parseSlot(uint8_t *buffer, uint16_t bufferLen);
 
 void app_slot_setSlot();
 
+// Slot changes an import can stage, the review of a full import has to fit the int8_t item index of the view
+// (4 + 2 items per slot). The changes are staged in flash, next to the slot store.
+#define SLOT_IMPORT_MAX         61
+
+/// Drops the staged slot changes
+void slot_importReset();
+
+/// Stages [index, account, path] entries, formatted as in slot_export. An empty slot deletes it.
+/// A later entry for the same index replaces the earlier one.
+zxerr_t slot_importAdd(const uint8_t *buffer, uint16_t bufferLen);
+
+uint8_t slot_importCount();
+
+/// Review of the staged changes: counts per operation, then each slot
+zxerr_t slot_importGetNumItems(uint8_t *num_items);
+
+zxerr_t slot_importGetItem(int8_t displayIdx,
+                           char *outKey, uint16_t outKeyLen,
+                           char *outVal, uint16_t outValLen,
+                           uint8_t pageIdx, uint8_t *pageCount);
+
+/// Writes the staged changes with one NV write over the changed slots
+void app_slot_import();
+
+/// Finishes an import commit cut by a power loss, called at start before the slot index is built
+void slot_importFinish(void);
+
 #ifdef __cplusplus
 }
 #endif
@@ -49,7 +49,75 @@ __Z_INLINE void handleGetPubkey(volatile uint32_t *flags, volatile uint32_t *tx,
     THROW(APDU_CODE_OK);
 }
 
+__Z_INLINE void handleGetPubkeys(volatile uint32_t *flags, volatile uint32_t *tx, uint32_t rx) {
+    const uint8_t compressed = G_io_apdu_buffer[OFFSET_P1];
+    if (compressed > 1 || G_io_apdu_buffer[OFFSET_P2] != 0) {
+        THROW(APDU_CODE_INVALIDP1P2);
+    }
+
+    if (rx < OFFSET_DATA + 1) {
+        THROW(APDU_CODE_WRONG_LENGTH);
+    }
+
+    const uint8_t count = G_io_apdu_buffer[OFFSET_DATA];
+    const uint16_t keyLen = compressed ? PK_COMPRESSED_LEN : SECP256K1_PK_LEN;
+    if (count == 0 || count * keyLen > IO_APDU_BUFFER_SIZE - 2) {
+        THROW(APDU_CODE_DATA_INVALID);
+    }
+
+    const uint32_t pathSize = sizeof(uint32_t) * HDPATH_LEN_DEFAULT;
+    if (rx != OFFSET_DATA + 1 + count * pathSize) {
+        THROW(APDU_CODE_WRONG_LENGTH);
+    }
+
+    // The keys overwrite the request, so all paths are read first
+    uint32_t paths[GET_PUBKEYS_MAX_COUNT][HDPATH_LEN_DEFAULT];
+    for (uint8_t i = 0; i < count; i++) {
+        extractHDPathTo(paths[i], rx, OFFSET_DATA + 1 + i * pathSize);
+    }
+
+    uint16_t replyLen = 0;
+    zxerr_t err = crypto_fillPublicKeys(paths[0], count, compressed, G_io_apdu_buffer, IO_APDU_BUFFER_SIZE - 2, &replyLen);
+    if (err != zxerr_ok) {
+        THROW(APDU_CODE_EXECUTION_ERROR);
+    }
+
+    *tx = replyLen;
+    THROW(APDU_CODE_OK);
+}
+
+__Z_INLINE void handleSignSessionPath(volatile uint32_t *flags, volatile uint32_t *tx, uint32_t rx) {
+    if (G_io_apdu_buffer[OFFSET_P2] != 0) {
+        THROW(APDU_CODE_INVALIDP1P2);
+    }
+
+    if (!tx_session_active()) {
+        THROW(APDU_CODE_CONDITIONS_NOT_SATISFIED);
+    }
+
+    // The transaction is not parsed or reviewed again, only the new path is confirmed
+    extractHDPath(rx, OFFSET_DATA);
+
+    view_review_init(tx_session_getItem, tx_session_getNumItems, app_sign_session);
+    view_review_show();
+    *flags |= IO_ASYNCH_REPLY;
+}
+
 __Z_INLINE void handleSign(volatile uint32_t *flags, volatile uint32_t *tx, uint32_t rx) {
+    if (G_io_apdu_buffer[OFFSET_PAYLOAD_TYPE] == PAYLOAD_TYPE_SESSION_PATH) {
+        handleSignSessionPath(flags, tx, rx);
+        return;
+    }
+
+#if defined(HAVE_TX_BATCH)
+    // Chunks of a pending batch only come through INS_SIGN_BATCH, they would extend its last transaction
+    if (tx_batch_active() && G_io_apdu_buffer[OFFSET_PAYLOAD_TYPE] != PAYLOAD_TYPE_INIT) {
+        tx_reset();
+        upload_close();
+        THROW(APDU_CODE_CONDITIONS_NOT_SATISFIED);
+    }
+#endif
+
     if (!process_chunk(tx, rx)) {
         THROW(APDU_CODE_OK);
     }
@@ -69,6 +137,92 @@ __Z_INLINE void handleSign(volatile uint32_t *flags, volatile uint32_t *tx, uint
     *flags |= IO_ASYNCH_REPLY;
 }
 
+#if defined(HAVE_TX_BATCH)
+__Z_INLINE void handleSignBatch(volatile uint32_t *flags, volatile uint32_t *tx, uint32_t rx) {
+    const uint8_t payloadType = G_io_apdu_buffer[OFFSET_PAYLOAD_TYPE];
+
+    // Batch transactions are uploaded with plain chunks only
+    switch (payloadType) {
+        case PAYLOAD_TYPE_INIT:
+        case PAYLOAD_TYPE_ADD:
+        case PAYLOAD_TYPE_LAST:
+        case PAYLOAD_TYPE_BATCH_REVIEW:
+        case PAYLOAD_TYPE_BATCH_SIGNATURE:
+            break;
+        default:
+            THROW(APDU_CODE_INVALIDP1P2);
+    }
+
+    if (payloadType == PAYLOAD_TYPE_BATCH_SIGNATURE) {
+        if (rx != OFFSET_DATA + 1) {
+            THROW(APDU_CODE_WRONG_LENGTH);
+        }
+        if (!tx_batch_approved()) {
+            THROW(APDU_CODE_CONDITIONS_NOT_SATISFIED);
+        }
+        if (G_io_apdu_buffer[OFFSET_DATA] >= tx_batch_count()) {
+            THROW(APDU_CODE_DATA_INVALID);
+        }
+
+        uint16_t replyLen = 0;
+        if (app_fill_batch_signature(G_io_apdu_buffer[OFFSET_DATA], &replyLen) != zxerr_ok || replyLen == 0) {
+            THROW(APDU_CODE_SIGN_VERIFY_ERROR);
+        }
+        *tx = replyLen;
+        THROW(APDU_CODE_OK);
+    }
+
+    // Nothing can be added to a batch once it is reviewed
+    if (payloadType != PAYLOAD_TYPE_INIT && (!tx_batch_active() || tx_batch_approved())) {
+        THROW(APDU_CODE_CONDITIONS_NOT_SATISFIED);
+    }
+
+    if (payloadType == PAYLOAD_TYPE_BATCH_REVIEW) {
+        if (tx_batch_count() == 0) {
+            THROW(APDU_CODE_CONDITIONS_NOT_SATISFIED);
+        }
+        view_review_init(tx_batch_getItem, tx_batch_getNumItems, app_sign_batch);
+        view_review_show();
+        *flags |= IO_ASYNCH_REPLY;
+        return;
+    }
+
+    if (!process_chunk(tx, rx)) {
+        if (payloadType == PAYLOAD_TYPE_INIT) {
+            tx_start_batch(hdPath);
+        }
+        THROW(APDU_CODE_OK);
+    }
+
+    const char *error_msg = tx_parse();
+
+    if (error_msg != NULL) {
+        int error_msg_length = strlen(error_msg);
+        MEMCPY(G_io_apdu_buffer, error_msg, error_msg_length);
+        *tx += (error_msg_length);
+        tx_discard();
+        THROW(APDU_CODE_DATA_INVALID);
+    }
+
+    // The transaction stays buffered for the review, the next one is uploaded after it
+    const zxerr_t err = tx_add_to_batch();
+    if (err != zxerr_ok) {
+        tx_discard();
+    }
+
+    if (err == zxerr_buffer_too_small) {
+        THROW(APDU_CODE_OUTPUT_BUFFER_TOO_SMALL);
+    }
+    if (err != zxerr_ok) {
+        THROW(APDU_CODE_DATA_INVALID);
+    }
+
+    G_io_apdu_buffer[0] = tx_batch_count();
+    *tx = 1;
+    THROW(APDU_CODE_OK);
+}
+#endif
+
 __Z_INLINE void handleSlotStatus(volatile uint32_t *flags, volatile uint32_t *tx, uint32_t rx) {
     if (rx != 5) {
         THROW(APDU_CODE_DATA_INVALID);
@@ -88,13 +242,7 @@ __Z_INLINE void handleGetSlot(volatile uint32_t *flags, volatile uint32_t *tx, u
 
     const uint8_t slotIdx = G_io_apdu_buffer[OFFSET_DATA];
 
-    char buffer[20];
-    snprintf(buffer, sizeof(buffer), "%d", slotIdx);
-    zemu_log_stack(buffer);
-
     zxerr_t err = slot_getSlot(slotIdx, G_io_apdu_buffer, IO_APDU_BUFFER_SIZE);
-    snprintf(buffer, sizeof(buffer), "err: %d", err);
-    zemu_log_stack(buffer);
 
     if (err == zxerr_no_data) {
         zemu_log_stack("Empty slot");
@@ -109,6 +257,44 @@ __Z_INLINE void handleGetSlot(volatile uint32_t *flags, volatile uint32_t *tx, u
     THROW(APDU_CODE_OK);
 }
 
+__Z_INLINE void handleExportSlots(volatile uint32_t *flags, volatile uint32_t *tx, uint32_t rx) {
+    if (rx != OFFSET_DATA + 1) {
+        THROW(APDU_CODE_WRONG_LENGTH);
+    }
+
+    uint16_t replyLen = 0;
+    zxerr_t err = slot_export(G_io_apdu_buffer[OFFSET_DATA], G_io_apdu_buffer, IO_APDU_BUFFER_SIZE - 2, &replyLen);
+    if (err == zxerr_out_of_bounds) {
+        THROW(APDU_CODE_DATA_INVALID);
+    }
+    if (err != zxerr_ok) {
+        THROW(APDU_CODE_EXECUTION_ERROR);
+    }
+
+    *tx = replyLen;
+    THROW(APDU_CODE_OK);
+}
+
+__Z_INLINE void handleFindSlot(volatile uint32_t *flags, volatile uint32_t *tx, uint32_t rx) {
+    if (rx != OFFSET_DATA + SLOT_ACCOUNT_SIZE) {
+        THROW(APDU_CODE_WRONG_LENGTH);
+    }
+
+    uint8_t slotIdx = 0;
+    if (slot_findAccount(G_io_apdu_buffer + OFFSET_DATA, &slotIdx) != zxerr_ok) {
+        THROW(APDU_CODE_EMPTY_BUFFER);
+    }
+
+    // Same layout as an export entry
+    G_io_apdu_buffer[0] = slotIdx;
+    if (slot_getSlot(slotIdx, G_io_apdu_buffer + 1, IO_APDU_BUFFER_SIZE - 1) != zxerr_ok) {
+        THROW(APDU_CODE_EXECUTION_ERROR);
+    }
+
+    *tx = SLOT_EXPORT_ENTRY_SIZE;
+    THROW(APDU_CODE_OK);
+}
+
 __Z_INLINE void handleSetSlot(volatile uint32_t *flags, volatile uint32_t *tx, uint32_t rx) {
     if (rx != 5 + 1 + 8 + 20) {
         THROW(APDU_CODE_DATA_INVALID);
@@ -124,6 +310,39 @@ __Z_INLINE void handleSetSlot(volatile uint32_t *flags, volatile uint32_t *tx, u
     *flags |= IO_ASYNCH_REPLY;
 }
 
+__Z_INLINE void handleImportSlots(volatile uint32_t *flags, volatile uint32_t *tx, uint32_t rx) {
+    switch (G_io_apdu_buffer[OFFSET_P1]) {
+        case SLOT_IMPORT_INIT:
+            slot_importReset();
+            THROW(APDU_CODE_OK);
+        case SLOT_IMPORT_ADD: {
+            if (rx < OFFSET_DATA) {
+                THROW(APDU_CODE_WRONG_LENGTH);
+            }
+            zxerr_t err = slot_importAdd(G_io_apdu_buffer + OFFSET_DATA, rx - OFFSET_DATA);
+            if (err == zxerr_buffer_too_small) {
+                THROW(APDU_CODE_OUTPUT_BUFFER_TOO_SMALL);
+            }
+            if (err != zxerr_ok) {
+                THROW(APDU_CODE_DATA_INVALID);
+            }
+            G_io_apdu_buffer[0] = slot_importCount();
+            *tx = 1;
+            THROW(APDU_CODE_OK);
+        }
+        case SLOT_IMPORT_REVIEW:
+            if (slot_importCount() == 0) {
+                THROW(APDU_CODE_CONDITIONS_NOT_SATISFIED);
+            }
+            view_review_init(slot_importGetItem, slot_importGetNumItems, app_slot_import);
+            view_review_show();
+            *flags |= IO_ASYNCH_REPLY;
+            return;
+        default:
+            THROW(APDU_CODE_INVALIDP1P2);
+    }
+}
+
 void handleApdu(volatile uint32_t *flags, volatile uint32_t *tx, uint32_t rx) {
     uint16_t sw = 0;
 
@@ -155,6 +374,18 @@ void handleApdu(volatile uint32_t *flags, volatile uint32_t *tx, uint32_t rx) {
                     break;
                 }
 
+                case INS_GET_PUBKEYS: {
+                    handleGetPubkeys(flags, tx, rx);
+                    break;
+                }
+
+#if defined(HAVE_TX_BATCH)
+                case INS_SIGN_BATCH: {
+                    handleSignBatch(flags, tx, rx);
+                    break;
+                }
+#endif
+
                 case INS_SLOT_STATUS: {
                     handleSlotStatus(flags, tx, rx);
                     break;
@@ -170,6 +401,21 @@ void handleApdu(volatile uint32_t *flags, volatile uint32_t *tx, uint32_t rx) {
                     break;
                 }
 
+                case INS_SLOT_EXPORT: {
+                    handleExportSlots(flags, tx, rx);
+                    break;
+                }
+
+                case INS_SLOT_IMPORT: {
+                    handleImportSlots(flags, tx, rx);
+                    break;
+                }
+
+                case INS_SLOT_FIND: {
+                    handleFindSlot(flags, tx, rx);
+                    break;
+                }
+
                 default:
                     THROW(APDU_CODE_INS_NOT_SUPPORTED);
             }
@@ -37,6 +37,7 @@ extern "C" {
 
 #define SECP256K1_PK_LEN            65u
 #define SECP256R1_PK_LEN            65u
+#define PK_COMPRESSED_LEN           33u
 
 typedef enum {
     ADDR_SECP256K1 = 0,
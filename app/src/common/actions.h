@@ -18,19 +18,15 @@
 #include <stdint.h>
 #include "crypto.h"
 #include "tx.h"
+#include "tx_batch.h"
 #include "apdu_codes.h"
 #include <os_io_seproxyhal.h>
 #include "coin.h"
+#include "app_main.h"
 
 extern uint16_t action_addr_len;
 
-__Z_INLINE void app_sign() {
-    const uint8_t *message = get_signable();
-    const uint16_t messageLength = get_signable_length();
-
-    uint16_t replyLen = 0;
-    zxerr_t err = crypto_sign(hdPath, message, messageLength, G_io_apdu_buffer, IO_APDU_BUFFER_SIZE - 3, &replyLen);
-
+__Z_INLINE void app_reply_signature(zxerr_t err, uint16_t replyLen) {
     if (err != zxerr_ok || replyLen == 0) {
         set_code(G_io_apdu_buffer, 0, APDU_CODE_SIGN_VERIFY_ERROR);
         io_exchange(CHANNEL_APDU | IO_RETURN_AFTER_TX, 2);
@@ -40,7 +36,64 @@ __Z_INLINE void app_sign() {
     }
 }
 
+__Z_INLINE void app_sign() {
+    upload_close();
+    const uint8_t *message = get_signable();
+    const uint16_t messageLength = get_signable_length();
+
+    uint8_t digest[CRYPTO_DIGEST_SIZE];
+    uint16_t replyLen = 0;
+    zxerr_t err = crypto_digest(hdPath, message, messageLength, digest);
+    if (err == zxerr_ok) {
+        err = crypto_signDigest(hdPath, digest, G_io_apdu_buffer, IO_APDU_BUFFER_SIZE - 3, &replyLen);
+    }
+
+    // The approved transaction stays buffered, other paths can sign it without another upload
+    if (err == zxerr_ok) {
+        tx_session_start(hdPath, digest);
+    }
+
+    app_reply_signature(err, replyLen);
+}
+
+// Extra signature in a session, the transaction was reviewed by app_sign
+__Z_INLINE void app_sign_session() {
+    uint8_t digest[CRYPTO_DIGEST_SIZE];
+    uint16_t replyLen = 0;
+    zxerr_t err = tx_session_digest(hdPath, digest);
+    if (err == zxerr_ok) {
+        err = crypto_signDigest(hdPath, digest, G_io_apdu_buffer, IO_APDU_BUFFER_SIZE - 3, &replyLen);
+    }
+
+    app_reply_signature(err, replyLen);
+}
+
+#if defined(HAVE_TX_BATCH)
+// Signature of the idx-th transaction of an approved batch
+__Z_INLINE zxerr_t app_fill_batch_signature(uint8_t idx, uint16_t *replyLen) {
+    uint8_t digest[CRYPTO_DIGEST_SIZE];
+    *replyLen = 0;
+    CHECK_ZXERR(tx_batch_digest(idx, digest))
+    return crypto_signDigest(tx_batch_path(), digest, G_io_apdu_buffer, IO_APDU_BUFFER_SIZE - 3, replyLen);
+}
+
+// The batch review was approved, the first signature is returned right away
+__Z_INLINE void app_sign_batch() {
+    upload_close();
+    tx_batch_approve();
+
+    uint16_t replyLen = 0;
+    zxerr_t err = app_fill_batch_signature(0, &replyLen);
+    app_reply_signature(err, replyLen);
+}
+#endif
+
 __Z_INLINE void app_reject() {
+    upload_close();
+    tx_session_end();
+#if defined(HAVE_TX_BATCH)
+    tx_batch_clear();
+#endif
     set_code(G_io_apdu_buffer, 0, APDU_CODE_COMMAND_NOT_ALLOWED);
     io_exchange(CHANNEL_APDU | IO_RETURN_AFTER_TX, 2);
 }
@@ -26,10 +26,16 @@
 #include "tx.h"
 #include "crypto.h"
 #include "coin.h"
+#include "account.h"
 #include "zxmacros.h"
 
 unsigned char G_io_seproxyhal_spi_buffer[IO_SEPROXYHAL_BUFFER_SIZE_B];
 
+// Sequence number of the next sequenced chunk of the transaction being uploaded
+uint16_t upload_next_seq;
+// An upload was started and can still be resumed
+bool upload_open;
+
 unsigned char io_event(unsigned char channel) {
     switch (G_io_seproxyhal_spi_buffer[0]) {
         case SEPROXYHAL_TAG_FINGER_EVENT: //
@@ -91,23 +97,115 @@ unsigned short io_exchange_al(unsigned char channel, unsigned short tx_len) {
 }
 
 void extractHDPath(uint32_t rx, uint32_t offset) {
+    extractHDPathTo(hdPath, rx, offset);
+}
+
+void extractHDPathTo(uint32_t path[HDPATH_LEN_DEFAULT], uint32_t rx, uint32_t offset) {
     if ((rx - offset) < sizeof(uint32_t) * HDPATH_LEN_DEFAULT) {
         THROW(APDU_CODE_WRONG_LENGTH);
     }
 
-    MEMCPY(hdPath, G_io_apdu_buffer + offset, sizeof(uint32_t) * HDPATH_LEN_DEFAULT);
+    MEMCPY(path, G_io_apdu_buffer + offset, sizeof(uint32_t) * HDPATH_LEN_DEFAULT);
 
-    const bool mainnet = hdPath[0] == HDPATH_0_DEFAULT &&
-                         hdPath[1] == HDPATH_1_DEFAULT;
+    const bool mainnet = path[0] == HDPATH_0_DEFAULT &&
+                         path[1] == HDPATH_1_DEFAULT;
 
-    const bool testnet = hdPath[0] == HDPATH_0_TESTNET &&
-                         hdPath[1] == HDPATH_1_TESTNET;
+    const bool testnet = path[0] == HDPATH_0_TESTNET &&
+                         path[1] == HDPATH_1_TESTNET;
 
     if (!mainnet && !testnet) {
         THROW(APDU_CODE_DATA_INVALID);
     }
 }
 
+__Z_INLINE uint32_t read_u32le(const uint8_t *p) {
+    return (uint32_t) p[0] | ((uint32_t) p[1] << 8u) | ((uint32_t) p[2] << 16u) | ((uint32_t) p[3] << 24u);
+}
+
+// CRC-32 (IEEE 802.3, reflected), the check of a sequenced upload
+static uint32_t upload_crc32(const uint8_t *data, uint32_t len) {
+    uint32_t crc = 0xFFFFFFFFu;
+    for (uint32_t i = 0; i < len; i++) {
+        crc ^= data[i];
+        for (uint8_t b = 0; b < 8; b++) {
+            crc = (crc >> 1u) ^ (0xEDB88320u & (0u - (crc & 1u)));
+        }
+    }
+    return ~crc;
+}
+
+// Cumulative acknowledgement: everything before the next sequence number has been received
+static void upload_ack(volatile uint32_t *tx) {
+    const uint32_t length = tx_get_buffer_length();
+    G_io_apdu_buffer[0] = (uint8_t) upload_next_seq;
+    G_io_apdu_buffer[1] = (uint8_t) (upload_next_seq >> 8u);
+    for (uint8_t i = 0; i < 4; i++) {
+        G_io_apdu_buffer[2 + i] = (uint8_t) (length >> (8u * i));
+    }
+    *tx = SEQ_ACK_LEN;
+}
+
+void upload_close(void) {
+    upload_next_seq = 0;
+    upload_open = false;
+}
+
+// The transaction approved for a signing session can not be extended, an attempt ends the session
+static void upload_check_session() {
+    if (tx_session_active()) {
+        tx_session_end();
+        upload_close();
+        THROW(APDU_CODE_CONDITIONS_NOT_SATISFIED);
+    }
+}
+
+static bool process_sequenced_chunk(volatile uint32_t *tx, uint32_t rx, bool last) {
+    upload_check_session();
+    if (!upload_open) {
+        THROW(APDU_CODE_CONDITIONS_NOT_SATISFIED);
+    }
+
+    const uint32_t headerLen = last ? SEQ_LAST_HEADER_LEN : SEQ_HEADER_LEN;
+    if (rx < OFFSET_DATA + headerLen) {
+        THROW(APDU_CODE_WRONG_LENGTH);
+    }
+
+    uint8_t *header = G_io_apdu_buffer + OFFSET_DATA;
+    const uint16_t seq = (uint16_t) (header[0] | (header[1] << 8u));
+
+    // Retransmitted and early chunks are dropped, the ack tells the host where to resume
+    if (seq != upload_next_seq) {
+        upload_ack(tx);
+        return false;
+    }
+
+    if (read_u32le(header + 2) != tx_get_buffer_length()) {
+        THROW(APDU_CODE_DATA_INVALID);
+    }
+
+    const uint32_t dataLen = rx - OFFSET_DATA - headerLen;
+    if (tx_append(header + headerLen, dataLen) != dataLen) {
+        THROW(APDU_CODE_OUTPUT_BUFFER_TOO_SMALL);
+    }
+    upload_next_seq++;
+
+    if (!last) {
+        upload_ack(tx);
+        return false;
+    }
+
+    // A corrupted upload can not be resumed, it has to start again
+    const uint32_t totalLen = read_u32le(header + 6);
+    if (totalLen != tx_get_buffer_length() || read_u32le(header + 10) != upload_crc32(tx_get_buffer(), totalLen)) {
+        upload_close();
+        THROW(APDU_CODE_DATA_INVALID);
+    }
+
+    // The buffer is parsed and reviewed now, nothing more can be added or resumed
+    upload_close();
+    return true;
+}
+
 bool process_chunk(volatile uint32_t *tx, uint32_t rx) {
     const uint8_t payloadType = G_io_apdu_buffer[OFFSET_PAYLOAD_TYPE];
 
@@ -121,23 +219,39 @@ bool process_chunk(volatile uint32_t *tx, uint32_t rx) {
 
     uint32_t added;
     switch (payloadType) {
-        case 0:
+        case PAYLOAD_TYPE_INIT:
             tx_initialize();
             tx_reset();
+            upload_close();
             extractHDPath(rx, OFFSET_DATA);
+            upload_open = true;
             return false;
-        case 1:
+        case PAYLOAD_TYPE_ADD:
+            upload_check_session();
             added = tx_append(&(G_io_apdu_buffer[OFFSET_DATA]), rx - OFFSET_DATA);
             if (added != rx - OFFSET_DATA) {
                 THROW(APDU_CODE_OUTPUT_BUFFER_TOO_SMALL);
             }
             return false;
-        case 2:
+        case PAYLOAD_TYPE_LAST:
+            upload_check_session();
             added = tx_append(&(G_io_apdu_buffer[OFFSET_DATA]), rx - OFFSET_DATA);
             if (added != rx - OFFSET_DATA) {
                 THROW(APDU_CODE_OUTPUT_BUFFER_TOO_SMALL);
             }
+            upload_close();
             return true;
+        case PAYLOAD_TYPE_SEQ_ADD:
+            return process_sequenced_chunk(tx, rx, false);
+        case PAYLOAD_TYPE_SEQ_LAST:
+            return process_sequenced_chunk(tx, rx, true);
+        case PAYLOAD_TYPE_SEQ_STATUS:
+            // Buffered chunks survive a lost connection while the app stays open
+            if (!upload_open) {
+                THROW(APDU_CODE_CONDITIONS_NOT_SATISFIED);
+            }
+            upload_ack(tx);
+            return false;
     }
 
     THROW(APDU_CODE_INVALIDP1P2);
@@ -170,6 +284,9 @@ void handle_generic_apdu(volatile uint32_t *flags, volatile uint32_t *tx, uint32
 
 void app_init() {
     io_seproxyhal_init();
+    crypto_pubkeyCacheClear();
+    slot_importFinish();
+    slot_indexRebuild();
 
 #ifdef HAVE_BLE
     // grab the current plane mode setting
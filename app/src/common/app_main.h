@@ -19,6 +19,7 @@
 #include <stdbool.h>
 #include <ux.h>
 #include "apdu_codes.h"
+#include "coin.h"
 
 #define OFFSET_CLA                      0
 #define OFFSET_INS                      1  //< Instruction offset
@@ -31,22 +32,62 @@
 
 #define OFFSET_PAYLOAD_TYPE             OFFSET_P1
 
+// INS_SIGN payload types
+#define PAYLOAD_TYPE_INIT               0x00
+#define PAYLOAD_TYPE_ADD                0x01
+#define PAYLOAD_TYPE_LAST               0x02
+// Path for one more signature of the transaction approved last
+#define PAYLOAD_TYPE_SESSION_PATH       0x03
+// Sequenced chunks: [seq (2)][offset (4)] followed by the data, the last one adds [total length (4)][crc32 (4)]
+// before its data. Both are acknowledged with [next seq (2)][received length (4)].
+#define PAYLOAD_TYPE_SEQ_ADD            0x04
+#define PAYLOAD_TYPE_SEQ_LAST           0x05
+// Acknowledgement of a sequenced upload without sending data, to resume it
+#define PAYLOAD_TYPE_SEQ_STATUS         0x06
+
+#define SEQ_HEADER_LEN                  6
+#define SEQ_LAST_HEADER_LEN             14
+#define SEQ_ACK_LEN                     6
+
+// INS_SIGN_BATCH payload types, transactions are uploaded with INIT / ADD / LAST as in INS_SIGN.
+// They do not overlap the INS_SIGN payload types.
+#define PAYLOAD_TYPE_BATCH_REVIEW       0x07
+#define PAYLOAD_TYPE_BATCH_SIGNATURE    0x08
+
 #define INS_GET_VERSION                 0x00
 #define INS_GET_PUBKEY          0x01
 #define INS_SIGN              0x02
+#define INS_GET_PUBKEYS                 0x03
+#define INS_SIGN_BATCH                  0x04
 
 #define INS_SLOT_STATUS                 0x10
 #define INS_SLOT_GET                    0x11
 #define INS_SLOT_SET                    0x12
+#define INS_SLOT_EXPORT                 0x13
+#define INS_SLOT_IMPORT                 0x14
+#define INS_SLOT_FIND                   0x15
+
+// INS_SLOT_IMPORT steps
+#define SLOT_IMPORT_INIT                0x00
+#define SLOT_IMPORT_ADD                 0x01
+#define SLOT_IMPORT_REVIEW              0x02
 
 void app_init();
 
 void app_main();
 
+// Compressed keys of GET_PUBKEYS must fit in the reply next to the return code
+#define GET_PUBKEYS_MAX_COUNT           ((IO_APDU_BUFFER_SIZE - 2) / PK_COMPRESSED_LEN)
+
 void extractHDPath(uint32_t rx, uint32_t offset);
 
+void extractHDPathTo(uint32_t path[HDPATH_LEN_DEFAULT], uint32_t rx, uint32_t offset);
+
 bool process_chunk(volatile uint32_t *tx, uint32_t rx);
 
+// Ends the transaction upload, sequenced chunks and P1 = 6 are refused until the next P1 = 0
+void upload_close(void);
+
 void handleApdu(volatile uint32_t *flags, volatile uint32_t *tx, uint32_t rx);
 
 void handle_generic_apdu(volatile uint32_t *flags, volatile uint32_t *tx, uint32_t rx);
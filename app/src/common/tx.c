@@ -18,6 +18,9 @@
 #include "apdu_codes.h"
 #include "buffering.h"
 #include "parser.h"
+#include "crypto.h"
+#include "tx_batch.h"
+#include "account.h"
 #include <string.h>
 #include "zxmacros.h"
 
@@ -27,6 +30,10 @@
 #elif defined(TARGET_NANOS)
 #define RAM_BUFFER_SIZE 0
 #define FLASH_BUFFER_SIZE 8192
+#else
+// Host builds (bench/host) use the Nano X sizes
+#define RAM_BUFFER_SIZE 8192
+#define FLASH_BUFFER_SIZE 16384
 #endif
 
 // Ram
@@ -37,10 +44,8 @@ typedef struct {
     uint8_t buffer[FLASH_BUFFER_SIZE];
 } storage_t;
 
-#if defined(TARGET_NANOS) || defined(TARGET_NANOX) || defined(TARGET_NANOS2)
 storage_t NV_CONST N_appdata_impl __attribute__ ((aligned(64)));
 #define N_appdata (*(NV_VOLATILE storage_t *)PIC(&N_appdata_impl))
-#endif
 
 parser_context_t ctx_parsed_tx;
 
@@ -55,6 +60,48 @@ const uint8_t TX_DOMAIN_TAG[DOMAIN_TAG_LENGTH] = {\
 
 #define TX_BUFFER_OFFSET DOMAIN_TAG_LENGTH
 
+// Where the domain tag of the current transaction starts, a batch keeps its transactions one after the other
+uint32_t tx_start;
+
+// Signable digests of the approved transaction, one per hash byte of path[2] (SHA2 or SHA3)
+#define TX_SESSION_DIGESTS 2
+#define TX_SESSION_HASH_SHA2 0x01
+#define TX_SESSION_HASH_SHA3 0x03
+
+typedef struct {
+    bool active;
+    uint8_t hash[TX_SESSION_DIGESTS];
+    uint8_t digest[TX_SESSION_DIGESTS][CRYPTO_DIGEST_SIZE];
+} tx_session_t;
+
+tx_session_t tx_session;
+
+// Payer, proposer and authorizers of the parsed transaction held by a local slot
+typedef enum {
+    TX_ROLE_PAYER,
+    TX_ROLE_PROPOSER,
+    TX_ROLE_AUTHORIZER,
+} tx_role_e;
+
+typedef struct {
+    uint8_t role;
+    uint8_t authorizer;
+    uint8_t slot;
+} tx_slot_match_t;
+
+#define TX_SLOT_MATCH_MAX (2 + sizeof(parser_tx_obj.authorizers.authorizer) / sizeof(flow_proposal_authorizer_t))
+
+typedef struct {
+    uint8_t count;
+    tx_slot_match_t match[TX_SLOT_MATCH_MAX];
+} tx_slot_matches_t;
+
+tx_slot_matches_t tx_slot_matches;
+
+// Parser items of the parsed transaction, counted once per parse as every review screen asks for them
+uint8_t tx_parserItems;
+bool tx_parserItemsValid;
+
 void tx_initialize() {
     buffering_init(
             ram_buffer,
@@ -65,6 +112,11 @@ void tx_initialize() {
 }
 
 void tx_reset() {
+    tx_session_end();
+#if defined(HAVE_TX_BATCH)
+    tx_batch_clear();
+#endif
+    tx_start = 0;
     buffering_reset();
     buffering_append(TX_DOMAIN_TAG, DOMAIN_TAG_LENGTH);
 }
@@ -73,26 +125,57 @@ uint32_t tx_append(unsigned char *buffer, uint32_t length) {
     return buffering_append(buffer, length);
 }
 
+void tx_discard() {
+    buffering_get_buffer()->pos = tx_start + TX_BUFFER_OFFSET;
+}
+
 uint32_t tx_get_buffer_length() {
-    if (buffering_get_buffer()->pos >= TX_BUFFER_OFFSET) {
-        return buffering_get_buffer()->pos - TX_BUFFER_OFFSET;
+    if (buffering_get_buffer()->pos >= tx_start + TX_BUFFER_OFFSET) {
+        return buffering_get_buffer()->pos - tx_start - TX_BUFFER_OFFSET;
     }
     return 0;
 }
 
 uint32_t get_signable_length() {
-    return buffering_get_buffer()->pos;
+    return buffering_get_buffer()->pos - tx_start;
 }
 
 uint8_t *tx_get_buffer() {
-    return buffering_get_buffer()->data + TX_BUFFER_OFFSET;
+    return buffering_get_buffer()->data + tx_start + TX_BUFFER_OFFSET;
 }
 
 uint8_t *get_signable() {
+    return buffering_get_buffer()->data + tx_start;
+}
+
+#if defined(HAVE_TX_BATCH)
+static const uint8_t *tx_get_storage(void) {
     return buffering_get_buffer()->data;
 }
+#endif
+
+static void tx_matchSlot(const parser_context_t *account, uint8_t role, uint8_t authorizer) {
+    uint8_t slotIdx = 0;
+    if (account->bufferLen != SLOT_ACCOUNT_SIZE || slot_findAccount(account->buffer, &slotIdx) != zxerr_ok) {
+        return;
+    }
+    tx_slot_match_t *m = &tx_slot_matches.match[tx_slot_matches.count++];
+    m->role = role;
+    m->authorizer = authorizer;
+    m->slot = slotIdx;
+}
+
+static void tx_matchSlots() {
+    tx_matchSlot(&parser_tx_obj.payer.ctx, TX_ROLE_PAYER, 0);
+    tx_matchSlot(&parser_tx_obj.proposalKeyAddress.ctx, TX_ROLE_PROPOSER, 0);
+    for (uint8_t i = 0; i < parser_tx_obj.authorizers.authorizer_count && i < TX_SLOT_MATCH_MAX - 2; i++) {
+        tx_matchSlot(&parser_tx_obj.authorizers.authorizer[i].ctx, TX_ROLE_AUTHORIZER, i);
+    }
+}
 
 const char *tx_parse() {
+    MEMZERO(&tx_slot_matches, sizeof(tx_slot_matches));
+    tx_parserItemsValid = false;
     uint8_t err = parser_parse(
         &ctx_parsed_tx,
         tx_get_buffer(),
@@ -109,16 +192,49 @@ const char *tx_parse() {
         return parser_getErrorDescription(err);
     }
 
+    tx_matchSlots();
     return NULL;
 }
 
 zxerr_t tx_getNumItems(uint8_t *num_items) {
-    parser_error_t err = parser_getNumItems(&ctx_parsed_tx, num_items);
+    if (!tx_parserItemsValid) {
+        parser_error_t err = parser_getNumItems(&ctx_parsed_tx, &tx_parserItems);
 
-    if (err != PARSER_OK) {
+        if (err != PARSER_OK) {
+            return zxerr_no_data;
+        }
+        tx_parserItemsValid = true;
+    }
+
+    *num_items = tx_parserItems + tx_slot_matches.count;
+    return zxerr_ok;
+}
+
+static zxerr_t tx_printSlotMatch(uint8_t idx,
+                                 char *outKey, uint16_t outKeyLen,
+                                 char *outVal, uint16_t outValLen,
+                                 uint8_t *pageCount) {
+    MEMZERO(outKey, outKeyLen);
+    MEMZERO(outVal, outValLen);
+    *pageCount = 1;
+
+    if (idx >= tx_slot_matches.count) {
         return zxerr_no_data;
     }
 
+    const tx_slot_match_t *m = &tx_slot_matches.match[idx];
+    switch (m->role) {
+        case TX_ROLE_PAYER:
+            snprintf(outKey, outKeyLen, "Payer slot");
+            break;
+        case TX_ROLE_PROPOSER:
+            snprintf(outKey, outKeyLen, "Proposer slot");
+            break;
+        default:
+            snprintf(outKey, outKeyLen, "Auth %d slot", m->authorizer + 1);
+            break;
+    }
+    snprintf(outVal, outValLen, "%d", m->slot);
     return zxerr_ok;
 }
 
@@ -134,6 +250,12 @@ zxerr_t tx_getItem(int8_t displayIdx,
         return zxerr_no_data;
     }
 
+    // Local slots of the transaction accounts follow the parser items
+    const uint8_t parserItems = numItems - tx_slot_matches.count;
+    if (displayIdx >= parserItems) {
+        return tx_printSlotMatch(displayIdx - parserItems, outKey, outKeyLen, outVal, outValLen, pageCount);
+    }
+
     parser_error_t err = parser_getItem(&ctx_parsed_tx,
                                         displayIdx,
                                         outKey, outKeyLen,
@@ -151,3 +273,98 @@ zxerr_t tx_getItem(int8_t displayIdx,
 
     return zxerr_ok;
 }
+
+#if defined(HAVE_TX_BATCH)
+void tx_start_batch(const uint32_t path[HDPATH_LEN_DEFAULT]) {
+    tx_batch_reset(path, tx_get_storage);
+}
+
+zxerr_t tx_add_to_batch() {
+    // RAM content moves to the start of flash when it is full, so flash bounds the whole buffer.
+    // The next transaction needs room for its domain tag.
+    const uint32_t end = buffering_get_buffer()->pos;
+    if (buffering_get_flash_buffer()->size < end + DOMAIN_TAG_LENGTH) {
+        return zxerr_buffer_too_small;
+    }
+
+    uint8_t digest[CRYPTO_DIGEST_SIZE];
+    CHECK_ZXERR(crypto_digest(tx_batch_path(), get_signable(), get_signable_length(), digest))
+    CHECK_ZXERR(tx_batch_add(&ctx_parsed_tx, tx_start + TX_BUFFER_OFFSET, digest))
+
+    tx_start = end;
+    buffering_append(TX_DOMAIN_TAG, DOMAIN_TAG_LENGTH);
+    return zxerr_ok;
+}
+#endif
+
+__Z_INLINE uint8_t session_hash(const uint32_t path[HDPATH_LEN_DEFAULT]) {
+    return (uint8_t) (path[2] & 0xFF);
+}
+
+void tx_session_start(const uint32_t path[HDPATH_LEN_DEFAULT], const uint8_t *digest) {
+    MEMZERO(&tx_session, sizeof(tx_session));
+
+    // Both digests are taken now, the buffer may change after the approval
+    const uint8_t hashes[TX_SESSION_DIGESTS] = {TX_SESSION_HASH_SHA2, TX_SESSION_HASH_SHA3};
+    uint32_t hashPath[HDPATH_LEN_DEFAULT];
+    MEMCPY(hashPath, path, sizeof(hashPath));
+
+    for (uint8_t i = 0; i < TX_SESSION_DIGESTS; i++) {
+        tx_session.hash[i] = hashes[i];
+        if (hashes[i] == session_hash(path)) {
+            MEMCPY(tx_session.digest[i], digest, CRYPTO_DIGEST_SIZE);
+            continue;
+        }
+
+        hashPath[2] = (path[2] & ~0xFFu) | hashes[i];
+        if (crypto_digest(hashPath, get_signable(), get_signable_length(), tx_session.digest[i]) != zxerr_ok) {
+            MEMZERO(&tx_session, sizeof(tx_session));
+            return;
+        }
+    }
+
+    tx_session.active = true;
+}
+
+void tx_session_end() {
+    MEMZERO(&tx_session, sizeof(tx_session));
+}
+
+bool tx_session_active() {
+    return tx_session.active;
+}
+
+zxerr_t tx_session_digest(const uint32_t path[HDPATH_LEN_DEFAULT], uint8_t *digest) {
+    if (!tx_session.active) {
+        return zxerr_no_data;
+    }
+
+    const uint8_t hash = session_hash(path);
+    for (uint8_t i = 0; i < TX_SESSION_DIGESTS; i++) {
+        if (tx_session.hash[i] == hash) {
+            MEMCPY(digest, tx_session.digest[i], CRYPTO_DIGEST_SIZE);
+            return zxerr_ok;
+        }
+    }
+    return zxerr_out_of_bounds;
+}
+
+zxerr_t tx_session_getNumItems(uint8_t *num_items) {
+    *num_items = 1;
+    return zxerr_ok;
+}
+
+zxerr_t tx_session_getItem(int8_t displayIdx,
+                           char *outKey, uint16_t outKeyLen,
+                           char *outVal, uint16_t outValLen,
+                           uint8_t pageIdx, uint8_t *pageCount) {
+    if (displayIdx != 0) {
+        return zxerr_no_data;
+    }
+
+    snprintf(outKey, outKeyLen, "Also sign with");
+    char buffer[100];
+    bip32_to_str(buffer, sizeof(buffer), hdPath, HDPATH_LEN_DEFAULT);
+    pageString(outVal, outValLen, buffer, pageIdx, pageCount);
+    return zxerr_ok;
+}
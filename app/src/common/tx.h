@@ -18,12 +18,16 @@
 #include "os.h"
 #include "coin.h"
 #include "zxerror.h"
+#include <stdbool.h>
 
 void tx_initialize();
 
-/// Clears the transaction buffer
+/// Clears the transaction buffer, and the batch kept in it
 void tx_reset();
 
+/// Drops the current transaction, the transactions of a batch before it are kept
+void tx_discard();
+
 /// Appends buffer to the end of the current transaction buffer
 /// Transaction buffer will grow until it reaches the maximum allowed size
 /// \param buffer
@@ -53,6 +57,37 @@ uint8_t *get_signable();
 /// \return It returns NULL if data is valid or error message otherwise.
 const char *tx_parse();
 
+/// Starts a signing session over the buffered transaction after an approved signature.
+/// The digests of both hashes are taken here, so later changes to the buffer are never signed.
+/// Further paths can sign the same transaction until the buffer is changed or a review is rejected.
+/// \param path path of the approved signature
+/// \param digest its signable digest, kept for the paths using the same hash
+void tx_session_start(const uint32_t path[HDPATH_LEN_DEFAULT], const uint8_t *digest);
+
+/// Ends the signing session
+void tx_session_end();
+
+/// Returns true while a signing session is open
+bool tx_session_active();
+
+/// Signable digest of the approved transaction for the hash selected by path
+zxerr_t tx_session_digest(const uint32_t path[HDPATH_LEN_DEFAULT], uint8_t *digest);
+
+/// Review of an extra session path: a single item with the path
+zxerr_t tx_session_getNumItems(uint8_t *num_items);
+
+zxerr_t tx_session_getItem(int8_t displayIdx,
+                           char *outKey, uint16_t outKeyLen,
+                           char *outValue, uint16_t outValueLen,
+                           uint8_t pageIdx, uint8_t *pageCount);
+
+/// Starts a batch signed with path, its transactions are kept in the transaction buffer
+void tx_start_batch(const uint32_t path[HDPATH_LEN_DEFAULT]);
+
+/// Adds the parsed transaction to the batch, with its signable digest for the batch path.
+/// The next transaction is buffered after it.
+zxerr_t tx_add_to_batch();
+
 /// Release zbuffer memory
 void tx_parse_reset();
 
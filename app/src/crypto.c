@@ -20,6 +20,16 @@
 
 uint32_t hdPath[HDPATH_LEN_DEFAULT];
 
+typedef struct {
+    uint8_t r[32];
+    uint8_t s[32];
+    uint8_t v;
+
+    // DER signature max size should be 73
+    // https://bitcoin.stackexchange.com/questions/77191/what-is-the-maximum-size-of-a-der-encoded-ecdsa-signature#77192
+    uint8_t der_signature[73];
+} __attribute__((packed)) signature_t;
+
 #if defined(TARGET_NANOS) || defined(TARGET_NANOX) || defined(TARGET_NANOS2)
 #include "cx.h"
 
@@ -110,16 +120,6 @@ zxerr_t crypto_extractPublicKey(const uint32_t path[HDPATH_LEN_DEFAULT], uint8_t
     return zxerr_ok;
 }
 
-typedef struct {
-    uint8_t r[32];
-    uint8_t s[32];
-    uint8_t v;
-
-    // DER signature max size should be 73
-    // https://bitcoin.stackexchange.com/questions/77191/what-is-the-maximum-size-of-a-der-encoded-ecdsa-signature#77192
-    uint8_t der_signature[73];
-} __attribute__((packed)) signature_t;
-
 void sha256(const uint8_t *message, uint16_t messageLen, uint8_t message_digest[CX_SHA256_SIZE]) {
     cx_hash_sha256(message, messageLen, message_digest, CX_SHA256_SIZE);
 }
@@ -155,27 +155,29 @@ zxerr_t digest_message(const uint8_t *message, uint16_t messageLen, digest_type_
     }
 }
 
-zxerr_t crypto_sign(const uint32_t path[HDPATH_LEN_DEFAULT], const uint8_t *message, uint16_t messageLen, uint8_t *buffer, uint16_t signatureMaxlen,  uint16_t *sigSize) {
-    zemu_log_stack("crypto_sign");
-
-    cx_curve_t curve = get_cx_curve(path);
-    if (curve!=CX_CURVE_SECP256K1 && curve!=CX_CURVE_SECP256R1 ) {
-        zemu_log_stack("crypto_sign: invalid_crypto_settings");
-        return zxerr_invalid_crypto_settings;
-    }
-
+zxerr_t crypto_digest(const uint32_t path[HDPATH_LEN_DEFAULT], const uint8_t *message, uint16_t messageLen, uint8_t digest[CRYPTO_DIGEST_SIZE]) {
     const enum cx_md_e cx_hash_kind = get_hash_type(path);
-    
-    uint8_t messageDigest[32];
+
     uint16_t messageDigestSize = 0;
+    CHECK_ZXERR(digest_message(message, messageLen, cx_hash_kind, digest, CRYPTO_DIGEST_SIZE, &messageDigestSize));
 
-    CHECK_ZXERR(digest_message(message, messageLen, cx_hash_kind, messageDigest, sizeof(messageDigest), &messageDigestSize));
-    
-    if (messageDigestSize != 32) {
-        zemu_log_stack("crypto_sign: zxerr_out_of_bounds");
+    if (messageDigestSize != CRYPTO_DIGEST_SIZE) {
+        zemu_log_stack("crypto_digest: zxerr_out_of_bounds");
         return zxerr_out_of_bounds;
     }
+    return zxerr_ok;
+}
+
+zxerr_t crypto_signDigest(const uint32_t path[HDPATH_LEN_DEFAULT], const uint8_t messageDigest[CRYPTO_DIGEST_SIZE], uint8_t *buffer, uint16_t signatureMaxlen, uint16_t *sigSize) {
+    zemu_log_stack("crypto_signDigest");
+
+    cx_curve_t curve = get_cx_curve(path);
+    if (curve!=CX_CURVE_SECP256K1 && curve!=CX_CURVE_SECP256R1 ) {
+        zemu_log_stack("crypto_signDigest: invalid_crypto_settings");
+        return zxerr_invalid_crypto_settings;
+    }
 
+    const uint16_t messageDigestSize = CRYPTO_DIGEST_SIZE;
     cx_ecfp_private_key_t cx_privateKey;
     const uint32_t domainSize = 32;
     uint8_t privateKeyData[32];
@@ -227,12 +229,311 @@ zxerr_t crypto_sign(const uint32_t path[HDPATH_LEN_DEFAULT], const uint8_t *mess
     return zxerr_ok;
 }
 
+#else
+#include "crypto_host.h"
+#include "sha256_host.h"
+#include "sha3_host.h"
+
+__Z_INLINE digest_type_e get_hash_type(const uint32_t path[HDPATH_LEN_DEFAULT]) {
+    const uint8_t hash_type = (uint8_t) (path[2] & 0xFF);
+    switch(hash_type) {
+        case 0x01:
+            return HASH_SHA2_256;
+        case 0x03:
+            return HASH_SHA3_256;
+        default:
+            return HASH_UNKNOWN;
+    }
+}
+
+__Z_INLINE curve_e get_curve(const uint32_t path[HDPATH_LEN_DEFAULT]) {
+    const uint8_t curve_code = (uint8_t) ((path[2] >> 8) & 0xFF);
+    switch(curve_code) {
+        case 0x02:
+            return CURVE_SECP256K1;
+        case 0x03:
+            return CURVE_SECP256R1;
+        default:
+            return CURVE_UNKNOWN;
+    }
+}
+
+zxerr_t crypto_extractPublicKey(const uint32_t path[HDPATH_LEN_DEFAULT], uint8_t *pubKey, uint16_t pubKeyLen) {
+    MEMZERO(pubKey, pubKeyLen);
+
+    const curve_e curve = get_curve(path);
+    if (curve == CURVE_UNKNOWN) {
+        return zxerr_invalid_crypto_settings;
+    }
+
+    if (pubKeyLen < SECP256K1_PK_LEN) {
+        return zxerr_buffer_too_small;
+    }
+
+    uint8_t privateKeyData[32];
+    zxerr_t err = crypto_host_deriveNodeBip32(curve, path, HDPATH_LEN_DEFAULT, privateKeyData);
+    if (err == zxerr_ok) {
+        err = crypto_host_publicKey(curve, privateKeyData, pubKey);
+    }
+    MEMZERO(privateKeyData, sizeof(privateKeyData));
+    return err;
+}
+
+zxerr_t digest_message(const uint8_t *message, uint16_t messageLen, digest_type_e hash_kind, uint8_t *digest, uint16_t digestMax,  uint16_t* digest_size) {
+    switch(hash_kind) {
+        case HASH_SHA2_256:
+            if (digestMax < CX_SHA256_SIZE) {
+                return zxerr_buffer_too_small;
+            }
+            sha256(message, messageLen, digest);
+            *digest_size = CX_SHA256_SIZE;
+            return zxerr_ok;
+        case HASH_SHA3_256:
+            if (digestMax < 32) {
+                return zxerr_buffer_too_small;
+            }
+            sha3_256_host(message, messageLen, digest);
+            *digest_size = 32;
+            return zxerr_ok;
+        default:
+            return zxerr_invalid_crypto_settings;
+    }
+}
+
+zxerr_t crypto_digest(const uint32_t path[HDPATH_LEN_DEFAULT], const uint8_t *message, uint16_t messageLen, uint8_t digest[CRYPTO_DIGEST_SIZE]) {
+    uint16_t messageDigestSize = 0;
+    CHECK_ZXERR(digest_message(message, messageLen, get_hash_type(path), digest, CRYPTO_DIGEST_SIZE, &messageDigestSize));
+
+    if (messageDigestSize != CRYPTO_DIGEST_SIZE) {
+        return zxerr_out_of_bounds;
+    }
+    return zxerr_ok;
+}
+
+zxerr_t crypto_signDigest(const uint32_t path[HDPATH_LEN_DEFAULT], const uint8_t messageDigest[CRYPTO_DIGEST_SIZE], uint8_t *buffer, uint16_t signatureMaxlen, uint16_t *sigSize) {
+    const curve_e curve = get_curve(path);
+    if (curve == CURVE_UNKNOWN) {
+        return zxerr_invalid_crypto_settings;
+    }
+
+    if (signatureMaxlen < sizeof(signature_t)) {
+        return zxerr_buffer_too_small;
+    }
+
+    signature_t *const signature = (signature_t *) buffer;
+    uint8_t privateKeyData[32];
+    uint16_t signatureLength = 0;
+    unsigned int info = 0;
+
+    zxerr_t err = crypto_host_deriveNodeBip32(curve, path, HDPATH_LEN_DEFAULT, privateKeyData);
+    if (err == zxerr_ok) {
+        err = crypto_host_ecdsaSign(curve, privateKeyData, messageDigest,
+                                    signature->der_signature, sizeof_field(signature_t, der_signature),
+                                    &signatureLength, &info);
+    }
+    MEMZERO(privateKeyData, sizeof(privateKeyData));
+    if (err != zxerr_ok) {
+        return err;
+    }
+
+    err_convert_e convertErr = convertDERtoRSV(signature->der_signature, info,  signature->r, signature->s, &signature->v);
+    if (convertErr != no_error) {
+        return zxerr_invalid_crypto_settings;
+    }
+
+    *sigSize = sizeof_field(signature_t, r) + sizeof_field(signature_t, s) + sizeof_field(signature_t, v) + signatureLength;
+    return zxerr_ok;
+}
+
+#define VERIFY_BATCH_CHUNK 64
+
+typedef struct {
+    crypto_host_verify_item_t items[VERIFY_BATCH_CHUNK];
+    crypto_verify_result_e results[VERIFY_BATCH_CHUNK];
+    size_t index[VERIFY_BATCH_CHUNK];
+    size_t count;
+} verify_group_t;
+
+// Checks the R || S || V || DER layout and that the DER form carries the same R and S
+static bool verify_split_signature(const crypto_verify_item_t *item) {
+    const uint16_t rsvLen = sizeof_field(signature_t, r) + sizeof_field(signature_t, s) + sizeof_field(signature_t, v);
+    if (item->signature == NULL || item->signatureLen < rsvLen + 2) {
+        return false;
+    }
+    const signature_t *signature = (const signature_t *) item->signature;
+    const uint16_t derLen = 2 + signature->der_signature[1];
+    if (derLen > sizeof_field(signature_t, der_signature) || item->signatureLen != rsvLen + derLen) {
+        return false;
+    }
+
+    // convertDERtoRSV trusts the inner lengths, they must add up to the sequence length
+    const uint8_t rLen = signature->der_signature[3];
+    if (rLen > 33 || 6 + rLen > derLen || 6 + rLen + signature->der_signature[5 + rLen] != derLen) {
+        return false;
+    }
+
+    uint8_t r[32], s[32], v = 0;
+    if (convertDERtoRSV(signature->der_signature, 0, r, s, &v) != no_error) {
+        return false;
+    }
+    return MEMCMP(r, signature->r, sizeof(r)) == 0 && MEMCMP(s, signature->s, sizeof(s)) == 0;
+}
+
+static void verify_batch_chunk(const crypto_verify_item_t *items, size_t count, crypto_verify_result_e *results) {
+    static verify_group_t groups[2];
+    static uint8_t digests[VERIFY_BATCH_CHUNK][CX_SHA256_SIZE];
+    const uint8_t *sha2Messages[VERIFY_BATCH_CHUNK];
+    size_t sha2Lens[VERIFY_BATCH_CHUNK];
+    size_t sha2Index[VERIFY_BATCH_CHUNK];
+    size_t sha2Count = 0;
+
+    groups[0].count = 0;
+    groups[1].count = 0;
+    for (size_t i = 0; i < count; i++) {
+        const crypto_verify_item_t *item = &items[i];
+        const curve_e curve = item->path != NULL ? get_curve(item->path) : CURVE_UNKNOWN;
+        const digest_type_e hashType = item->path != NULL ? get_hash_type(item->path) : HASH_UNKNOWN;
+        if (curve == CURVE_UNKNOWN || hashType == HASH_UNKNOWN) {
+            results[i] = CRYPTO_VERIFY_INVALID_SCHEME;
+            continue;
+        }
+        if (item->answer == NULL) {
+            results[i] = CRYPTO_VERIFY_INVALID_PUBKEY;
+            continue;
+        }
+        if (!verify_split_signature(item)) {
+            results[i] = CRYPTO_VERIFY_INVALID_SIGNATURE;
+            continue;
+        }
+
+        // SHA2 digests are computed together below
+        if (hashType == HASH_SHA2_256) {
+            sha2Messages[sha2Count] = item->message;
+            sha2Lens[sha2Count] = item->messageLen;
+            sha2Index[sha2Count] = i;
+            sha2Count++;
+        } else {
+            sha3_256_host(item->message, item->messageLen, digests[i]);
+        }
+
+        const signature_t *signature = (const signature_t *) item->signature;
+        verify_group_t *group = &groups[curve == CURVE_SECP256K1 ? 0 : 1];
+        crypto_host_verify_item_t *hostItem = &group->items[group->count];
+        hostItem->publicKey = item->answer;
+        hostItem->digest = digests[i];
+        hostItem->r = signature->r;
+        hostItem->s = signature->s;
+        hostItem->v = &signature->v;
+        group->index[group->count++] = i;
+    }
+
+    if (sha2Count > 0) {
+        static uint8_t sha2Digests[VERIFY_BATCH_CHUNK * SHA256_HOST_DIGEST_SIZE];
+        sha256_host_multi(sha2Messages, sha2Lens, sha2Count, sha2Digests);
+        for (size_t j = 0; j < sha2Count; j++) {
+            MEMCPY(digests[sha2Index[j]], sha2Digests + j * SHA256_HOST_DIGEST_SIZE, SHA256_HOST_DIGEST_SIZE);
+        }
+    }
+
+    const curve_e curves[2] = {CURVE_SECP256K1, CURVE_SECP256R1};
+    for (uint8_t g = 0; g < 2; g++) {
+        verify_group_t *group = &groups[g];
+        if (group->count == 0) {
+            continue;
+        }
+        crypto_host_ecdsaVerifyBatch(curves[g], group->items, group->count, group->results);
+        for (size_t j = 0; j < group->count; j++) {
+            results[group->index[j]] = group->results[j];
+        }
+    }
+}
+
+size_t crypto_verifyBatch(const crypto_verify_item_t *items, size_t count, crypto_verify_result_e *results) {
+    size_t valid = 0;
+    for (size_t start = 0; start < count; start += VERIFY_BATCH_CHUNK) {
+        const size_t chunk = count - start < VERIFY_BATCH_CHUNK ? count - start : VERIFY_BATCH_CHUNK;
+        verify_batch_chunk(items + start, chunk, results + start);
+        for (size_t i = start; i < start + chunk; i++) {
+            valid += results[i] == CRYPTO_VERIFY_OK;
+        }
+    }
+    return valid;
+}
+
+#endif
+
+zxerr_t crypto_sign(const uint32_t path[HDPATH_LEN_DEFAULT], const uint8_t *message, uint16_t messageLen, uint8_t *buffer, uint16_t signatureMaxlen,  uint16_t *sigSize) {
+    uint8_t messageDigest[CRYPTO_DIGEST_SIZE];
+    CHECK_ZXERR(crypto_digest(path, message, messageLen, messageDigest))
+    return crypto_signDigest(path, messageDigest, buffer, signatureMaxlen, sigSize);
+}
+
 typedef struct {
     uint8_t publicKey[SECP256K1_PK_LEN];
     char addrStr[SECP256K1_PK_LEN*2];
     uint8_t padding[4];
 } __attribute__((packed)) answer_t;
 
+typedef struct {
+    uint32_t path[HDPATH_LEN_DEFAULT];
+    uint8_t publicKey[SECP256K1_PK_LEN];
+    bool valid;
+} pubkey_cache_entry_t;
+
+typedef struct {
+    pubkey_cache_entry_t entry[PUBKEY_CACHE_SIZE];
+    // entry replaced by the next miss
+    uint8_t next;
+    uint32_t hits;
+    uint32_t misses;
+} pubkey_cache_t;
+
+static pubkey_cache_t pubkey_cache;
+
+void crypto_pubkeyCacheClear(void) {
+    MEMZERO(&pubkey_cache, sizeof(pubkey_cache));
+}
+
+void crypto_pubkeyCacheStats(uint32_t *hits, uint32_t *misses) {
+    *hits = pubkey_cache.hits;
+    *misses = pubkey_cache.misses;
+}
+
+// Hit and miss counters in emulator runs, nothing is formatted in other builds
+static void pubkey_cache_log(const char *event) {
+#if defined(ZEMU_LOGGING)
+    char buffer[60];
+    snprintf(buffer, sizeof(buffer), "pubkey cache %s: %d hits %d misses\n", event,
+             (int) pubkey_cache.hits, (int) pubkey_cache.misses);
+    zemu_log(buffer);
+#else
+    (void) event;
+#endif
+}
+
+static zxerr_t pubkey_cache_extract(const uint32_t path[HDPATH_LEN_DEFAULT], uint8_t publicKey[SECP256K1_PK_LEN]) {
+    for (uint8_t i = 0; i < PUBKEY_CACHE_SIZE; i++) {
+        const pubkey_cache_entry_t *entry = &pubkey_cache.entry[i];
+        if (entry->valid && MEMCMP(entry->path, path, sizeof(entry->path)) == 0) {
+            MEMCPY(publicKey, entry->publicKey, SECP256K1_PK_LEN);
+            pubkey_cache.hits++;
+            pubkey_cache_log("hit");
+            return zxerr_ok;
+        }
+    }
+
+    CHECK_ZXERR(crypto_extractPublicKey(path, publicKey, SECP256K1_PK_LEN));
+
+    pubkey_cache_entry_t *entry = &pubkey_cache.entry[pubkey_cache.next];
+    MEMCPY(entry->path, path, sizeof(entry->path));
+    MEMCPY(entry->publicKey, publicKey, SECP256K1_PK_LEN);
+    entry->valid = true;
+    pubkey_cache.next = (uint8_t) ((pubkey_cache.next + 1) % PUBKEY_CACHE_SIZE);
+    pubkey_cache.misses++;
+    pubkey_cache_log("miss");
+    return zxerr_ok;
+}
+
 zxerr_t crypto_fillAddress(const uint32_t path[HDPATH_LEN_DEFAULT], uint8_t *buffer, uint16_t buffer_len, uint16_t *addrLen) {
     MEMZERO(buffer, buffer_len);
 
@@ -243,7 +544,7 @@ zxerr_t crypto_fillAddress(const uint32_t path[HDPATH_LEN_DEFAULT], uint8_t *buf
 
     answer_t *const answer = (answer_t *) buffer;
 
-    CHECK_ZXERR(crypto_extractPublicKey(path, answer->publicKey, sizeof_field(answer_t, publicKey)));
+    CHECK_ZXERR(pubkey_cache_extract(path, answer->publicKey));
 
     array_to_hexstr(answer->addrStr, sizeof_field(answer_t, addrStr) + 2, answer->publicKey, sizeof_field(answer_t, publicKey) );
 
@@ -251,4 +552,29 @@ zxerr_t crypto_fillAddress(const uint32_t path[HDPATH_LEN_DEFAULT], uint8_t *buf
     return zxerr_ok;
 }
 
-#endif
+zxerr_t crypto_fillPublicKeys(const uint32_t *paths, uint8_t count, bool compressed,
+                              uint8_t *buffer, uint16_t bufferLen, uint16_t *outLen) {
+    const uint16_t keyLen = compressed ? PK_COMPRESSED_LEN : SECP256K1_PK_LEN;
+    *outLen = 0;
+    if (count * keyLen > bufferLen) {
+        zemu_log_stack("crypto_fillPublicKeys: zxerr_buffer_too_small");
+        return zxerr_buffer_too_small;
+    }
+
+    uint8_t publicKey[SECP256K1_PK_LEN];
+    for (uint8_t i = 0; i < count; i++) {
+        CHECK_ZXERR(pubkey_cache_extract(paths + i * HDPATH_LEN_DEFAULT, publicKey));
+
+        uint8_t *out = buffer + i * keyLen;
+        if (compressed) {
+            // 0x02 or 0x03 depending on the parity of Y, then X
+            out[0] = (uint8_t) (0x02u | (publicKey[SECP256K1_PK_LEN - 1] & 1u));
+            MEMCPY(out + 1, publicKey + 1, PK_COMPRESSED_LEN - 1);
+        } else {
+            MEMCPY(out, publicKey, SECP256K1_PK_LEN);
+        }
+    }
+
+    *outLen = count * keyLen;
+    return zxerr_ok;
+}
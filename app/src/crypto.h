@@ -51,6 +51,34 @@ zxerr_t crypto_extractPublicKey(const uint32_t path[HDPATH_LEN_DEFAULT], uint8_t
 
 zxerr_t crypto_fillAddress(const uint32_t path[HDPATH_LEN_DEFAULT], uint8_t *buffer, uint16_t bufferLen, uint16_t *addrLen);
 
+// Public keys of count paths (HDPATH_LEN_DEFAULT items each) back to back,
+// uncompressed or SEC1 compressed (PK_COMPRESSED_LEN bytes each)
+zxerr_t crypto_fillPublicKeys(const uint32_t *paths, uint8_t count, bool compressed,
+                              uint8_t *buffer, uint16_t bufferLen, uint16_t *outLen);
+
+// crypto_fillAddress and crypto_fillPublicKeys keep the last few derived public keys, keyed by the full
+// path (path[2] carries the curve and hash). Only public keys are stored.
+// Cleared on app start and slot changes. Nano S keeps two entries, each one takes about 88 bytes of RAM.
+#if defined(TARGET_NANOS)
+#define PUBKEY_CACHE_SIZE 2
+#else
+#define PUBKEY_CACHE_SIZE 4
+#endif
+
+void crypto_pubkeyCacheClear(void);
+
+void crypto_pubkeyCacheStats(uint32_t *hits, uint32_t *misses);
+
+#define CRYPTO_DIGEST_SIZE 32
+
+// Digest of message with the hash selected by path[2]
+zxerr_t crypto_digest(const uint32_t path[HDPATH_LEN_DEFAULT], const uint8_t *message, uint16_t messageLen,
+                      uint8_t digest[CRYPTO_DIGEST_SIZE]);
+
+// crypto_sign over a digest from crypto_digest, same output layout
+zxerr_t crypto_signDigest(const uint32_t path[HDPATH_LEN_DEFAULT], const uint8_t digest[CRYPTO_DIGEST_SIZE],
+                          uint8_t *signature, uint16_t signatureMaxlen, uint16_t *sigSize);
+
 zxerr_t crypto_sign(
     const uint32_t path[HDPATH_LEN_DEFAULT],
     const uint8_t *message,
@@ -60,6 +88,34 @@ zxerr_t crypto_sign(
     uint16_t *sigSize
 );
 
+#if !defined(TARGET_NANOS) && !defined(TARGET_NANOX) && !defined(TARGET_NANOS2)
+typedef enum {
+    CRYPTO_VERIFY_OK = 0,
+    CRYPTO_VERIFY_INVALID_SCHEME,
+    CRYPTO_VERIFY_INVALID_PUBKEY,
+    // R, S, V or DER are malformed or do not agree
+    CRYPTO_VERIFY_INVALID_SIGNATURE,
+    CRYPTO_VERIFY_FAILED,
+} crypto_verify_result_e;
+
+typedef struct {
+    // Derivation path the signature was made with, path[2] selects curve and hash
+    const uint32_t *path;
+    // crypto_fillAddress output, the public key comes first
+    const uint8_t *answer;
+    // Message as given to crypto_sign, including the domain tag
+    const uint8_t *message;
+    uint16_t messageLen;
+    // crypto_sign output: R || S || V || DER
+    const uint8_t *signature;
+    uint16_t signatureLen;
+} crypto_verify_item_t;
+
+// Host only: verifies crypto_sign signatures, results[i] is set for every item.
+// Returns the number of valid signatures.
+size_t crypto_verifyBatch(const crypto_verify_item_t *items, size_t count, crypto_verify_result_e *results);
+#endif
+
 #ifdef __cplusplus
 }
 #endif
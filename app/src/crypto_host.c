@@ -0,0 +1,1342 @@
+/*******************************************************************************
+*   (c) 2021 Zondax GmbH
+*
+*  Licensed under the Apache License, Version 2.0 (the "License");
+*  you may not use this file except in compliance with the License.
+*  You may obtain a copy of the License at
+*
+*      http://www.apache.org/licenses/LICENSE-2.0
+*
+*  Unless required by applicable law or agreed to in writing, software
+*  distributed under the License is distributed on an "AS IS" BASIS,
+*  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+*  See the License for the specific language governing permissions and
+*  limitations under the License.
+********************************************************************************/
+
+#if !defined(TARGET_NANOS) && !defined(TARGET_NANOX) && !defined(TARGET_NANOS2)
+
+#include "crypto_host.h"
+#include "sha256_host.h"
+#include "zxmacros.h"
+
+////////////////////////////////////////////////////////////////////////////////
+// SHA-512, HMAC and PBKDF2
+
+typedef struct {
+    uint64_t state[8];
+    uint8_t block[128];
+    uint8_t blockLen;
+    uint64_t totalLen;
+} sha512_ctx_t;
+
+static const uint64_t sha512_k[80] = {
+        0x428a2f98d728ae22, 0x7137449123ef65cd, 0xb5c0fbcfec4d3b2f, 0xe9b5dba58189dbbc, 0x3956c25bf348b538,
+        0x59f111f1b605d019, 0x923f82a4af194f9b, 0xab1c5ed5da6d8118, 0xd807aa98a3030242, 0x12835b0145706fbe,
+        0x243185be4ee4b28c, 0x550c7dc3d5ffb4e2, 0x72be5d74f27b896f, 0x80deb1fe3b1696b1, 0x9bdc06a725c71235,
+        0xc19bf174cf692694, 0xe49b69c19ef14ad2, 0xefbe4786384f25e3, 0x0fc19dc68b8cd5b5, 0x240ca1cc77ac9c65,
+        0x2de92c6f592b0275, 0x4a7484aa6ea6e483, 0x5cb0a9dcbd41fbd4, 0x76f988da831153b5, 0x983e5152ee66dfab,
+        0xa831c66d2db43210, 0xb00327c898fb213f, 0xbf597fc7beef0ee4, 0xc6e00bf33da88fc2, 0xd5a79147930aa725,
+        0x06ca6351e003826f, 0x142929670a0e6e70, 0x27b70a8546d22ffc, 0x2e1b21385c26c926, 0x4d2c6dfc5ac42aed,
+        0x53380d139d95b3df, 0x650a73548baf63de, 0x766a0abb3c77b2a8, 0x81c2c92e47edaee6, 0x92722c851482353b,
+        0xa2bfe8a14cf10364, 0xa81a664bbc423001, 0xc24b8b70d0f89791, 0xc76c51a30654be30, 0xd192e819d6ef5218,
+        0xd69906245565a910, 0xf40e35855771202a, 0x106aa07032bbd1b8, 0x19a4c116b8d2d0c8, 0x1e376c085141ab53,
+        0x2748774cdf8eeb99, 0x34b0bcb5e19b48a8, 0x391c0cb3c5c95a63, 0x4ed8aa4ae3418acb, 0x5b9cca4f7763e373,
+        0x682e6ff3d6b2b8a3, 0x748f82ee5defb2fc, 0x78a5636f43172f60, 0x84c87814a1f0ab72, 0x8cc702081a6439ec,
+        0x90befffa23631e28, 0xa4506cebde82bde9, 0xbef9a3f7b2c67915, 0xc67178f2e372532b, 0xca273eceea26619c,
+        0xd186b8c721c0c207, 0xeada7dd6cde0eb1e, 0xf57d4f7fee6ed178, 0x06f067aa72176fba, 0x0a637dc5a2c898a6,
+        0x113f9804bef90dae, 0x1b710b35131c471b, 0x28db77f523047d84, 0x32caab7b40c72493, 0x3c9ebe0a15c9bebc,
+        0x431d67c49c100d4c, 0x4cc5d4becb3e42b6, 0x597f299cfc657e2a, 0x5fcb6fab3ad6faec, 0x6c44198c4a475817,
+};
+
+#define ROTR64(x, n) (((x) >> (n)) | ((x) << (64u - (n))))
+
+static uint64_t load_be64(const uint8_t *p) {
+    uint64_t v = 0;
+    for (uint8_t i = 0; i < 8; i++) {
+        v = (v << 8u) | p[i];
+    }
+    return v;
+}
+
+static void store_be64(uint8_t *p, uint64_t v) {
+    for (uint8_t i = 0; i < 8; i++) {
+        p[7 - i] = (uint8_t) (v >> (8u * i));
+    }
+}
+
+static void sha512_compress(uint64_t state[8], const uint8_t block[128]) {
+    uint64_t w[80];
+    for (uint8_t i = 0; i < 16; i++) {
+        w[i] = load_be64(block + 8 * i);
+    }
+    for (uint8_t i = 16; i < 80; i++) {
+        const uint64_t s0 = ROTR64(w[i - 15], 1u) ^ ROTR64(w[i - 15], 8u) ^ (w[i - 15] >> 7u);
+        const uint64_t s1 = ROTR64(w[i - 2], 19u) ^ ROTR64(w[i - 2], 61u) ^ (w[i - 2] >> 6u);
+        w[i] = w[i - 16] + s0 + w[i - 7] + s1;
+    }
+
+    uint64_t a = state[0], b = state[1], c = state[2], d = state[3];
+    uint64_t e = state[4], f = state[5], g = state[6], h = state[7];
+    for (uint8_t i = 0; i < 80; i++) {
+        const uint64_t t1 = h + (ROTR64(e, 14u) ^ ROTR64(e, 18u) ^ ROTR64(e, 41u)) + ((e & f) ^ (~e & g)) +
+                            sha512_k[i] + w[i];
+        const uint64_t t2 = (ROTR64(a, 28u) ^ ROTR64(a, 34u) ^ ROTR64(a, 39u)) + ((a & b) ^ (a & c) ^ (b & c));
+        h = g;
+        g = f;
+        f = e;
+        e = d + t1;
+        d = c;
+        c = b;
+        b = a;
+        a = t1 + t2;
+    }
+    state[0] += a;
+    state[1] += b;
+    state[2] += c;
+    state[3] += d;
+    state[4] += e;
+    state[5] += f;
+    state[6] += g;
+    state[7] += h;
+}
+
+static void sha512_init(sha512_ctx_t *ctx) {
+    static const uint64_t iv[8] = {
+            0x6a09e667f3bcc908, 0xbb67ae8584caa73b, 0x3c6ef372fe94f82b, 0xa54ff53a5f1d36f1,
+            0x510e527fade682d1, 0x9b05688c2b3e6c1f, 0x1f83d9abfb41bd6b, 0x5be0cd19137e2179,
+    };
+    MEMCPY(ctx->state, iv, sizeof(iv));
+    ctx->blockLen = 0;
+    ctx->totalLen = 0;
+}
+
+static void sha512_update(sha512_ctx_t *ctx, const uint8_t *data, size_t len) {
+    ctx->totalLen += len;
+    while (len > 0) {
+        size_t n = sizeof(ctx->block) - ctx->blockLen;
+        if (n > len) {
+            n = len;
+        }
+        MEMCPY(ctx->block + ctx->blockLen, data, n);
+        ctx->blockLen += (uint8_t) n;
+        data += n;
+        len -= n;
+        if (ctx->blockLen == sizeof(ctx->block)) {
+            sha512_compress(ctx->state, ctx->block);
+            ctx->blockLen = 0;
+        }
+    }
+}
+
+static void sha512_final(sha512_ctx_t *ctx, uint8_t digest[64]) {
+    const uint64_t bitLen = ctx->totalLen * 8;
+    ctx->block[ctx->blockLen++] = 0x80;
+    if (ctx->blockLen > 112) {
+        MEMZERO(ctx->block + ctx->blockLen, sizeof(ctx->block) - ctx->blockLen);
+        sha512_compress(ctx->state, ctx->block);
+        ctx->blockLen = 0;
+    }
+    MEMZERO(ctx->block + ctx->blockLen, sizeof(ctx->block) - ctx->blockLen);
+    // messages are far below 2^64 bits, the upper half of the length is 0
+    store_be64(ctx->block + 120, bitLen);
+    sha512_compress(ctx->state, ctx->block);
+    for (uint8_t i = 0; i < 8; i++) {
+        store_be64(digest + 8 * i, ctx->state[i]);
+    }
+}
+
+void crypto_host_sha512(const uint8_t *message, size_t messageLen, uint8_t digest[64]) {
+    sha512_ctx_t ctx;
+    sha512_init(&ctx);
+    sha512_update(&ctx, message, messageLen);
+    sha512_final(&ctx, digest);
+}
+
+typedef struct {
+    sha512_ctx_t inner;
+    sha512_ctx_t outer;
+} hmac_sha512_ctx_t;
+
+static void hmac_sha512_init(hmac_sha512_ctx_t *ctx, const uint8_t *key, size_t keyLen) {
+    uint8_t pad[128];
+    MEMZERO(pad, sizeof(pad));
+    if (keyLen > sizeof(pad)) {
+        crypto_host_sha512(key, keyLen, pad);
+    } else {
+        MEMCPY(pad, key, keyLen);
+    }
+
+    for (uint8_t i = 0; i < sizeof(pad); i++) {
+        pad[i] ^= 0x36u;
+    }
+    sha512_init(&ctx->inner);
+    sha512_update(&ctx->inner, pad, sizeof(pad));
+
+    for (uint8_t i = 0; i < sizeof(pad); i++) {
+        pad[i] ^= 0x36u ^ 0x5cu;
+    }
+    sha512_init(&ctx->outer);
+    sha512_update(&ctx->outer, pad, sizeof(pad));
+    MEMZERO(pad, sizeof(pad));
+}
+
+static void hmac_sha512_final(hmac_sha512_ctx_t *ctx, uint8_t mac[64]) {
+    uint8_t innerDigest[64];
+    sha512_final(&ctx->inner, innerDigest);
+    sha512_update(&ctx->outer, innerDigest, sizeof(innerDigest));
+    sha512_final(&ctx->outer, mac);
+    MEMZERO(ctx, sizeof(*ctx));
+}
+
+static void hmac_sha512(const uint8_t *key, size_t keyLen, const uint8_t *data, size_t dataLen, uint8_t mac[64]) {
+    hmac_sha512_ctx_t ctx;
+    hmac_sha512_init(&ctx, key, keyLen);
+    sha512_update(&ctx.inner, data, dataLen);
+    hmac_sha512_final(&ctx, mac);
+}
+
+// HMAC-SHA256 for the RFC6979 nonces
+static void hmac_sha256(const uint8_t key[32], const uint8_t *data, uint16_t dataLen, uint8_t mac[32]) {
+    uint8_t pad[SHA256_HOST_BLOCK_SIZE];
+    MEMZERO(pad, sizeof(pad));
+    MEMCPY(pad, key, 32);
+    for (uint8_t i = 0; i < sizeof(pad); i++) {
+        pad[i] ^= 0x36u;
+    }
+
+    uint8_t innerDigest[SHA256_HOST_DIGEST_SIZE];
+    sha256_host_ctx_t ctx;
+    sha256_host_init(&ctx);
+    sha256_host_update(&ctx, pad, sizeof(pad));
+    sha256_host_update(&ctx, data, dataLen);
+    sha256_host_final(&ctx, innerDigest);
+
+    for (uint8_t i = 0; i < sizeof(pad); i++) {
+        pad[i] ^= 0x36u ^ 0x5cu;
+    }
+    sha256_host_init(&ctx);
+    sha256_host_update(&ctx, pad, sizeof(pad));
+    sha256_host_update(&ctx, innerDigest, sizeof(innerDigest));
+    sha256_host_final(&ctx, mac);
+    MEMZERO(pad, sizeof(pad));
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// 256-bit Montgomery arithmetic
+
+typedef unsigned __int128 uint128_t;
+
+typedef struct {
+    uint64_t m[4];
+    // -m^-1 mod 2^64
+    uint64_t minv;
+    // R^2 mod m and R mod m, R = 2^256
+    uint64_t r2[4];
+    uint64_t one[4];
+} mont_t;
+
+static void u256_from_be(uint64_t r[4], const uint8_t in[32]) {
+    for (uint8_t i = 0; i < 4; i++) {
+        r[i] = load_be64(in + 8 * (3 - i));
+    }
+}
+
+static void u256_to_be(uint8_t out[32], const uint64_t a[4]) {
+    for (uint8_t i = 0; i < 4; i++) {
+        store_be64(out + 8 * (3 - i), a[i]);
+    }
+}
+
+static bool u256_is_zero(const uint64_t a[4]) {
+    return (a[0] | a[1] | a[2] | a[3]) == 0;
+}
+
+static bool u256_eq(const uint64_t a[4], const uint64_t b[4]) {
+    return ((a[0] ^ b[0]) | (a[1] ^ b[1]) | (a[2] ^ b[2]) | (a[3] ^ b[3])) == 0;
+}
+
+// r = a - b, returns the borrow
+static uint64_t u256_sub(uint64_t r[4], const uint64_t a[4], const uint64_t b[4]) {
+    uint64_t borrow = 0;
+    for (uint8_t i = 0; i < 4; i++) {
+        const uint128_t d = (uint128_t) a[i] - b[i] - borrow;
+        r[i] = (uint64_t) d;
+        borrow = (uint64_t) (d >> 64u) & 1u;
+    }
+    return borrow;
+}
+
+// r = a + b, returns the carry
+static uint64_t u256_add(uint64_t r[4], const uint64_t a[4], const uint64_t b[4]) {
+    uint64_t carry = 0;
+    for (uint8_t i = 0; i < 4; i++) {
+        const uint128_t s = (uint128_t) a[i] + b[i] + carry;
+        r[i] = (uint64_t) s;
+        carry = (uint64_t) (s >> 64u);
+    }
+    return carry;
+}
+
+static bool u256_lt(const uint64_t a[4], const uint64_t b[4]) {
+    uint64_t tmp[4];
+    return u256_sub(tmp, a, b) != 0;
+}
+
+static void mod_add(uint64_t r[4], const uint64_t a[4], const uint64_t b[4], const mont_t *m) {
+    uint64_t sum[4], reduced[4];
+    const uint64_t carry = u256_add(sum, a, b);
+    const uint64_t borrow = u256_sub(reduced, sum, m->m);
+    if (carry || !borrow) {
+        MEMCPY(r, reduced, sizeof(reduced));
+    } else {
+        MEMCPY(r, sum, sizeof(sum));
+    }
+}
+
+static void mod_sub(uint64_t r[4], const uint64_t a[4], const uint64_t b[4], const mont_t *m) {
+    uint64_t diff[4];
+    if (u256_sub(diff, a, b)) {
+        u256_add(diff, diff, m->m);
+    }
+    MEMCPY(r, diff, sizeof(diff));
+}
+
+static void mont_mul(uint64_t r[4], const uint64_t a[4], const uint64_t b[4], const mont_t *m) {
+    uint64_t t[6] = {0};
+    for (uint8_t i = 0; i < 4; i++) {
+        uint128_t c = 0;
+        for (uint8_t j = 0; j < 4; j++) {
+            c += (uint128_t) a[j] * b[i] + t[j];
+            t[j] = (uint64_t) c;
+            c >>= 64u;
+        }
+        c += t[4];
+        t[4] = (uint64_t) c;
+        t[5] = (uint64_t) (c >> 64u);
+
+        const uint64_t q = t[0] * m->minv;
+        c = ((uint128_t) q * m->m[0] + t[0]) >> 64u;
+        for (uint8_t j = 1; j < 4; j++) {
+            c += (uint128_t) q * m->m[j] + t[j];
+            t[j - 1] = (uint64_t) c;
+            c >>= 64u;
+        }
+        c += t[4];
+        t[3] = (uint64_t) c;
+        t[4] = t[5] + (uint64_t) (c >> 64u);
+    }
+
+    uint64_t reduced[4];
+    const uint64_t borrow = u256_sub(reduced, t, m->m);
+    if (t[4] || !borrow) {
+        MEMCPY(r, reduced, sizeof(reduced));
+    } else {
+        MEMCPY(r, t, 4 * sizeof(uint64_t));
+    }
+}
+
+static void mont_sqr(uint64_t r[4], const uint64_t a[4], const mont_t *m) {
+    mont_mul(r, a, a, m);
+}
+
+static void mont_setup(mont_t *m, const uint64_t modulus[4]) {
+    MEMCPY(m->m, modulus, sizeof(m->m));
+
+    // Newton iteration for m^-1 mod 2^64
+    uint64_t inv = 1;
+    for (uint8_t i = 0; i < 6; i++) {
+        inv *= 2 - modulus[0] * inv;
+    }
+    m->minv = 0 - inv;
+
+    // R mod m = 2^256 - m for the 256-bit moduli used here
+    const uint64_t zero[4] = {0};
+    u256_sub(m->one, zero, modulus);
+
+    // R^2 mod m by doubling R mod m 256 times
+    MEMCPY(m->r2, m->one, sizeof(m->r2));
+    for (uint16_t i = 0; i < 256; i++) {
+        mod_add(m->r2, m->r2, m->r2, m);
+    }
+}
+
+static void mont_to(uint64_t r[4], const uint64_t a[4], const mont_t *m) {
+    mont_mul(r, a, m->r2, m);
+}
+
+static void mont_from(uint64_t r[4], const uint64_t a[4], const mont_t *m) {
+    const uint64_t one[4] = {1, 0, 0, 0};
+    mont_mul(r, a, one, m);
+}
+
+// a^(m-2), a in Montgomery form
+static void mont_inv(uint64_t r[4], const uint64_t a[4], const mont_t *m) {
+    uint64_t e[4];
+    const uint64_t two[4] = {2, 0, 0, 0};
+    u256_sub(e, m->m, two);
+
+    uint64_t acc[4];
+    MEMCPY(acc, m->one, sizeof(acc));
+    for (int16_t bit = 255; bit >= 0; bit--) {
+        mont_sqr(acc, acc, m);
+        if ((e[bit / 64] >> (bit % 64)) & 1u) {
+            mont_mul(acc, acc, a, m);
+        }
+    }
+    MEMCPY(r, acc, sizeof(acc));
+}
+
+// a mod m for a < 2^256, the moduli used here are above 2^255
+static void mod_reduce_once(uint64_t r[4], const uint64_t a[4], const mont_t *m) {
+    uint64_t reduced[4];
+    if (u256_sub(reduced, a, m->m)) {
+        MEMCPY(r, a, 4 * sizeof(uint64_t));
+    } else {
+        MEMCPY(r, reduced, sizeof(reduced));
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// Short Weierstrass curves y^2 = x^3 + ax + b, Jacobian coordinates in Montgomery form
+
+#define GEN_TABLE_WINDOWS 64
+#define GEN_TABLE_ENTRIES 16
+
+typedef struct {
+    uint64_t x[4];
+    uint64_t y[4];
+} affine_point_t;
+
+typedef struct {
+    uint64_t x[4];
+    uint64_t y[4];
+    uint64_t z[4];
+} jacobian_point_t;
+
+typedef struct {
+    const char *seedKey;
+    mont_t p;
+    mont_t n;
+    uint64_t a[4];
+    uint64_t b[4];
+    affine_point_t g;
+    // table[i][j] = j * 16^i * G, so that k * G is one mixed addition per nibble of k
+    affine_point_t table[GEN_TABLE_WINDOWS][GEN_TABLE_ENTRIES];
+    // secp256k1 endomorphism (x, y) -> (beta * x, y) = lambda * (x, y), see glv_split
+    bool glv;
+    uint64_t beta[4];
+    uint64_t lambda[4];
+    bool ready;
+} curve_ctx_t;
+
+static curve_ctx_t curve_secp256k1;
+static curve_ctx_t curve_secp256r1;
+
+static bool point_is_infinity(const jacobian_point_t *p) {
+    return u256_is_zero(p->z);
+}
+
+static void point_double(jacobian_point_t *r, const jacobian_point_t *p, const curve_ctx_t *c) {
+    if (point_is_infinity(p) || u256_is_zero(p->y)) {
+        MEMZERO(r, sizeof(*r));
+        return;
+    }
+    const mont_t *f = &c->p;
+    uint64_t xx[4], yy[4], yyyy[4], zz[4], s[4], mm[4], t[4], tmp[4];
+
+    mont_sqr(xx, p->x, f);
+    mont_sqr(yy, p->y, f);
+    mont_sqr(yyyy, yy, f);
+    mont_sqr(zz, p->z, f);
+
+    // S = 4 * X * YY
+    mont_mul(s, p->x, yy, f);
+    mod_add(s, s, s, f);
+    mod_add(s, s, s, f);
+
+    // M = 3 * XX + a * ZZ^2
+    mod_add(mm, xx, xx, f);
+    mod_add(mm, mm, xx, f);
+    if (!u256_is_zero(c->a)) {
+        mont_sqr(tmp, zz, f);
+        mont_mul(tmp, tmp, c->a, f);
+        mod_add(mm, mm, tmp, f);
+    }
+
+    // Z3 = 2 * Y * Z (before Y and Z are overwritten, r may alias p)
+    uint64_t z3[4];
+    mont_mul(z3, p->y, p->z, f);
+    mod_add(z3, z3, z3, f);
+
+    // X3 = M^2 - 2S
+    mont_sqr(t, mm, f);
+    mod_sub(t, t, s, f);
+    mod_sub(t, t, s, f);
+
+    // Y3 = M * (S - X3) - 8 * YYYY
+    mod_sub(tmp, s, t, f);
+    mont_mul(tmp, mm, tmp, f);
+    mod_add(yyyy, yyyy, yyyy, f);
+    mod_add(yyyy, yyyy, yyyy, f);
+    mod_add(yyyy, yyyy, yyyy, f);
+    mod_sub(r->y, tmp, yyyy, f);
+
+    MEMCPY(r->x, t, sizeof(t));
+    MEMCPY(r->z, z3, sizeof(z3));
+}
+
+static void point_add_mixed(jacobian_point_t *r, const jacobian_point_t *p, const affine_point_t *q,
+                            const curve_ctx_t *c) {
+    const mont_t *f = &c->p;
+    if (point_is_infinity(p)) {
+        MEMCPY(r->x, q->x, sizeof(r->x));
+        MEMCPY(r->y, q->y, sizeof(r->y));
+        MEMCPY(r->z, f->one, sizeof(r->z));
+        return;
+    }
+
+    uint64_t z1z1[4], u2[4], s2[4], h[4], rr[4], hh[4], hhh[4], v[4], tmp[4];
+    mont_sqr(z1z1, p->z, f);
+    mont_mul(u2, q->x, z1z1, f);
+    mont_mul(s2, q->y, p->z, f);
+    mont_mul(s2, s2, z1z1, f);
+
+    mod_sub(h, u2, p->x, f);
+    mod_sub(rr, s2, p->y, f);
+
+    if (u256_is_zero(h)) {
+        if (u256_is_zero(rr)) {
+            point_double(r, p, c);
+        } else {
+            MEMZERO(r, sizeof(*r));
+        }
+        return;
+    }
+
+    mont_sqr(hh, h, f);
+    mont_mul(hhh, h, hh, f);
+    mont_mul(v, p->x, hh, f);
+
+    // X3 = r^2 - HHH - 2V
+    uint64_t x3[4];
+    mont_sqr(x3, rr, f);
+    mod_sub(x3, x3, hhh, f);
+    mod_sub(x3, x3, v, f);
+    mod_sub(x3, x3, v, f);
+
+    // Y3 = r * (V - X3) - Y1 * HHH
+    uint64_t y3[4];
+    mod_sub(tmp, v, x3, f);
+    mont_mul(y3, rr, tmp, f);
+    mont_mul(tmp, p->y, hhh, f);
+    mod_sub(y3, y3, tmp, f);
+
+    // Z3 = Z1 * H
+    mont_mul(r->z, p->z, h, f);
+    MEMCPY(r->x, x3, sizeof(x3));
+    MEMCPY(r->y, y3, sizeof(y3));
+}
+
+static void point_to_affine(affine_point_t *r, const jacobian_point_t *p, const curve_ctx_t *c) {
+    const mont_t *f = &c->p;
+    uint64_t zinv[4], zinv2[4];
+    mont_inv(zinv, p->z, f);
+    mont_sqr(zinv2, zinv, f);
+    mont_mul(r->x, p->x, zinv2, f);
+    mont_mul(zinv2, zinv2, zinv, f);
+    mont_mul(r->y, p->y, zinv2, f);
+}
+
+static void curve_setup(curve_ctx_t *c, const char *seedKey,
+                        const uint8_t p[32], const uint8_t n[32], const uint8_t a[32], const uint8_t b[32],
+                        const uint8_t gx[32], const uint8_t gy[32]) {
+    uint64_t tmp[4];
+    c->seedKey = seedKey;
+    u256_from_be(tmp, p);
+    mont_setup(&c->p, tmp);
+    u256_from_be(tmp, n);
+    mont_setup(&c->n, tmp);
+
+    u256_from_be(tmp, a);
+    mont_to(c->a, tmp, &c->p);
+    u256_from_be(tmp, b);
+    mont_to(c->b, tmp, &c->p);
+    u256_from_be(tmp, gx);
+    mont_to(c->g.x, tmp, &c->p);
+    u256_from_be(tmp, gy);
+    mont_to(c->g.y, tmp, &c->p);
+
+    affine_point_t base = c->g;
+    for (uint8_t i = 0; i < GEN_TABLE_WINDOWS; i++) {
+        MEMZERO(&c->table[i][0], sizeof(affine_point_t));
+
+        jacobian_point_t acc;
+        MEMZERO(&acc, sizeof(acc));
+        for (uint8_t j = 1; j < GEN_TABLE_ENTRIES; j++) {
+            point_add_mixed(&acc, &acc, &base, c);
+            point_to_affine(&c->table[i][j], &acc, c);
+        }
+
+        // next base = 16 * base
+        point_add_mixed(&acc, &acc, &base, c);
+        point_to_affine(&base, &acc, c);
+    }
+
+    c->ready = true;
+}
+
+static const curve_ctx_t *get_curve(curve_e curve) {
+    switch (curve) {
+        case CURVE_SECP256K1:
+            if (!curve_secp256k1.ready) {
+                static const uint8_t p[32] = {
+                        0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+                        0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFE, 0xFF, 0xFF, 0xFC, 0x2F};
+                static const uint8_t n[32] = {
+                        0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFE,
+                        0xBA, 0xAE, 0xDC, 0xE6, 0xAF, 0x48, 0xA0, 0x3B, 0xBF, 0xD2, 0x5E, 0x8C, 0xD0, 0x36, 0x41, 0x41};
+                static const uint8_t a[32] = {0};
+                static const uint8_t b[32] = {[31] = 0x07};
+                static const uint8_t gx[32] = {
+                        0x79, 0xBE, 0x66, 0x7E, 0xF9, 0xDC, 0xBB, 0xAC, 0x55, 0xA0, 0x62, 0x95, 0xCE, 0x87, 0x0B, 0x07,
+                        0x02, 0x9B, 0xFC, 0xDB, 0x2D, 0xCE, 0x28, 0xD9, 0x59, 0xF2, 0x81, 0x5B, 0x16, 0xF8, 0x17, 0x98};
+                static const uint8_t gy[32] = {
+                        0x48, 0x3A, 0xDA, 0x77, 0x26, 0xA3, 0xC4, 0x65, 0x5D, 0xA4, 0xFB, 0xFC, 0x0E, 0x11, 0x08, 0xA8,
+                        0xFD, 0x17, 0xB4, 0x48, 0xA6, 0x85, 0x54, 0x19, 0x9C, 0x47, 0xD0, 0x8F, 0xFB, 0x10, 0xD4, 0xB8};
+                static const uint8_t beta[32] = {
+                        0x7A, 0xE9, 0x6A, 0x2B, 0x65, 0x7C, 0x07, 0x10, 0x6E, 0x64, 0x47, 0x9E, 0xAC, 0x34, 0x34, 0xE9,
+                        0x9C, 0xF0, 0x49, 0x75, 0x12, 0xF5, 0x89, 0x95, 0xC1, 0x39, 0x6C, 0x28, 0x71, 0x95, 0x01, 0xEE};
+                static const uint8_t lambda[32] = {
+                        0x53, 0x63, 0xAD, 0x4C, 0xC0, 0x5C, 0x30, 0xE0, 0xA5, 0x26, 0x1C, 0x02, 0x88, 0x12, 0x64, 0x5A,
+                        0x12, 0x2E, 0x22, 0xEA, 0x20, 0x81, 0x66, 0x78, 0xDF, 0x02, 0x96, 0x7C, 0x1B, 0x23, 0xBD, 0x72};
+                curve_setup(&curve_secp256k1, "Bitcoin seed", p, n, a, b, gx, gy);
+                uint64_t tmp[4];
+                u256_from_be(tmp, beta);
+                mont_to(curve_secp256k1.beta, tmp, &curve_secp256k1.p);
+                u256_from_be(tmp, lambda);
+                mont_to(curve_secp256k1.lambda, tmp, &curve_secp256k1.n);
+                curve_secp256k1.glv = true;
+            }
+            return &curve_secp256k1;
+        case CURVE_SECP256R1:
+            if (!curve_secp256r1.ready) {
+                static const uint8_t p[32] = {
+                        0xFF, 0xFF, 0xFF, 0xFF, 0x00, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+                        0x00, 0x00, 0x00, 0x00, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF};
+                static const uint8_t n[32] = {
+                        0xFF, 0xFF, 0xFF, 0xFF, 0x00, 0x00, 0x00, 0x00, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+                        0xBC, 0xE6, 0xFA, 0xAD, 0xA7, 0x17, 0x9E, 0x84, 0xF3, 0xB9, 0xCA, 0xC2, 0xFC, 0x63, 0x25, 0x51};
+                // a = -3 mod p
+                static const uint8_t a[32] = {
+                        0xFF, 0xFF, 0xFF, 0xFF, 0x00, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+                        0x00, 0x00, 0x00, 0x00, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFC};
+                static const uint8_t gx[32] = {
+                        0x6B, 0x17, 0xD1, 0xF2, 0xE1, 0x2C, 0x42, 0x47, 0xF8, 0xBC, 0xE6, 0xE5, 0x63, 0xA4, 0x40, 0xF2,
+                        0x77, 0x03, 0x7D, 0x81, 0x2D, 0xEB, 0x33, 0xA0, 0xF4, 0xA1, 0x39, 0x45, 0xD8, 0x98, 0xC2, 0x96};
+                static const uint8_t gy[32] = {
+                        0x4F, 0xE3, 0x42, 0xE2, 0xFE, 0x1A, 0x7F, 0x9B, 0x8E, 0xE7, 0xEB, 0x4A, 0x7C, 0x0F, 0x9E, 0x16,
+                        0x2B, 0xCE, 0x33, 0x57, 0x6B, 0x31, 0x5E, 0xCE, 0xCB, 0xB6, 0x40, 0x68, 0x37, 0xBF, 0x51, 0xF5};
+                static const uint8_t b[32] = {
+                        0x5A, 0xC6, 0x35, 0xD8, 0xAA, 0x3A, 0x93, 0xE7, 0xB3, 0xEB, 0xBD, 0x55, 0x76, 0x98, 0x86, 0xBC,
+                        0x65, 0x1D, 0x06, 0xB0, 0xCC, 0x53, 0xB0, 0xF6, 0x3B, 0xCE, 0x3C, 0x3E, 0x27, 0xD2, 0x60, 0x4B};
+                curve_setup(&curve_secp256r1, "Nist256p1 seed", p, n, a, b, gx, gy);
+            }
+            return &curve_secp256r1;
+        default:
+            return NULL;
+    }
+}
+
+// k * G with the generator table, k < n
+static void point_mul_generator(affine_point_t *r, const uint64_t k[4], const curve_ctx_t *c) {
+    jacobian_point_t acc;
+    MEMZERO(&acc, sizeof(acc));
+    for (uint8_t i = 0; i < GEN_TABLE_WINDOWS; i++) {
+        const uint8_t nibble = (uint8_t) ((k[i / 16] >> (4u * (i % 16))) & 0x0Fu);
+        if (nibble != 0) {
+            point_add_mixed(&acc, &acc, &c->table[i][nibble], c);
+        }
+    }
+    point_to_affine(r, &acc, c);
+}
+
+// Parse a private key, it must be in [1, n)
+static bool scalar_from_be(uint64_t k[4], const uint8_t in[32], const curve_ctx_t *c) {
+    u256_from_be(k, in);
+    return !u256_is_zero(k) && u256_lt(k, c->n.m);
+}
+
+static void public_key_serialize(uint8_t *out, const affine_point_t *p, const curve_ctx_t *c, bool compressed) {
+    uint64_t x[4], y[4];
+    mont_from(x, p->x, &c->p);
+    mont_from(y, p->y, &c->p);
+    if (compressed) {
+        out[0] = (uint8_t) (0x02u | (y[0] & 1u));
+        u256_to_be(out + 1, x);
+        return;
+    }
+    out[0] = 0x04;
+    u256_to_be(out + 1, x);
+    u256_to_be(out + 33, y);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// BIP32
+
+static uint8_t host_seed[CRYPTO_HOST_SEED_SIZE];
+static uint16_t host_seedLen = 0;
+
+void crypto_host_setSeed(const uint8_t *seed, uint16_t seedLen) {
+    MEMZERO(host_seed, sizeof(host_seed));
+    if (seedLen > sizeof(host_seed)) {
+        seedLen = sizeof(host_seed);
+    }
+    MEMCPY(host_seed, seed, seedLen);
+    host_seedLen = seedLen;
+    // cached public keys belong to the previous seed
+    crypto_pubkeyCacheClear();
+}
+
+void crypto_host_setMnemonic(const char *mnemonic) {
+    // BIP39: PBKDF2-HMAC-SHA512(mnemonic, "mnemonic", 2048)
+    const uint8_t salt[] = {'m', 'n', 'e', 'm', 'o', 'n', 'i', 'c', 0, 0, 0, 1};
+    uint8_t u[64];
+    uint8_t t[64];
+
+    hmac_sha512((const uint8_t *) mnemonic, strlen(mnemonic), salt, sizeof(salt), u);
+    MEMCPY(t, u, sizeof(t));
+    for (uint16_t i = 1; i < 2048; i++) {
+        hmac_sha512((const uint8_t *) mnemonic, strlen(mnemonic), u, sizeof(u), u);
+        for (uint8_t j = 0; j < sizeof(t); j++) {
+            t[j] ^= u[j];
+        }
+    }
+
+    crypto_host_setSeed(t, sizeof(t));
+    MEMZERO(u, sizeof(u));
+    MEMZERO(t, sizeof(t));
+}
+
+void crypto_host_init(void) {
+    if (host_seedLen == 0) {
+        crypto_host_setMnemonic(CRYPTO_HOST_DEFAULT_MNEMONIC);
+    }
+    get_curve(CURVE_SECP256K1);
+    get_curve(CURVE_SECP256R1);
+}
+
+zxerr_t crypto_host_deriveNodeBip32(curve_e curve, const uint32_t *path, uint8_t pathLen, uint8_t privateKey[32]) {
+    MEMZERO(privateKey, 32);
+    const curve_ctx_t *c = get_curve(curve);
+    if (c == NULL) {
+        return zxerr_invalid_crypto_settings;
+    }
+    if (host_seedLen == 0) {
+        crypto_host_setMnemonic(CRYPTO_HOST_DEFAULT_MNEMONIC);
+    }
+
+    uint8_t I[64];
+    uint64_t k[4];
+
+    // Master node, SLIP-10 retries with I as the new input when IL is not a valid key
+    hmac_sha512((const uint8_t *) c->seedKey, strlen(c->seedKey), host_seed, host_seedLen, I);
+    while (!scalar_from_be(k, I, c)) {
+        hmac_sha512((const uint8_t *) c->seedKey, strlen(c->seedKey), I, sizeof(I), I);
+    }
+    uint8_t chainCode[32];
+    MEMCPY(chainCode, I + 32, sizeof(chainCode));
+
+    uint8_t data[1 + 32 + 4];
+    for (uint8_t depth = 0; depth < pathLen; depth++) {
+        const uint32_t index = path[depth];
+        if (index & 0x80000000u) {
+            data[0] = 0;
+            u256_to_be(data + 1, k);
+        } else {
+            affine_point_t pub;
+            point_mul_generator(&pub, k, c);
+            public_key_serialize(data, &pub, c, true);
+        }
+        data[33] = (uint8_t) (index >> 24u);
+        data[34] = (uint8_t) (index >> 16u);
+        data[35] = (uint8_t) (index >> 8u);
+        data[36] = (uint8_t) index;
+
+        while (1) {
+            hmac_sha512(chainCode, sizeof(chainCode), data, sizeof(data), I);
+
+            // child = IL + k mod n, IL must be below n and child not 0
+            uint64_t il[4], child[4];
+            u256_from_be(il, I);
+            if (u256_lt(il, c->n.m)) {
+                const uint64_t carry = u256_add(child, il, k);
+                uint64_t reduced[4];
+                const uint64_t borrow = u256_sub(reduced, child, c->n.m);
+                if (carry || !borrow) {
+                    MEMCPY(child, reduced, sizeof(reduced));
+                }
+                if (!u256_is_zero(child)) {
+                    MEMCPY(k, child, sizeof(child));
+                    break;
+                }
+            }
+            // SLIP-10: retry with 0x01 || IR || index
+            data[0] = 0x01;
+            MEMCPY(data + 1, I + 32, 32);
+        }
+        MEMCPY(chainCode, I + 32, sizeof(chainCode));
+    }
+
+    u256_to_be(privateKey, k);
+    MEMZERO(k, sizeof(k));
+    MEMZERO(I, sizeof(I));
+    MEMZERO(data, sizeof(data));
+    MEMZERO(chainCode, sizeof(chainCode));
+    return zxerr_ok;
+}
+
+zxerr_t crypto_host_publicKey(curve_e curve, const uint8_t privateKey[32], uint8_t publicKey[65]) {
+    MEMZERO(publicKey, 65);
+    const curve_ctx_t *c = get_curve(curve);
+    if (c == NULL) {
+        return zxerr_invalid_crypto_settings;
+    }
+
+    uint64_t k[4];
+    if (!scalar_from_be(k, privateKey, c)) {
+        return zxerr_invalid_crypto_settings;
+    }
+
+    affine_point_t pub;
+    point_mul_generator(&pub, k, c);
+    public_key_serialize(publicKey, &pub, c, false);
+    MEMZERO(k, sizeof(k));
+    return zxerr_ok;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// ECDSA
+
+// DER INTEGER of a 32 byte big endian value, returns the bytes written
+static uint8_t der_integer(uint8_t *out, const uint8_t value[32]) {
+    uint8_t start = 0;
+    while (start < 31 && value[start] == 0) {
+        start++;
+    }
+    const uint8_t pad = (value[start] & 0x80u) ? 1 : 0;
+    const uint8_t len = (uint8_t) (32 - start + pad);
+
+    out[0] = 0x02;
+    out[1] = len;
+    out[2] = 0;
+    MEMCPY(out + 2 + pad, value + start, 32 - start);
+    return (uint8_t) (2 + len);
+}
+
+// RFC6979 section 3.2 with HMAC-SHA256, h1 is already reduced mod n
+typedef struct {
+    uint8_t V[32];
+    uint8_t K[32];
+} rfc6979_ctx_t;
+
+static void rfc6979_init(rfc6979_ctx_t *ctx, const uint8_t x[32], const uint8_t h1[32]) {
+    uint8_t buffer[32 + 1 + 32 + 32];
+    MEMSET(ctx->V, 0x01, sizeof(ctx->V));
+    MEMSET(ctx->K, 0x00, sizeof(ctx->K));
+
+    for (uint8_t round = 0; round < 2; round++) {
+        MEMCPY(buffer, ctx->V, 32);
+        buffer[32] = round;
+        MEMCPY(buffer + 33, x, 32);
+        MEMCPY(buffer + 65, h1, 32);
+        hmac_sha256(ctx->K, buffer, sizeof(buffer), ctx->K);
+        hmac_sha256(ctx->K, ctx->V, sizeof(ctx->V), ctx->V);
+    }
+    MEMZERO(buffer, sizeof(buffer));
+}
+
+static void rfc6979_next(rfc6979_ctx_t *ctx, uint64_t k[4], const curve_ctx_t *c) {
+    while (1) {
+        hmac_sha256(ctx->K, ctx->V, sizeof(ctx->V), ctx->V);
+        if (scalar_from_be(k, ctx->V, c)) {
+            return;
+        }
+        uint8_t buffer[33];
+        MEMCPY(buffer, ctx->V, 32);
+        buffer[32] = 0;
+        hmac_sha256(ctx->K, buffer, sizeof(buffer), ctx->K);
+        hmac_sha256(ctx->K, ctx->V, sizeof(ctx->V), ctx->V);
+    }
+}
+
+zxerr_t crypto_host_ecdsaSign(curve_e curve, const uint8_t privateKey[32], const uint8_t digest[32],
+                              uint8_t *der, uint16_t derMaxLen, uint16_t *derLen, unsigned int *info) {
+    *derLen = 0;
+    *info = 0;
+    const curve_ctx_t *c = get_curve(curve);
+    if (c == NULL) {
+        return zxerr_invalid_crypto_settings;
+    }
+    if (derMaxLen < 2 + 2 * (2 + 33)) {
+        return zxerr_buffer_too_small;
+    }
+
+    uint64_t d[4];
+    if (!scalar_from_be(d, privateKey, c)) {
+        return zxerr_invalid_crypto_settings;
+    }
+
+    const mont_t *n = &c->n;
+    uint64_t e[4];
+    u256_from_be(e, digest);
+    mod_reduce_once(e, e, n);
+
+    uint8_t h1[32];
+    u256_to_be(h1, e);
+    rfc6979_ctx_t drbg;
+    rfc6979_init(&drbg, privateKey, h1);
+
+    uint64_t k[4], r[4], s[4];
+    while (1) {
+        rfc6979_next(&drbg, k, c);
+
+        affine_point_t R;
+        point_mul_generator(&R, k, c);
+        uint64_t rx[4], ry[4];
+        mont_from(rx, R.x, &c->p);
+        mont_from(ry, R.y, &c->p);
+
+        mod_reduce_once(r, rx, n);
+        if (u256_is_zero(r)) {
+            continue;
+        }
+
+        // s = k^-1 * (e + r * d) mod n
+        uint64_t km[4], rm[4], dm[4], em[4], tmp[4];
+        mont_to(km, k, n);
+        mont_to(rm, r, n);
+        mont_to(dm, d, n);
+        mont_to(em, e, n);
+        mont_mul(tmp, rm, dm, n);
+        mod_add(tmp, tmp, em, n);
+        mont_inv(km, km, n);
+        mont_mul(tmp, tmp, km, n);
+        mont_from(s, tmp, n);
+        MEMZERO(km, sizeof(km));
+        MEMZERO(dm, sizeof(dm));
+        if (u256_is_zero(s)) {
+            continue;
+        }
+
+        if (ry[0] & 1u) {
+            *info |= CX_ECCINFO_PARITY_ODD;
+        }
+        if (!u256_eq(r, rx)) {
+            *info |= CX_ECCINFO_xGTn;
+        }
+        break;
+    }
+
+    uint8_t rBytes[32], sBytes[32];
+    u256_to_be(rBytes, r);
+    u256_to_be(sBytes, s);
+
+    uint8_t len = 2;
+    len += der_integer(der + len, rBytes);
+    len += der_integer(der + len, sBytes);
+    der[0] = 0x30;
+    der[1] = (uint8_t) (len - 2);
+    *derLen = len;
+
+    MEMZERO(d, sizeof(d));
+    MEMZERO(k, sizeof(k));
+    MEMZERO(&drbg, sizeof(drbg));
+    return zxerr_ok;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// ECDSA verification
+//
+// R' = (e / s) * G + (r / s) * Q. G goes through the comb table, Q through a width 5 wNAF on odd multiples
+// of Q that are built once per distinct key of a chunk. On secp256k1 r / s is split into two ~128 bit
+// halves for Q and lambda * Q (GLV), which halves the doublings. s and the Z of every R' are inverted with
+// one field inversion per chunk.
+
+#define VERIFY_CHUNK        64
+#define WNAF_WINDOW         5
+#define WNAF_TABLE_SIZE     (1u << (WNAF_WINDOW - 2u))
+#define WNAF_MAX_LEN        258
+#define BATCH_INVERT_MAX    (VERIFY_CHUNK * WNAF_TABLE_SIZE)
+
+typedef struct {
+    // Q, 3Q, ..., 15Q and lambda times the same points
+    affine_point_t odd[WNAF_TABLE_SIZE];
+    affine_point_t oddLambda[WNAF_TABLE_SIZE];
+} key_table_t;
+
+// round(2^384 * b2 / n) and round(2^384 * -b1 / n), -b1 and -b2 mod n for the secp256k1 lattice basis
+static const uint64_t glv_g1[4] = {0xe893209a45dbb031, 0x3daa8a1471e8ca7f, 0xe86c90e49284eb15, 0x3086d221a7d46bcd};
+static const uint64_t glv_g2[4] = {0x1571b4ae8ac47f71, 0x221208ac9df506c6, 0x6f547fa90abfe4c4, 0xe4437ed6010e8828};
+static const uint64_t glv_minusB1[4] = {0x6f547fa90abfe4c3, 0xe4437ed6010e8828, 0, 0};
+static const uint64_t glv_minusB2[4] = {0xd765cda83db1562c, 0x8a280ac50774346d, 0xfffffffffffffffe, 0xffffffffffffffff};
+
+// r = a * b, 512 bits
+static void u256_mul_wide(uint64_t r[8], const uint64_t a[4], const uint64_t b[4]) {
+    MEMZERO(r, 8 * sizeof(uint64_t));
+    for (uint8_t i = 0; i < 4; i++) {
+        uint128_t c = 0;
+        for (uint8_t j = 0; j < 4; j++) {
+            c += (uint128_t) a[i] * b[j] + r[i + j];
+            r[i + j] = (uint64_t) c;
+            c >>= 64u;
+        }
+        r[i + 4] = (uint64_t) c;
+    }
+}
+
+// Inverts values in Montgomery form with a single inversion, zeros are left as they are
+static void batch_invert(uint64_t (*values)[4], size_t count, const mont_t *m) {
+    static uint64_t prefix[BATCH_INVERT_MAX][4];
+    if (count == 0 || count > BATCH_INVERT_MAX) {
+        return;
+    }
+
+    uint64_t acc[4];
+    MEMCPY(acc, m->one, sizeof(acc));
+    for (size_t i = 0; i < count; i++) {
+        MEMCPY(prefix[i], acc, sizeof(acc));
+        if (!u256_is_zero(values[i])) {
+            mont_mul(acc, acc, values[i], m);
+        }
+    }
+
+    uint64_t inv[4], tmp[4];
+    mont_inv(inv, acc, m);
+    for (size_t i = count; i-- > 0;) {
+        if (u256_is_zero(values[i])) {
+            continue;
+        }
+        mont_mul(tmp, inv, prefix[i], m);
+        mont_mul(inv, inv, values[i], m);
+        MEMCPY(values[i], tmp, sizeof(tmp));
+    }
+}
+
+// Points at infinity are skipped, their output is left untouched
+static void batch_to_affine(affine_point_t *out, const jacobian_point_t *in, size_t count, const curve_ctx_t *c) {
+    static uint64_t zinv[BATCH_INVERT_MAX][4];
+    if (count > BATCH_INVERT_MAX) {
+        return;
+    }
+    for (size_t i = 0; i < count; i++) {
+        MEMCPY(zinv[i], in[i].z, sizeof(zinv[i]));
+    }
+    batch_invert(zinv, count, &c->p);
+
+    for (size_t i = 0; i < count; i++) {
+        if (point_is_infinity(&in[i])) {
+            continue;
+        }
+        uint64_t zinv2[4];
+        mont_sqr(zinv2, zinv[i], &c->p);
+        mont_mul(out[i].x, in[i].x, zinv2, &c->p);
+        mont_mul(zinv2, zinv2, zinv[i], &c->p);
+        mont_mul(out[i].y, in[i].y, zinv2, &c->p);
+    }
+}
+
+// Uncompressed key, both coordinates below p and on the curve (both curves have prime order)
+static bool public_key_parse(affine_point_t *q, const uint8_t *in, const curve_ctx_t *c) {
+    if (in == NULL || in[0] != 0x04) {
+        return false;
+    }
+    const mont_t *f = &c->p;
+    uint64_t x[4], y[4];
+    u256_from_be(x, in + 1);
+    u256_from_be(y, in + 33);
+    if (!u256_lt(x, f->m) || !u256_lt(y, f->m)) {
+        return false;
+    }
+    mont_to(q->x, x, f);
+    mont_to(q->y, y, f);
+
+    // y^2 = x^3 + ax + b
+    uint64_t lhs[4], rhs[4], tmp[4];
+    mont_sqr(lhs, q->y, f);
+    mont_sqr(rhs, q->x, f);
+    mont_mul(rhs, rhs, q->x, f);
+    mont_mul(tmp, c->a, q->x, f);
+    mod_add(rhs, rhs, tmp, f);
+    mod_add(rhs, rhs, c->b, f);
+    return u256_eq(lhs, rhs);
+}
+
+static void key_tables_build(key_table_t *tables, const affine_point_t *keys, uint8_t keyCount,
+                             const curve_ctx_t *c) {
+    static jacobian_point_t jac[BATCH_INVERT_MAX];
+    static affine_point_t twice[VERIFY_CHUNK];
+
+    for (uint8_t k = 0; k < keyCount; k++) {
+        MEMCPY(jac[k].x, keys[k].x, sizeof(jac[k].x));
+        MEMCPY(jac[k].y, keys[k].y, sizeof(jac[k].y));
+        MEMCPY(jac[k].z, c->p.one, sizeof(jac[k].z));
+        point_double(&jac[k], &jac[k], c);
+    }
+    batch_to_affine(twice, jac, keyCount, c);
+
+    for (uint8_t k = 0; k < keyCount; k++) {
+        jacobian_point_t *row = &jac[k * WNAF_TABLE_SIZE];
+        MEMCPY(row[0].x, keys[k].x, sizeof(row[0].x));
+        MEMCPY(row[0].y, keys[k].y, sizeof(row[0].y));
+        MEMCPY(row[0].z, c->p.one, sizeof(row[0].z));
+        for (uint8_t j = 1; j < WNAF_TABLE_SIZE; j++) {
+            point_add_mixed(&row[j], &row[j - 1], &twice[k], c);
+        }
+    }
+
+    static affine_point_t odd[BATCH_INVERT_MAX];
+    batch_to_affine(odd, jac, (size_t) keyCount * WNAF_TABLE_SIZE, c);
+    for (uint8_t k = 0; k < keyCount; k++) {
+        for (uint8_t j = 0; j < WNAF_TABLE_SIZE; j++) {
+            tables[k].odd[j] = odd[k * WNAF_TABLE_SIZE + j];
+            if (c->glv) {
+                mont_mul(tables[k].oddLambda[j].x, tables[k].odd[j].x, c->beta, &c->p);
+                MEMCPY(tables[k].oddLambda[j].y, tables[k].odd[j].y, sizeof(tables[k].odd[j].y));
+            }
+        }
+    }
+}
+
+// round(k * g / 2^384)
+static void glv_round(uint64_t r[4], const uint64_t k[4], const uint64_t g[4]) {
+    uint64_t wide[8];
+    u256_mul_wide(wide, k, g);
+    r[0] = wide[6];
+    r[1] = wide[7];
+    r[2] = 0;
+    r[3] = 0;
+    if (wide[5] >> 63u) {
+        r[0]++;
+        r[1] += r[0] == 0;
+    }
+}
+
+// k = k1 + k2 * lambda mod n with |k1|, |k2| < 2^128, the signs are returned apart
+static void glv_split(uint64_t k1[4], bool *neg1, uint64_t k2[4], bool *neg2, const uint64_t k[4],
+                      const curve_ctx_t *c) {
+    const mont_t *n = &c->n;
+    uint64_t c1[4], c2[4], t[4], u[4];
+    glv_round(c1, k, glv_g1);
+    glv_round(c2, k, glv_g2);
+
+    // multiplying a plain value by one in Montgomery form gives the plain product
+    mont_to(t, glv_minusB1, n);
+    mont_mul(t, c1, t, n);
+    mont_to(u, glv_minusB2, n);
+    mont_mul(u, c2, u, n);
+    mod_add(k2, t, u, n);
+
+    mont_mul(t, k2, c->lambda, n);
+    mod_sub(k1, k, t, n);
+
+    *neg1 = (k1[2] | k1[3]) != 0;
+    if (*neg1) {
+        u256_sub(k1, n->m, k1);
+    }
+    *neg2 = (k2[2] | k2[3]) != 0;
+    if (*neg2) {
+        u256_sub(k2, n->m, k2);
+    }
+}
+
+// Width 5 non adjacent form, digits are 0 or odd in [-15, 15]
+static uint16_t wnaf_encode(int8_t naf[WNAF_MAX_LEN], const uint64_t k[4]) {
+    uint64_t t[5] = {k[0], k[1], k[2], k[3], 0};
+    uint16_t len = 0;
+    while ((t[0] | t[1] | t[2] | t[3] | t[4]) != 0) {
+        int8_t digit = 0;
+        if (t[0] & 1u) {
+            digit = (int8_t) (t[0] & ((1u << WNAF_WINDOW) - 1u));
+            if (digit >= (1 << (WNAF_WINDOW - 1u))) {
+                digit = (int8_t) (digit - (1 << WNAF_WINDOW));
+            }
+            if (digit > 0) {
+                t[0] -= (uint64_t) digit;
+            } else {
+                uint128_t carry = (uint64_t) -digit;
+                for (uint8_t i = 0; i < 5 && carry != 0; i++) {
+                    carry += t[i];
+                    t[i] = (uint64_t) carry;
+                    carry >>= 64u;
+                }
+            }
+        }
+        naf[len++] = digit;
+        for (uint8_t i = 0; i < 4; i++) {
+            t[i] = (t[i] >> 1u) | (t[i + 1] << 63u);
+        }
+        t[4] >>= 1u;
+    }
+    return len;
+}
+
+static void point_add_digit(jacobian_point_t *acc, const affine_point_t *table, int8_t digit, bool negate,
+                            const curve_ctx_t *c) {
+    const affine_point_t *q = &table[((digit < 0 ? -digit : digit) - 1) / 2];
+    if ((digit < 0) == negate) {
+        point_add_mixed(acc, acc, q, c);
+        return;
+    }
+    affine_point_t neg;
+    const uint64_t zero[4] = {0};
+    MEMCPY(neg.x, q->x, sizeof(neg.x));
+    mod_sub(neg.y, zero, q->y, &c->p);
+    point_add_mixed(acc, acc, &neg, c);
+}
+
+// u1 * G + u2 * Q
+static void point_mul_verify(jacobian_point_t *acc, const uint64_t u1[4], const uint64_t u2[4],
+                             const key_table_t *table, const curve_ctx_t *c) {
+    int8_t naf1[WNAF_MAX_LEN], naf2[WNAF_MAX_LEN];
+    uint16_t len1, len2 = 0;
+    bool neg1 = false, neg2 = false;
+
+    if (c->glv) {
+        uint64_t k1[4], k2[4];
+        glv_split(k1, &neg1, k2, &neg2, u2, c);
+        len1 = wnaf_encode(naf1, k1);
+        len2 = wnaf_encode(naf2, k2);
+    } else {
+        len1 = wnaf_encode(naf1, u2);
+    }
+
+    MEMZERO(acc, sizeof(*acc));
+    for (int16_t i = (int16_t) (len1 > len2 ? len1 : len2) - 1; i >= 0; i--) {
+        point_double(acc, acc, c);
+        if (i < len1 && naf1[i] != 0) {
+            point_add_digit(acc, table->odd, naf1[i], neg1, c);
+        }
+        if (i < len2 && naf2[i] != 0) {
+            point_add_digit(acc, table->oddLambda, naf2[i], neg2, c);
+        }
+    }
+
+    for (uint8_t i = 0; i < GEN_TABLE_WINDOWS; i++) {
+        const uint8_t nibble = (uint8_t) ((u1[i / 16] >> (4u * (i % 16))) & 0x0Fu);
+        if (nibble != 0) {
+            point_add_mixed(acc, acc, &c->table[i][nibble], c);
+        }
+    }
+}
+
+static size_t verify_chunk(const curve_ctx_t *c, const crypto_host_verify_item_t *items, size_t count,
+                           crypto_verify_result_e *results) {
+    static key_table_t tables[VERIFY_CHUNK];
+    static jacobian_point_t points[VERIFY_CHUNK];
+    static affine_point_t affine[VERIFY_CHUNK];
+    affine_point_t keys[VERIFY_CHUNK];
+    const uint8_t *keyBytes[VERIFY_CHUNK];
+    uint8_t keyIndex[VERIFY_CHUNK];
+    uint8_t keyCount = 0;
+    uint64_t r[VERIFY_CHUNK][4], e[VERIFY_CHUNK][4], w[VERIFY_CHUNK][4];
+    const mont_t *n = &c->n;
+
+    for (size_t i = 0; i < count; i++) {
+        results[i] = CRYPTO_VERIFY_OK;
+        MEMZERO(w[i], sizeof(w[i]));
+
+        affine_point_t q;
+        if (!public_key_parse(&q, items[i].publicKey, c)) {
+            results[i] = CRYPTO_VERIFY_INVALID_PUBKEY;
+            continue;
+        }
+        uint64_t s[4];
+        if (!scalar_from_be(r[i], items[i].r, c) || !scalar_from_be(s, items[i].s, c)) {
+            results[i] = CRYPTO_VERIFY_INVALID_SIGNATURE;
+            continue;
+        }
+        u256_from_be(e[i], items[i].digest);
+        mod_reduce_once(e[i], e[i], n);
+        mont_to(w[i], s, n);
+
+        uint8_t k = 0;
+        while (k < keyCount && MEMCMP(keyBytes[k], items[i].publicKey, SECP256K1_PK_LEN) != 0) {
+            k++;
+        }
+        if (k == keyCount) {
+            keyBytes[k] = items[i].publicKey;
+            keys[k] = q;
+            keyCount++;
+        }
+        keyIndex[i] = k;
+    }
+
+    // w = 1 / s, then u1 = e * w and u2 = r * w
+    batch_invert(w, count, n);
+    key_tables_build(tables, keys, keyCount, c);
+    for (size_t i = 0; i < count; i++) {
+        MEMZERO(&points[i], sizeof(points[i]));
+        if (results[i] != CRYPTO_VERIFY_OK) {
+            continue;
+        }
+        uint64_t u1[4], u2[4];
+        mont_mul(u1, e[i], w[i], n);
+        mont_mul(u2, r[i], w[i], n);
+        point_mul_verify(&points[i], u1, u2, &tables[keyIndex[i]], c);
+    }
+
+    batch_to_affine(affine, points, count, c);
+
+    size_t valid = 0;
+    for (size_t i = 0; i < count; i++) {
+        if (results[i] != CRYPTO_VERIFY_OK) {
+            continue;
+        }
+        if (point_is_infinity(&points[i])) {
+            results[i] = CRYPTO_VERIFY_FAILED;
+            continue;
+        }
+
+        uint64_t x[4], y[4], xn[4];
+        mont_from(x, affine[i].x, &c->p);
+        mont_from(y, affine[i].y, &c->p);
+        mod_reduce_once(xn, x, n);
+        if (!u256_eq(xn, r[i])) {
+            results[i] = CRYPTO_VERIFY_FAILED;
+            continue;
+        }
+        if (items[i].v != NULL) {
+            uint8_t v = (uint8_t) (y[0] & 1u);
+            if (!u256_eq(xn, x)) {
+                v |= CX_ECCINFO_xGTn;
+            }
+            if (*items[i].v != v) {
+                results[i] = CRYPTO_VERIFY_INVALID_SIGNATURE;
+                continue;
+            }
+        }
+        valid++;
+    }
+    return valid;
+}
+
+size_t crypto_host_ecdsaVerifyBatch(curve_e curve, const crypto_host_verify_item_t *items, size_t count,
+                                    crypto_verify_result_e *results) {
+    const curve_ctx_t *c = get_curve(curve);
+    if (c == NULL) {
+        for (size_t i = 0; i < count; i++) {
+            results[i] = CRYPTO_VERIFY_INVALID_SCHEME;
+        }
+        return 0;
+    }
+
+    size_t valid = 0;
+    for (size_t start = 0; start < count; start += VERIFY_CHUNK) {
+        const size_t chunk = count - start < VERIFY_CHUNK ? count - start : VERIFY_CHUNK;
+        valid += verify_chunk(c, items + start, chunk, results + start);
+    }
+    return valid;
+}
+
+#endif
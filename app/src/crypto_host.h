@@ -0,0 +1,77 @@
+/*******************************************************************************
+*   (c) 2021 Zondax GmbH
+*
+*  Licensed under the Apache License, Version 2.0 (the "License");
+*  you may not use this file except in compliance with the License.
+*  You may obtain a copy of the License at
+*
+*      http://www.apache.org/licenses/LICENSE-2.0
+*
+*  Unless required by applicable law or agreed to in writing, software
+*  distributed under the License is distributed on an "AS IS" BASIS,
+*  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+*  See the License for the specific language governing permissions and
+*  limitations under the License.
+********************************************************************************/
+#pragma once
+
+// Host replacement for the BOLOS key derivation and ECDSA services used by crypto.c
+// Keys are derived from a test seed: this is for tests and benchmarks, it is not constant time
+
+#if !defined(TARGET_NANOS) && !defined(TARGET_NANOX) && !defined(TARGET_NANOS2)
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+#include <stddef.h>
+#include <zxerror.h>
+#include "crypto.h"
+
+// Mnemonic of the Zemu test device, keys match the ones used by tests_zemu
+#define CRYPTO_HOST_DEFAULT_MNEMONIC "equip will roof matter pink blind book anxiety banner elbow sun young"
+
+#define CRYPTO_HOST_SEED_SIZE 64
+
+// Seed the derivations from a BIP39 mnemonic (no passphrase) or directly from a seed
+void crypto_host_setMnemonic(const char *mnemonic);
+void crypto_host_setSeed(const uint8_t *seed, uint16_t seedLen);
+
+// Build the generator tables of both curves, otherwise they are built on first use
+void crypto_host_init(void);
+
+// BIP32 private key derivation, SLIP-10 master key for secp256r1
+zxerr_t crypto_host_deriveNodeBip32(curve_e curve, const uint32_t *path, uint8_t pathLen, uint8_t privateKey[32]);
+
+// Uncompressed public key (0x04 || X || Y)
+zxerr_t crypto_host_publicKey(curve_e curve, const uint8_t privateKey[32], uint8_t publicKey[65]);
+
+// ECDSA with RFC6979 nonces (HMAC-SHA256), info has the CX_ECCINFO_* flags of R
+zxerr_t crypto_host_ecdsaSign(curve_e curve, const uint8_t privateKey[32], const uint8_t digest[32],
+                              uint8_t *der, uint16_t derMaxLen, uint16_t *derLen, unsigned int *info);
+
+typedef struct {
+    // Uncompressed public key (0x04 || X || Y)
+    const uint8_t *publicKey;
+    const uint8_t *digest;
+    const uint8_t *r;
+    const uint8_t *s;
+    // Optional V byte (CX_ECCINFO_* flags of R), NULL skips the check
+    const uint8_t *v;
+} crypto_host_verify_item_t;
+
+// ECDSA verification of a batch on one curve, results[i] is set for every item.
+// The inverses are shared by the batch, repeated public keys share their window table,
+// and secp256k1 halves the doublings with the GLV endomorphism.
+// Returns the number of valid signatures.
+size_t crypto_host_ecdsaVerifyBatch(curve_e curve, const crypto_host_verify_item_t *items, size_t count,
+                                    crypto_verify_result_e *results);
+
+void crypto_host_sha512(const uint8_t *message, size_t messageLen, uint8_t digest[64]);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
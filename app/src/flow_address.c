@@ -0,0 +1,412 @@
+/*******************************************************************************
+*   (c) 2021 Zondax GmbH
+*
+*  Licensed under the Apache License, Version 2.0 (the "License");
+*  you may not use this file except in compliance with the License.
+*  You may obtain a copy of the License at
+*
+*      http://www.apache.org/licenses/LICENSE-2.0
+*
+*  Unless required by applicable law or agreed to in writing, software
+*  distributed under the License is distributed on an "AS IS" BASIS,
+*  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+*  See the License for the specific language governing permissions and
+*  limitations under the License.
+********************************************************************************/
+
+#include "flow_address.h"
+
+// based on Dapper provided code at https://github.com/onflow/flow-go-sdk/blob/96796f0cabc1847d7879a5230ab55fd3cdd41ae8/address.go#L286
+
+const uint64_t codeword_mainnet = 0;
+const uint64_t codeword_testnet = 0x6834ba37b3980209;
+const uint64_t codeword_emulatornet = 0x1cb159857af02018;
+
+// Rows of the generator matrix G, row i is the codeword of index bit i
+static const uint64_t generatorMatrixRows[FLOW_ADDRESS_LINEAR_CODE_K] = {
+        0xe467b9dd11fa00df, 0xf233dcee88fe0abe, 0xf919ee77447b7497, 0xfc8cf73ba23a260d,
+        0xfe467b9dd11ee2a1, 0xff233dcee888d807, 0xff919ee774476ce6, 0x7fc8cf73ba231d10,
+        0x3fe467b9dd11b183, 0x1ff233dcee8f96d6, 0x8ff919ee774757ba, 0x47fc8cf73ba2b331,
+        0x23fe467b9dd27f6c, 0x11ff233dceee8e82, 0x88ff919ee775dd8f, 0x447fc8cf73b905e4,
+        0xa23fe467b9de0d83, 0xd11ff233dce8d5a7, 0xe88ff919ee73c38a, 0x7447fc8cf73f171f,
+        0xba23fe467b9dcb2b, 0xdd11ff233dcb0cb4, 0xee88ff919ee26c5d, 0x77447fc8cf775dd3,
+        0x3ba23fe467b9b5a1, 0x9dd11ff233d9117a, 0xcee88ff919efa640, 0xe77447fc8cf3e297,
+        0x73ba23fe467fabd2, 0xb9dd11ff233fb16c, 0xdcee88ff919adde7, 0xee77447fc8ceb196,
+        0xf73ba23fe4621cd0, 0x7b9dd11ff2379ac3, 0x3dcee88ff91df46c, 0x9ee77447fc88e702,
+        0xcf73ba23fe4131b6, 0x67b9dd11ff240f9a, 0x33dcee88ff90f9e0, 0x19ee77447fcff4e3,
+        0x8cf73ba23fe64091, 0x467b9dd11ff115c7, 0x233dcee88ffdb735, 0x919ee77447fe2309,
+        0xc8cf73ba23fdc736,
+};
+
+// syndromeTable[i][b] is the xor of the parity check matrix columns 8*i..8*i+7 selected by the bits of b,
+// so the syndrome of a word is the xor of one entry per byte
+static const uint32_t syndromeTable[8][256] = {
+        {   // byte 0 (bits 0..7)
+            0x00000, 0x00001, 0x00002, 0x00003, 0x00004, 0x00005, 0x00006, 0x00007,
+            0x00008, 0x00009, 0x0000a, 0x0000b, 0x0000c, 0x0000d, 0x0000e, 0x0000f,
+            0x00010, 0x00011, 0x00012, 0x00013, 0x00014, 0x00015, 0x00016, 0x00017,
+            0x00018, 0x00019, 0x0001a, 0x0001b, 0x0001c, 0x0001d, 0x0001e, 0x0001f,
+            0x00020, 0x00021, 0x00022, 0x00023, 0x00024, 0x00025, 0x00026, 0x00027,
+            0x00028, 0x00029, 0x0002a, 0x0002b, 0x0002c, 0x0002d, 0x0002e, 0x0002f,
+            0x00030, 0x00031, 0x00032, 0x00033, 0x00034, 0x00035, 0x00036, 0x00037,
+            0x00038, 0x00039, 0x0003a, 0x0003b, 0x0003c, 0x0003d, 0x0003e, 0x0003f,
+            0x00040, 0x00041, 0x00042, 0x00043, 0x00044, 0x00045, 0x00046, 0x00047,
+            0x00048, 0x00049, 0x0004a, 0x0004b, 0x0004c, 0x0004d, 0x0004e, 0x0004f,
+            0x00050, 0x00051, 0x00052, 0x00053, 0x00054, 0x00055, 0x00056, 0x00057,
+            0x00058, 0x00059, 0x0005a, 0x0005b, 0x0005c, 0x0005d, 0x0005e, 0x0005f,
+            0x00060, 0x00061, 0x00062, 0x00063, 0x00064, 0x00065, 0x00066, 0x00067,
+            0x00068, 0x00069, 0x0006a, 0x0006b, 0x0006c, 0x0006d, 0x0006e, 0x0006f,
+            0x00070, 0x00071, 0x00072, 0x00073, 0x00074, 0x00075, 0x00076, 0x00077,
+            0x00078, 0x00079, 0x0007a, 0x0007b, 0x0007c, 0x0007d, 0x0007e, 0x0007f,
+            0x00080, 0x00081, 0x00082, 0x00083, 0x00084, 0x00085, 0x00086, 0x00087,
+            0x00088, 0x00089, 0x0008a, 0x0008b, 0x0008c, 0x0008d, 0x0008e, 0x0008f,
+            0x00090, 0x00091, 0x00092, 0x00093, 0x00094, 0x00095, 0x00096, 0x00097,
+            0x00098, 0x00099, 0x0009a, 0x0009b, 0x0009c, 0x0009d, 0x0009e, 0x0009f,
+            0x000a0, 0x000a1, 0x000a2, 0x000a3, 0x000a4, 0x000a5, 0x000a6, 0x000a7,
+            0x000a8, 0x000a9, 0x000aa, 0x000ab, 0x000ac, 0x000ad, 0x000ae, 0x000af,
+            0x000b0, 0x000b1, 0x000b2, 0x000b3, 0x000b4, 0x000b5, 0x000b6, 0x000b7,
+            0x000b8, 0x000b9, 0x000ba, 0x000bb, 0x000bc, 0x000bd, 0x000be, 0x000bf,
+            0x000c0, 0x000c1, 0x000c2, 0x000c3, 0x000c4, 0x000c5, 0x000c6, 0x000c7,
+            0x000c8, 0x000c9, 0x000ca, 0x000cb, 0x000cc, 0x000cd, 0x000ce, 0x000cf,
+            0x000d0, 0x000d1, 0x000d2, 0x000d3, 0x000d4, 0x000d5, 0x000d6, 0x000d7,
+            0x000d8, 0x000d9, 0x000da, 0x000db, 0x000dc, 0x000dd, 0x000de, 0x000df,
+            0x000e0, 0x000e1, 0x000e2, 0x000e3, 0x000e4, 0x000e5, 0x000e6, 0x000e7,
+            0x000e8, 0x000e9, 0x000ea, 0x000eb, 0x000ec, 0x000ed, 0x000ee, 0x000ef,
+            0x000f0, 0x000f1, 0x000f2, 0x000f3, 0x000f4, 0x000f5, 0x000f6, 0x000f7,
+            0x000f8, 0x000f9, 0x000fa, 0x000fb, 0x000fc, 0x000fd, 0x000fe, 0x000ff,
+        },
+        {   // byte 1 (bits 8..15)
+            0x00000, 0x00100, 0x00200, 0x00300, 0x00400, 0x00500, 0x00600, 0x00700,
+            0x00800, 0x00900, 0x00a00, 0x00b00, 0x00c00, 0x00d00, 0x00e00, 0x00f00,
+            0x01000, 0x01100, 0x01200, 0x01300, 0x01400, 0x01500, 0x01600, 0x01700,
+            0x01800, 0x01900, 0x01a00, 0x01b00, 0x01c00, 0x01d00, 0x01e00, 0x01f00,
+            0x02000, 0x02100, 0x02200, 0x02300, 0x02400, 0x02500, 0x02600, 0x02700,
+            0x02800, 0x02900, 0x02a00, 0x02b00, 0x02c00, 0x02d00, 0x02e00, 0x02f00,
+            0x03000, 0x03100, 0x03200, 0x03300, 0x03400, 0x03500, 0x03600, 0x03700,
+            0x03800, 0x03900, 0x03a00, 0x03b00, 0x03c00, 0x03d00, 0x03e00, 0x03f00,
+            0x04000, 0x04100, 0x04200, 0x04300, 0x04400, 0x04500, 0x04600, 0x04700,
+            0x04800, 0x04900, 0x04a00, 0x04b00, 0x04c00, 0x04d00, 0x04e00, 0x04f00,
+            0x05000, 0x05100, 0x05200, 0x05300, 0x05400, 0x05500, 0x05600, 0x05700,
+            0x05800, 0x05900, 0x05a00, 0x05b00, 0x05c00, 0x05d00, 0x05e00, 0x05f00,
+            0x06000, 0x06100, 0x06200, 0x06300, 0x06400, 0x06500, 0x06600, 0x06700,
+            0x06800, 0x06900, 0x06a00, 0x06b00, 0x06c00, 0x06d00, 0x06e00, 0x06f00,
+            0x07000, 0x07100, 0x07200, 0x07300, 0x07400, 0x07500, 0x07600, 0x07700,
+            0x07800, 0x07900, 0x07a00, 0x07b00, 0x07c00, 0x07d00, 0x07e00, 0x07f00,
+            0x08000, 0x08100, 0x08200, 0x08300, 0x08400, 0x08500, 0x08600, 0x08700,
+            0x08800, 0x08900, 0x08a00, 0x08b00, 0x08c00, 0x08d00, 0x08e00, 0x08f00,
+            0x09000, 0x09100, 0x09200, 0x09300, 0x09400, 0x09500, 0x09600, 0x09700,
+            0x09800, 0x09900, 0x09a00, 0x09b00, 0x09c00, 0x09d00, 0x09e00, 0x09f00,
+            0x0a000, 0x0a100, 0x0a200, 0x0a300, 0x0a400, 0x0a500, 0x0a600, 0x0a700,
+            0x0a800, 0x0a900, 0x0aa00, 0x0ab00, 0x0ac00, 0x0ad00, 0x0ae00, 0x0af00,
+            0x0b000, 0x0b100, 0x0b200, 0x0b300, 0x0b400, 0x0b500, 0x0b600, 0x0b700,
+            0x0b800, 0x0b900, 0x0ba00, 0x0bb00, 0x0bc00, 0x0bd00, 0x0be00, 0x0bf00,
+            0x0c000, 0x0c100, 0x0c200, 0x0c300, 0x0c400, 0x0c500, 0x0c600, 0x0c700,
+            0x0c800, 0x0c900, 0x0ca00, 0x0cb00, 0x0cc00, 0x0cd00, 0x0ce00, 0x0cf00,
+            0x0d000, 0x0d100, 0x0d200, 0x0d300, 0x0d400, 0x0d500, 0x0d600, 0x0d700,
+            0x0d800, 0x0d900, 0x0da00, 0x0db00, 0x0dc00, 0x0dd00, 0x0de00, 0x0df00,
+            0x0e000, 0x0e100, 0x0e200, 0x0e300, 0x0e400, 0x0e500, 0x0e600, 0x0e700,
+            0x0e800, 0x0e900, 0x0ea00, 0x0eb00, 0x0ec00, 0x0ed00, 0x0ee00, 0x0ef00,
+            0x0f000, 0x0f100, 0x0f200, 0x0f300, 0x0f400, 0x0f500, 0x0f600, 0x0f700,
+            0x0f800, 0x0f900, 0x0fa00, 0x0fb00, 0x0fc00, 0x0fd00, 0x0fe00, 0x0ff00,
+        },
+        {   // byte 2 (bits 16..23)
+            0x00000, 0x10000, 0x20000, 0x30000, 0x40000, 0x50000, 0x60000, 0x70000,
+            0x7328d, 0x6328d, 0x5328d, 0x4328d, 0x3328d, 0x2328d, 0x1328d, 0x0328d,
+            0x6689a, 0x7689a, 0x4689a, 0x5689a, 0x2689a, 0x3689a, 0x0689a, 0x1689a,
+            0x15a17, 0x05a17, 0x35a17, 0x25a17, 0x55a17, 0x45a17, 0x75a17, 0x65a17,
+            0x6112f, 0x7112f, 0x4112f, 0x5112f, 0x2112f, 0x3112f, 0x0112f, 0x1112f,
+            0x123a2, 0x023a2, 0x323a2, 0x223a2, 0x523a2, 0x423a2, 0x723a2, 0x623a2,
+            0x079b5, 0x179b5, 0x279b5, 0x379b5, 0x479b5, 0x579b5, 0x679b5, 0x779b5,
+            0x74b38, 0x64b38, 0x54b38, 0x44b38, 0x34b38, 0x24b38, 0x14b38, 0x04b38,
+            0x6084b, 0x7084b, 0x4084b, 0x5084b, 0x2084b, 0x3084b, 0x0084b, 0x1084b,
+            0x13ac6, 0x03ac6, 0x33ac6, 0x23ac6, 0x53ac6, 0x43ac6, 0x73ac6, 0x63ac6,
+            0x060d1, 0x160d1, 0x260d1, 0x360d1, 0x460d1, 0x560d1, 0x660d1, 0x760d1,
+            0x7525c, 0x6525c, 0x5525c, 0x4525c, 0x3525c, 0x2525c, 0x1525c, 0x0525c,
+            0x01964, 0x11964, 0x21964, 0x31964, 0x41964, 0x51964, 0x61964, 0x71964,
+            0x72be9, 0x62be9, 0x52be9, 0x42be9, 0x32be9, 0x22be9, 0x12be9, 0x02be9,
+            0x671fe, 0x771fe, 0x471fe, 0x571fe, 0x271fe, 0x371fe, 0x071fe, 0x171fe,
+            0x14373, 0x04373, 0x34373, 0x24373, 0x54373, 0x44373, 0x74373, 0x64373,
+            0x433fd, 0x533fd, 0x633fd, 0x733fd, 0x033fd, 0x133fd, 0x233fd, 0x333fd,
+            0x30170, 0x20170, 0x10170, 0x00170, 0x70170, 0x60170, 0x50170, 0x40170,
+            0x25b67, 0x35b67, 0x05b67, 0x15b67, 0x65b67, 0x75b67, 0x45b67, 0x55b67,
+            0x569ea, 0x469ea, 0x769ea, 0x669ea, 0x169ea, 0x069ea, 0x369ea, 0x269ea,
+            0x222d2, 0x322d2, 0x022d2, 0x122d2, 0x622d2, 0x722d2, 0x422d2, 0x522d2,
+            0x5105f, 0x4105f, 0x7105f, 0x6105f, 0x1105f, 0x0105f, 0x3105f, 0x2105f,
+            0x44a48, 0x54a48, 0x64a48, 0x74a48, 0x04a48, 0x14a48, 0x24a48, 0x34a48,
+            0x378c5, 0x278c5, 0x178c5, 0x078c5, 0x778c5, 0x678c5, 0x578c5, 0x478c5,
+            0x23bb6, 0x33bb6, 0x03bb6, 0x13bb6, 0x63bb6, 0x73bb6, 0x43bb6, 0x53bb6,
+            0x5093b, 0x4093b, 0x7093b, 0x6093b, 0x1093b, 0x0093b, 0x3093b, 0x2093b,
+            0x4532c, 0x5532c, 0x6532c, 0x7532c, 0x0532c, 0x1532c, 0x2532c, 0x3532c,
+            0x361a1, 0x261a1, 0x161a1, 0x061a1, 0x761a1, 0x661a1, 0x561a1, 0x461a1,
+            0x42a99, 0x52a99, 0x62a99, 0x72a99, 0x02a99, 0x12a99, 0x22a99, 0x32a99,
+            0x31814, 0x21814, 0x11814, 0x01814, 0x71814, 0x61814, 0x51814, 0x41814,
+            0x24203, 0x34203, 0x04203, 0x14203, 0x64203, 0x74203, 0x44203, 0x54203,
+            0x5708e, 0x4708e, 0x7708e, 0x6708e, 0x1708e, 0x0708e, 0x3708e, 0x2708e,
+        },
+        {   // byte 3 (bits 24..31)
+            0x00000, 0x42aab, 0x41951, 0x033fa, 0x233ce, 0x61965, 0x62a9f, 0x20034,
+            0x22a81, 0x6002a, 0x633d0, 0x2197b, 0x0194f, 0x433e4, 0x4001e, 0x02ab5,
+            0x21948, 0x633e3, 0x60019, 0x22ab2, 0x02a86, 0x4002d, 0x433d7, 0x0197c,
+            0x033c9, 0x41962, 0x42a98, 0x00033, 0x20007, 0x62aac, 0x61956, 0x233fd,
+            0x1ef60, 0x5c5cb, 0x5f631, 0x1dc9a, 0x3dcae, 0x7f605, 0x7c5ff, 0x3ef54,
+            0x3c5e1, 0x7ef4a, 0x7dcb0, 0x3f61b, 0x1f62f, 0x5dc84, 0x5ef7e, 0x1c5d5,
+            0x3f628, 0x7dc83, 0x7ef79, 0x3c5d2, 0x1c5e6, 0x5ef4d, 0x5dcb7, 0x1f61c,
+            0x1dca9, 0x5f602, 0x5c5f8, 0x1ef53, 0x3ef67, 0x7c5cc, 0x7f636, 0x3dc9d,
+            0x1deca, 0x5f461, 0x5c79b, 0x1ed30, 0x3ed04, 0x7c7af, 0x7f455, 0x3defe,
+            0x3f44b, 0x7dee0, 0x7ed1a, 0x3c7b1, 0x1c785, 0x5ed2e, 0x5ded4, 0x1f47f,
+            0x3c782, 0x7ed29, 0x7ded3, 0x3f478, 0x1f44c, 0x5dee7, 0x5ed1d, 0x1c7b6,
+            0x1ed03, 0x5c7a8, 0x5f452, 0x1def9, 0x3decd, 0x7f466, 0x7c79c, 0x3ed37,
+            0x031aa, 0x41b01, 0x428fb, 0x00250, 0x20264, 0x628cf, 0x61b35, 0x2319e,
+            0x21b2b, 0x63180, 0x6027a, 0x228d1, 0x028e5, 0x4024e, 0x431b4, 0x01b1f,
+            0x228e2, 0x60249, 0x631b3, 0x21b18, 0x01b2c, 0x43187, 0x4027d, 0x028d6,
+            0x00263, 0x428c8, 0x41b32, 0x03199, 0x231ad, 0x61b06, 0x628fc, 0x20257,
+            0x1c639, 0x5ec92, 0x5df68, 0x1f5c3, 0x3f5f7, 0x7df5c, 0x7eca6, 0x3c60d,
+            0x3ecb8, 0x7c613, 0x7f5e9, 0x3df42, 0x1df76, 0x5f5dd, 0x5c627, 0x1ec8c,
+            0x3df71, 0x7f5da, 0x7c620, 0x3ec8b, 0x1ecbf, 0x5c614, 0x5f5ee, 0x1df45,
+            0x1f5f0, 0x5df5b, 0x5eca1, 0x1c60a, 0x3c63e, 0x7ec95, 0x7df6f, 0x3f5c4,
+            0x02959, 0x403f2, 0x43008, 0x01aa3, 0x21a97, 0x6303c, 0x603c6, 0x2296d,
+            0x203d8, 0x62973, 0x61a89, 0x23022, 0x03016, 0x41abd, 0x42947, 0x003ec,
+            0x23011, 0x61aba, 0x62940, 0x203eb, 0x003df, 0x42974, 0x41a8e, 0x03025,
+            0x01a90, 0x4303b, 0x403c1, 0x0296a, 0x2295e, 0x603f5, 0x6300f, 0x21aa4,
+            0x018f3, 0x43258, 0x401a2, 0x02b09, 0x22b3d, 0x60196, 0x6326c, 0x218c7,
+            0x23272, 0x618d9, 0x62b23, 0x20188, 0x001bc, 0x42b17, 0x418ed, 0x03246,
+            0x201bb, 0x62b10, 0x618ea, 0x23241, 0x03275, 0x418de, 0x42b24, 0x0018f,
+            0x02b3a, 0x40191, 0x4326b, 0x018c0, 0x218f4, 0x6325f, 0x601a5, 0x22b0e,
+            0x1f793, 0x5dd38, 0x5eec2, 0x1c469, 0x3c45d, 0x7eef6, 0x7dd0c, 0x3f7a7,
+            0x3dd12, 0x7f7b9, 0x7c443, 0x3eee8, 0x1eedc, 0x5c477, 0x5f78d, 0x1dd26,
+            0x3eedb, 0x7c470, 0x7f78a, 0x3dd21, 0x1dd15, 0x5f7be, 0x5c444, 0x1eeef,
+            0x1c45a, 0x5eef1, 0x5dd0b, 0x1f7a0, 0x3f794, 0x7dd3f, 0x7eec5, 0x3c46e,
+        },
+        {   // byte 4 (bits 32..39)
+            0x00000, 0x1bdd8, 0x1a535, 0x018ed, 0x194ac, 0x02974, 0x03199, 0x18c41,
+            0x18c46, 0x0319e, 0x02973, 0x194ab, 0x018ea, 0x1a532, 0x1bddf, 0x00007,
+            0x1632b, 0x0def3, 0x0c61e, 0x17bc6, 0x0f787, 0x14a5f, 0x152b2, 0x0ef6a,
+            0x0ef6d, 0x152b5, 0x14a58, 0x0f780, 0x17bc1, 0x0c619, 0x0def4, 0x1632c,
+            0x1529b, 0x0ef43, 0x0f7ae, 0x14a76, 0x0c637, 0x17bef, 0x16302, 0x0deda,
+            0x0dedd, 0x16305, 0x17be8, 0x0c630, 0x14a71, 0x0f7a9, 0x0ef44, 0x1529c,
+            0x031b0, 0x18c68, 0x19485, 0x0295d, 0x1a51c, 0x018c4, 0x00029, 0x1bdf1,
+            0x1bdf6, 0x0002e, 0x018c3, 0x1a51b, 0x0295a, 0x19482, 0x18c6f, 0x031b7,
+            0x14a43, 0x0f79b, 0x0ef76, 0x152ae, 0x0deef, 0x16337, 0x17bda, 0x0c602,
+            0x0c605, 0x17bdd, 0x16330, 0x0dee8, 0x152a9, 0x0ef71, 0x0f79c, 0x14a44,
+            0x02968, 0x194b0, 0x18c5d, 0x03185, 0x1bdc4, 0x0001c, 0x018f1, 0x1a529,
+            0x1a52e, 0x018f6, 0x0001b, 0x1bdc3, 0x03182, 0x18c5a, 0x194b7, 0x0296f,
+            0x018d8, 0x1a500, 0x1bded, 0x00035, 0x18c74, 0x031ac, 0x02941, 0x19499,
+            0x1949e, 0x02946, 0x031ab, 0x18c73, 0x00032, 0x1bdea, 0x1a507, 0x018df,
+            0x17bf3, 0x0c62b, 0x0dec6, 0x1631e, 0x0ef5f, 0x15287, 0x14a6a, 0x0f7b2,
+            0x0f7b5, 0x14a6d, 0x15280, 0x0ef58, 0x16319, 0x0dec1, 0x0c62c, 0x17bf4,
+            0x13184, 0x08c5c, 0x094b1, 0x12969, 0x0a528, 0x118f0, 0x1001d, 0x0bdc5,
+            0x0bdc2, 0x1001a, 0x118f7, 0x0a52f, 0x1296e, 0x094b6, 0x08c5b, 0x13183,
+            0x052af, 0x1ef77, 0x1f79a, 0x04a42, 0x1c603, 0x07bdb, 0x06336, 0x1deee,
+            0x1dee9, 0x06331, 0x07bdc, 0x1c604, 0x04a45, 0x1f79d, 0x1ef70, 0x052a8,
+            0x0631f, 0x1dec7, 0x1c62a, 0x07bf2, 0x1f7b3, 0x04a6b, 0x05286, 0x1ef5e,
+            0x1ef59, 0x05281, 0x04a6c, 0x1f7b4, 0x07bf5, 0x1c62d, 0x1dec0, 0x06318,
+            0x10034, 0x0bdec, 0x0a501, 0x118d9, 0x09498, 0x12940, 0x131ad, 0x08c75,
+            0x08c72, 0x131aa, 0x12947, 0x0949f, 0x118de, 0x0a506, 0x0bdeb, 0x10033,
+            0x07bc7, 0x1c61f, 0x1def2, 0x0632a, 0x1ef6b, 0x052b3, 0x04a5e, 0x1f786,
+            0x1f781, 0x04a59, 0x052b4, 0x1ef6c, 0x0632d, 0x1def5, 0x1c618, 0x07bc0,
+            0x118ec, 0x0a534, 0x0bdd9, 0x10001, 0x08c40, 0x13198, 0x12975, 0x094ad,
+            0x094aa, 0x12972, 0x1319f, 0x08c47, 0x10006, 0x0bdde, 0x0a533, 0x118eb,
+            0x1295c, 0x09484, 0x08c69, 0x131b1, 0x0bdf0, 0x10028, 0x118c5, 0x0a51d,
+            0x0a51a, 0x118c2, 0x1002f, 0x0bdf7, 0x131b6, 0x08c6e, 0x09483, 0x1295b,
+            0x04a77, 0x1f7af, 0x1ef42, 0x0529a, 0x1dedb, 0x06303, 0x07bee, 0x1c636,
+            0x1c631, 0x07be9, 0x06304, 0x1dedc, 0x0529d, 0x1ef45, 0x1f7a8, 0x04a70,
+        },
+        {   // byte 5 (bits 40..47)
+            0x00000, 0x12942, 0x118c1, 0x03183, 0x0f812, 0x1d150, 0x1e0d3, 0x0c991,
+            0x0e027, 0x1c965, 0x1f8e6, 0x0d1a4, 0x01835, 0x13177, 0x100f4, 0x029b6,
+            0x0d00e, 0x1f94c, 0x1c8cf, 0x0e18d, 0x0281c, 0x1015e, 0x130dd, 0x0199f,
+            0x03029, 0x1196b, 0x128e8, 0x001aa, 0x0c83b, 0x1e179, 0x1d0fa, 0x0f9b8,
+            0x0c83c, 0x1e17e, 0x1d0fd, 0x0f9bf, 0x0302e, 0x1196c, 0x128ef, 0x001ad,
+            0x0281b, 0x10159, 0x130da, 0x01998, 0x0d009, 0x1f94b, 0x1c8c8, 0x0e18a,
+            0x01832, 0x13170, 0x100f3, 0x029b1, 0x0e020, 0x1c962, 0x1f8e1, 0x0d1a3,
+            0x0f815, 0x1d157, 0x1e0d4, 0x0c996, 0x00007, 0x12945, 0x118c6, 0x03184,
+            0x0b01d, 0x1995f, 0x1a8dc, 0x0819e, 0x0480f, 0x1614d, 0x150ce, 0x0798c,
+            0x0503a, 0x17978, 0x148fb, 0x061b9, 0x0a828, 0x1816a, 0x1b0e9, 0x099ab,
+            0x06013, 0x14951, 0x178d2, 0x05190, 0x09801, 0x1b143, 0x180c0, 0x0a982,
+            0x08034, 0x1a976, 0x198f5, 0x0b1b7, 0x07826, 0x15164, 0x160e7, 0x049a5,
+            0x07821, 0x15163, 0x160e0, 0x049a2, 0x08033, 0x1a971, 0x198f2, 0x0b1b0,
+            0x09806, 0x1b144, 0x180c7, 0x0a985, 0x06014, 0x14956, 0x178d5, 0x05197,
+            0x0a82f, 0x1816d, 0x1b0ee, 0x099ac, 0x0503d, 0x1797f, 0x148fc, 0x061be,
+            0x04808, 0x1614a, 0x150c9, 0x0798b, 0x0b01a, 0x19958, 0x1a8db, 0x08199,
+            0x0a831, 0x18173, 0x1b0f0, 0x099b2, 0x05023, 0x17961, 0x148e2, 0x061a0,
+            0x04816, 0x16154, 0x150d7, 0x07995, 0x0b004, 0x19946, 0x1a8c5, 0x08187,
+            0x0783f, 0x1517d, 0x160fe, 0x049bc, 0x0802d, 0x1a96f, 0x198ec, 0x0b1ae,
+            0x09818, 0x1b15a, 0x180d9, 0x0a99b, 0x0600a, 0x14948, 0x178cb, 0x05189,
+            0x0600d, 0x1494f, 0x178cc, 0x0518e, 0x0981f, 0x1b15d, 0x180de, 0x0a99c,
+            0x0802a, 0x1a968, 0x198eb, 0x0b1a9, 0x07838, 0x1517a, 0x160f9, 0x049bb,
+            0x0b003, 0x19941, 0x1a8c2, 0x08180, 0x04811, 0x16153, 0x150d0, 0x07992,
+            0x05024, 0x17966, 0x148e5, 0x061a7, 0x0a836, 0x18174, 0x1b0f7, 0x099b5,
+            0x0182c, 0x1316e, 0x100ed, 0x029af, 0x0e03e, 0x1c97c, 0x1f8ff, 0x0d1bd,
+            0x0f80b, 0x1d149, 0x1e0ca, 0x0c988, 0x00019, 0x1295b, 0x118d8, 0x0319a,
+            0x0c822, 0x1e160, 0x1d0e3, 0x0f9a1, 0x03030, 0x11972, 0x128f1, 0x001b3,
+            0x02805, 0x10147, 0x130c4, 0x01986, 0x0d017, 0x1f955, 0x1c8d6, 0x0e194,
+            0x0d010, 0x1f952, 0x1c8d1, 0x0e193, 0x02802, 0x10140, 0x130c3, 0x01981,
+            0x03037, 0x11975, 0x128f6, 0x001b4, 0x0c825, 0x1e167, 0x1d0e4, 0x0f9a6,
+            0x0001e, 0x1295c, 0x118df, 0x0319d, 0x0f80c, 0x1d14e, 0x1e0cd, 0x0c98f,
+            0x0e039, 0x1c97b, 0x1f8f8, 0x0d1ba, 0x0182b, 0x13169, 0x100ea, 0x029a8,
+        },
+        {   // byte 6 (bits 48..55)
+            0x00000, 0x0982b, 0x07034, 0x0e81f, 0x0682a, 0x0f001, 0x0181e, 0x08035,
+            0x05819, 0x0c032, 0x0282d, 0x0b006, 0x03033, 0x0a818, 0x04007, 0x0d82c,
+            0x03807, 0x0a02c, 0x04833, 0x0d018, 0x0502d, 0x0c806, 0x02019, 0x0b832,
+            0x0601e, 0x0f835, 0x0102a, 0x08801, 0x00834, 0x0901f, 0x07800, 0x0e02b,
+            0x007d2, 0x09ff9, 0x077e6, 0x0efcd, 0x06ff8, 0x0f7d3, 0x01fcc, 0x087e7,
+            0x05fcb, 0x0c7e0, 0x02fff, 0x0b7d4, 0x037e1, 0x0afca, 0x047d5, 0x0dffe,
+            0x03fd5, 0x0a7fe, 0x04fe1, 0x0d7ca, 0x057ff, 0x0cfd4, 0x027cb, 0x0bfe0,
+            0x067cc, 0x0ffe7, 0x017f8, 0x08fd3, 0x00fe6, 0x097cd, 0x07fd2, 0x0e7f9,
+            0x00727, 0x09f0c, 0x07713, 0x0ef38, 0x06f0d, 0x0f726, 0x01f39, 0x08712,
+            0x05f3e, 0x0c715, 0x02f0a, 0x0b721, 0x03714, 0x0af3f, 0x04720, 0x0df0b,
+            0x03f20, 0x0a70b, 0x04f14, 0x0d73f, 0x0570a, 0x0cf21, 0x0273e, 0x0bf15,
+            0x06739, 0x0ff12, 0x0170d, 0x08f26, 0x00f13, 0x09738, 0x07f27, 0x0e70c,
+            0x000f5, 0x098de, 0x070c1, 0x0e8ea, 0x068df, 0x0f0f4, 0x018eb, 0x080c0,
+            0x058ec, 0x0c0c7, 0x028d8, 0x0b0f3, 0x030c6, 0x0a8ed, 0x040f2, 0x0d8d9,
+            0x038f2, 0x0a0d9, 0x048c6, 0x0d0ed, 0x050d8, 0x0c8f3, 0x020ec, 0x0b8c7,
+            0x060eb, 0x0f8c0, 0x010df, 0x088f4, 0x008c1, 0x090ea, 0x078f5, 0x0e0de,
+            0x0068e, 0x09ea5, 0x076ba, 0x0ee91, 0x06ea4, 0x0f68f, 0x01e90, 0x086bb,
+            0x05e97, 0x0c6bc, 0x02ea3, 0x0b688, 0x036bd, 0x0ae96, 0x04689, 0x0dea2,
+            0x03e89, 0x0a6a2, 0x04ebd, 0x0d696, 0x056a3, 0x0ce88, 0x02697, 0x0bebc,
+            0x06690, 0x0febb, 0x016a4, 0x08e8f, 0x00eba, 0x09691, 0x07e8e, 0x0e6a5,
+            0x0015c, 0x09977, 0x07168, 0x0e943, 0x06976, 0x0f15d, 0x01942, 0x08169,
+            0x05945, 0x0c16e, 0x02971, 0x0b15a, 0x0316f, 0x0a944, 0x0415b, 0x0d970,
+            0x0395b, 0x0a170, 0x0496f, 0x0d144, 0x05171, 0x0c95a, 0x02145, 0x0b96e,
+            0x06142, 0x0f969, 0x01176, 0x0895d, 0x00968, 0x09143, 0x0795c, 0x0e177,
+            0x001a9, 0x09982, 0x0719d, 0x0e9b6, 0x06983, 0x0f1a8, 0x019b7, 0x0819c,
+            0x059b0, 0x0c19b, 0x02984, 0x0b1af, 0x0319a, 0x0a9b1, 0x041ae, 0x0d985,
+            0x039ae, 0x0a185, 0x0499a, 0x0d1b1, 0x05184, 0x0c9af, 0x021b0, 0x0b99b,
+            0x061b7, 0x0f99c, 0x01183, 0x089a8, 0x0099d, 0x091b6, 0x079a9, 0x0e182,
+            0x0067b, 0x09e50, 0x0764f, 0x0ee64, 0x06e51, 0x0f67a, 0x01e65, 0x0864e,
+            0x05e62, 0x0c649, 0x02e56, 0x0b67d, 0x03648, 0x0ae63, 0x0467c, 0x0de57,
+            0x03e7c, 0x0a657, 0x04e48, 0x0d663, 0x05656, 0x0ce7d, 0x02662, 0x0be49,
+            0x06665, 0x0fe4e, 0x01651, 0x08e7a, 0x00e4f, 0x09664, 0x07e7b, 0x0e650,
+        },
+        {   // byte 7 (bits 56..63)
+            0x00000, 0x0067c, 0x0059d, 0x003e1, 0x004eb, 0x00297, 0x00176, 0x0070a,
+            0x003b4, 0x005c8, 0x00629, 0x00055, 0x0075f, 0x00123, 0x002c2, 0x004be,
+            0x0036a, 0x00516, 0x006f7, 0x0008b, 0x00781, 0x001fd, 0x0021c, 0x00460,
+            0x000de, 0x006a2, 0x00543, 0x0033f, 0x00435, 0x00249, 0x001a8, 0x007d4,
+            0x002d9, 0x004a5, 0x00744, 0x00138, 0x00632, 0x0004e, 0x003af, 0x005d3,
+            0x0016d, 0x00711, 0x004f0, 0x0028c, 0x00586, 0x003fa, 0x0001b, 0x00667,
+            0x001b3, 0x007cf, 0x0042e, 0x00252, 0x00558, 0x00324, 0x000c5, 0x006b9,
+            0x00207, 0x0047b, 0x0079a, 0x001e6, 0x006ec, 0x00090, 0x00371, 0x0050d,
+            0x001c7, 0x007bb, 0x0045a, 0x00226, 0x0052c, 0x00350, 0x000b1, 0x006cd,
+            0x00273, 0x0040f, 0x007ee, 0x00192, 0x00698, 0x000e4, 0x00305, 0x00579,
+            0x002ad, 0x004d1, 0x00730, 0x0014c, 0x00646, 0x0003a, 0x003db, 0x005a7,
+            0x00119, 0x00765, 0x00484, 0x002f8, 0x005f2, 0x0038e, 0x0006f, 0x00613,
+            0x0031e, 0x00562, 0x00683, 0x000ff, 0x007f5, 0x00189, 0x00268, 0x00414,
+            0x000aa, 0x006d6, 0x00537, 0x0034b, 0x00441, 0x0023d, 0x001dc, 0x007a0,
+            0x00074, 0x00608, 0x005e9, 0x00395, 0x0049f, 0x002e3, 0x00102, 0x0077e,
+            0x003c0, 0x005bc, 0x0065d, 0x00021, 0x0072b, 0x00157, 0x002b6, 0x004ca,
+            0x0003f, 0x00643, 0x005a2, 0x003de, 0x004d4, 0x002a8, 0x00149, 0x00735,
+            0x0038b, 0x005f7, 0x00616, 0x0006a, 0x00760, 0x0011c, 0x002fd, 0x00481,
+            0x00355, 0x00529, 0x006c8, 0x000b4, 0x007be, 0x001c2, 0x00223, 0x0045f,
+            0x000e1, 0x0069d, 0x0057c, 0x00300, 0x0040a, 0x00276, 0x00197, 0x007eb,
+            0x002e6, 0x0049a, 0x0077b, 0x00107, 0x0060d, 0x00071, 0x00390, 0x005ec,
+            0x00152, 0x0072e, 0x004cf, 0x002b3, 0x005b9, 0x003c5, 0x00024, 0x00658,
+            0x0018c, 0x007f0, 0x00411, 0x0026d, 0x00567, 0x0031b, 0x000fa, 0x00686,
+            0x00238, 0x00444, 0x007a5, 0x001d9, 0x006d3, 0x000af, 0x0034e, 0x00532,
+            0x001f8, 0x00784, 0x00465, 0x00219, 0x00513, 0x0036f, 0x0008e, 0x006f2,
+            0x0024c, 0x00430, 0x007d1, 0x001ad, 0x006a7, 0x000db, 0x0033a, 0x00546,
+            0x00292, 0x004ee, 0x0070f, 0x00173, 0x00679, 0x00005, 0x003e4, 0x00598,
+            0x00126, 0x0075a, 0x004bb, 0x002c7, 0x005cd, 0x003b1, 0x00050, 0x0062c,
+            0x00321, 0x0055d, 0x006bc, 0x000c0, 0x007ca, 0x001b6, 0x00257, 0x0042b,
+            0x00095, 0x006e9, 0x00508, 0x00374, 0x0047e, 0x00202, 0x001e3, 0x0079f,
+            0x0004b, 0x00637, 0x005d6, 0x003aa, 0x004a0, 0x002dc, 0x0013d, 0x00741,
+            0x003ff, 0x00583, 0x00662, 0x0001e, 0x00714, 0x00168, 0x00289, 0x004f5,
+        },
+};
+
+uint32_t flowAddress_syndrome(uint64_t word) {
+    return syndromeTable[0][(uint8_t) word] ^
+           syndromeTable[1][(uint8_t) (word >> 8u)] ^
+           syndromeTable[2][(uint8_t) (word >> 16u)] ^
+           syndromeTable[3][(uint8_t) (word >> 24u)] ^
+           syndromeTable[4][(uint8_t) (word >> 32u)] ^
+           syndromeTable[5][(uint8_t) (word >> 40u)] ^
+           syndromeTable[6][(uint8_t) (word >> 48u)] ^
+           syndromeTable[7][(uint8_t) (word >> 56u)];
+}
+
+// The code is linear: address ^ chainCodeword is a codeword exactly when both have the same syndrome
+#define SYNDROME_MAINNET 0x00000u
+#define SYNDROME_TESTNET 0x7ca49u
+#define SYNDROME_EMULATOR 0x66deau
+
+__Z_INLINE chain_id_e chainFromSyndrome(uint64_t address, uint32_t syndrome) {
+    // address == chain codeword is index 0, which is not a valid account
+    if (syndrome == SYNDROME_MAINNET && address != codeword_mainnet) {
+        return CHAIN_ID_MAINNET;
+    }
+    if (syndrome == SYNDROME_TESTNET && address != codeword_testnet) {
+        return CHAIN_ID_TESTNET;
+    }
+    if (syndrome == SYNDROME_EMULATOR && address != codeword_emulatornet) {
+        return CHAIN_ID_EMULATOR;
+    }
+    return CHAIN_ID_UNKNOWN;
+}
+
+parser_error_t flowAddress_chainID(uint64_t address, chain_id_e *chainID) {
+    *chainID = chainFromSyndrome(address, flowAddress_syndrome(address));
+    if (*chainID == CHAIN_ID_UNKNOWN) {
+        return PARSER_UNEXPECTED_VALUE;
+    }
+    return PARSER_OK;
+}
+
+// Same result as chainFromSyndrome without branches. Syndromes differ per chain so at most one
+// of the matches is set, and CHAIN_ID_UNKNOWN is 0 so the chains can be ORed together.
+__Z_INLINE chain_id_e chainFromSyndromeBranchFree(uint64_t address, uint32_t syndrome) {
+    const uint32_t mainnet = (uint32_t) (syndrome == SYNDROME_MAINNET) & (uint32_t) (address != codeword_mainnet);
+    const uint32_t testnet = (uint32_t) (syndrome == SYNDROME_TESTNET) & (uint32_t) (address != codeword_testnet);
+    const uint32_t emulator = (uint32_t) (syndrome == SYNDROME_EMULATOR) & (uint32_t) (address != codeword_emulatornet);
+
+    return (chain_id_e) ((mainnet * CHAIN_ID_MAINNET) |
+                         (testnet * CHAIN_ID_TESTNET) |
+                         (emulator * CHAIN_ID_EMULATOR));
+}
+
+size_t flowAddress_validateBatch(const uint64_t *addresses, size_t count, chain_id_e *chainIDs) {
+    size_t valid = 0;
+
+    // Every address takes the same path, the loop only exits once the batch is done
+    for (size_t i = 0; i < count; i++) {
+        const uint32_t syndrome = flowAddress_syndrome(addresses[i]);
+        chainIDs[i] = chainFromSyndromeBranchFree(addresses[i], syndrome);
+        valid += chainIDs[i] != CHAIN_ID_UNKNOWN;
+    }
+
+    return valid;
+}
+
+parser_error_t flowAddress_fromIndex(chain_id_e chainID, uint64_t index, uint64_t *address) {
+    *address = 0;
+
+    uint64_t chainCodeword;
+    switch (chainID) {
+        case CHAIN_ID_MAINNET:
+            chainCodeword = codeword_mainnet;
+            break;
+        case CHAIN_ID_TESTNET:
+            chainCodeword = codeword_testnet;
+            break;
+        case CHAIN_ID_EMULATOR:
+            chainCodeword = codeword_emulatornet;
+            break;
+        default:
+            return PARSER_UNEXPECTED_VALUE;
+    }
+
+    if (index == 0 || index > FLOW_ADDRESS_MAX_INDEX) {
+        return PARSER_VALUE_OUT_OF_RANGE;
+    }
+
+    uint64_t codeword = 0;
+    for (uint8_t i = 0; i < FLOW_ADDRESS_LINEAR_CODE_K; i++) {
+        // mask is all ones when bit i of index is set
+        const uint64_t mask = 0 - ((index >> i) & 1u);
+        codeword ^= generatorMatrixRows[i] & mask;
+    }
+
+    *address = codeword ^ chainCodeword;
+    return PARSER_OK;
+}
@@ -0,0 +1,50 @@
+/*******************************************************************************
+*   (c) 2021 Zondax GmbH
+*
+*  Licensed under the Apache License, Version 2.0 (the "License");
+*  you may not use this file except in compliance with the License.
+*  You may obtain a copy of the License at
+*
+*      http://www.apache.org/licenses/LICENSE-2.0
+*
+*  Unless required by applicable law or agreed to in writing, software
+*  distributed under the License is distributed on an "AS IS" BASIS,
+*  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+*  See the License for the specific language governing permissions and
+*  limitations under the License.
+********************************************************************************/
+#pragma once
+
+#include <zxmacros.h>
+#include "parser_common.h"
+#include "parser_txdef.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Flow addresses are codewords of a [64,45] linear code xored with a per chain codeword
+#define FLOW_ADDRESS_LINEAR_CODE_N 64
+#define FLOW_ADDRESS_LINEAR_CODE_K 45
+#define FLOW_ADDRESS_MAX_INDEX ((1ull << FLOW_ADDRESS_LINEAR_CODE_K) - 1)
+
+extern const uint64_t codeword_mainnet;
+extern const uint64_t codeword_testnet;
+extern const uint64_t codeword_emulatornet;
+
+// 19-bit syndrome of a 64-bit word, 0 for codewords of the linear code
+uint32_t flowAddress_syndrome(uint64_t word);
+
+// Identifies the chain an address belongs to with a single syndrome computation
+parser_error_t flowAddress_chainID(uint64_t address, chain_id_e *chainID);
+
+// Writes the chain of each address to chainIDs, CHAIN_ID_UNKNOWN for invalid addresses
+// Returns the number of valid addresses
+size_t flowAddress_validateBatch(const uint64_t *addresses, size_t count, chain_id_e *chainIDs);
+
+// Address of the index-th account of a chain (the service account is index 1)
+parser_error_t flowAddress_fromIndex(chain_id_e chainID, uint64_t index, uint64_t *address);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,87 @@
+/*******************************************************************************
+*   (c) 2021 Zondax GmbH
+*
+*  Licensed under the Apache License, Version 2.0 (the "License");
+*  you may not use this file except in compliance with the License.
+*  You may obtain a copy of the License at
+*
+*      http://www.apache.org/licenses/LICENSE-2.0
+*
+*  Unless required by applicable law or agreed to in writing, software
+*  distributed under the License is distributed on an "AS IS" BASIS,
+*  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+*  See the License for the specific language governing permissions and
+*  limitations under the License.
+********************************************************************************/
+
+#if !defined(TARGET_NANOS) && !defined(TARGET_NANOX) && !defined(TARGET_NANOS2)
+
+#include "flow_tx_id.h"
+#include "rlp.h"
+#include "sha3_host.h"
+
+// Skips one list item of ctx
+static parser_error_t flow_tx_id_skipList(parser_context_t *ctx) {
+    parser_context_t item;
+    rlp_kind_e kind;
+    uint32_t bytesConsumed;
+    CHECK_PARSER_ERR(rlp_decode(ctx, &item, &kind, &bytesConsumed))
+    if (kind != RLP_KIND_LIST) {
+        return PARSER_RLP_ERROR_INVALID_KIND;
+    }
+    CTX_CHECK_AND_ADVANCE(ctx, bytesConsumed)
+    return PARSER_OK;
+}
+
+static uint8_t rlp_listHeader(uint32_t contentLen, uint8_t header[5]) {
+    if (contentLen < 56) {
+        header[0] = (uint8_t) (0xC0 + contentLen);
+        return 1;
+    }
+
+    uint8_t lenLen = 0;
+    for (uint32_t tmp = contentLen; tmp > 0; tmp >>= 8u) {
+        lenLen++;
+    }
+    header[0] = (uint8_t) (0xF7 + lenLen);
+    for (uint8_t i = 0; i < lenLen; i++) {
+        header[lenLen - i] = (uint8_t) (contentLen >> (8u * i));
+    }
+    return (uint8_t) (1 + lenLen);
+}
+
+parser_error_t flow_tx_id(const parser_tx_t *tx,
+                          const uint8_t *envelopeSignatures, uint16_t envelopeSignaturesLen,
+                          uint8_t id[FLOW_TX_ID_SIZE]) {
+    if (tx == NULL || tx->envelope.buffer == NULL || envelopeSignatures == NULL || id == NULL) {
+        return PARSER_NO_DATA;
+    }
+
+    // The envelope holds exactly the payload and the payload signatures
+    parser_context_t envelope = tx->envelope;
+    envelope.offset = 0;
+    CHECK_PARSER_ERR(flow_tx_id_skipList(&envelope))
+    CHECK_PARSER_ERR(flow_tx_id_skipList(&envelope))
+    if (envelope.offset != envelope.bufferLen) {
+        return PARSER_UNEXPECTED_NUMBER_ITEMS;
+    }
+
+    parser_context_t signatures = {envelopeSignatures, envelopeSignaturesLen, 0};
+    CHECK_PARSER_ERR(flow_tx_id_skipList(&signatures))
+    if (signatures.offset != signatures.bufferLen) {
+        return PARSER_UNEXPECTED_BUFFER_END;
+    }
+
+    uint8_t header[5];
+    const uint8_t headerLen = rlp_listHeader((uint32_t) envelope.bufferLen + envelopeSignaturesLen, header);
+
+    sha3_host_ctx_t ctx;
+    sha3_256_host_init(&ctx);
+    sha3_256_host_update(&ctx, header, headerLen);
+    sha3_256_host_update(&ctx, envelope.buffer, envelope.bufferLen);
+    sha3_256_host_update(&ctx, envelopeSignatures, envelopeSignaturesLen);
+    sha3_256_host_final(&ctx, id);
+    return PARSER_OK;
+}
+
+#endif
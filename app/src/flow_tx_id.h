@@ -0,0 +1,40 @@
+/*******************************************************************************
+*   (c) 2021 Zondax GmbH
+*
+*  Licensed under the Apache License, Version 2.0 (the "License");
+*  you may not use this file except in compliance with the License.
+*  You may obtain a copy of the License at
+*
+*      http://www.apache.org/licenses/LICENSE-2.0
+*
+*  Unless required by applicable law or agreed to in writing, software
+*  distributed under the License is distributed on an "AS IS" BASIS,
+*  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+*  See the License for the specific language governing permissions and
+*  limitations under the License.
+********************************************************************************/
+#pragma once
+
+#if !defined(TARGET_NANOS) && !defined(TARGET_NANOX) && !defined(TARGET_NANOS2)
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "parser_common.h"
+#include "parser_txdef.h"
+
+#define FLOW_TX_ID_SIZE 32
+
+// Transaction ID: SHA3-256 of the RLP list [payload, payloadSignatures, envelopeSignatures]
+// tx comes from parsing an envelope, its bytes are hashed in place.
+// envelopeSignatures is the RLP list of envelope signatures (0xc0 when there are none).
+parser_error_t flow_tx_id(const parser_tx_t *tx,
+                          const uint8_t *envelopeSignatures, uint16_t envelopeSignaturesLen,
+                          uint8_t id[FLOW_TX_ID_SIZE]);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -44,13 +44,15 @@ void __assert_fail(const char * assertion, const char * file, unsigned int line,
     (RLP_PREFIX + FLOW_WEIGHT_SIZE) \
 ) + 2)
 
-#define ARGUMENT_BUFFER_SIZE_STRING 256
-
 #define MAX_JSON_ARRAY_TOKEN_COUNT 64  
 
 parser_error_t parser_parse(parser_context_t *ctx, const uint8_t *data, size_t dataLen) {
+    parser_resetWork();
     CHECK_PARSER_ERR(parser_init(ctx, data, dataLen))
-    return _read(ctx, &parser_tx_obj);
+
+    zb_mark_t mark;
+    parser_scratchBegin(&mark);
+    return parser_scratchEnd(mark, _read(ctx, &parser_tx_obj));
 }
 
 parser_error_t parser_validate(const parser_context_t *ctx) {
@@ -72,81 +74,19 @@ parser_error_t parser_validate(const parser_context_t *ctx) {
 }
 
 parser_error_t parser_getNumItems(const parser_context_t *ctx, uint8_t *num_items) {
-    CHECK_PARSER_ERR(_getNumItems(ctx, &parser_tx_obj, num_items))
+    zb_mark_t mark;
+    parser_scratchBegin(&mark);
+    CHECK_PARSER_ERR(parser_scratchEnd(mark, _getNumItems(ctx, &parser_tx_obj, num_items)))
     return PARSER_OK;
 }
 
-// based on Dapper provided code at https://github.com/onflow/flow-go-sdk/blob/96796f0cabc1847d7879a5230ab55fd3cdd41ae8/address.go#L286
-
-const uint16_t linearCodeN = 64;
-const uint64_t codeword_mainnet = 0;
-const uint64_t codeword_testnet = 0x6834ba37b3980209;
-const uint64_t codeword_emulatornet = 0x1cb159857af02018;
-
-const uint32_t parityCheckMatrixColumns[] = {
-        0x00001, 0x00002, 0x00004, 0x00008,
-        0x00010, 0x00020, 0x00040, 0x00080,
-        0x00100, 0x00200, 0x00400, 0x00800,
-        0x01000, 0x02000, 0x04000, 0x08000,
-        0x10000, 0x20000, 0x40000, 0x7328d,
-        0x6689a, 0x6112f, 0x6084b, 0x433fd,
-        0x42aab, 0x41951, 0x233ce, 0x22a81,
-        0x21948, 0x1ef60, 0x1deca, 0x1c639,
-        0x1bdd8, 0x1a535, 0x194ac, 0x18c46,
-        0x1632b, 0x1529b, 0x14a43, 0x13184,
-        0x12942, 0x118c1, 0x0f812, 0x0e027,
-        0x0d00e, 0x0c83c, 0x0b01d, 0x0a831,
-        0x0982b, 0x07034, 0x0682a, 0x05819,
-        0x03807, 0x007d2, 0x00727, 0x0068e,
-        0x0067c, 0x0059d, 0x004eb, 0x003b4,
-        0x0036a, 0x002d9, 0x001c7, 0x0003f,
-};
-
-bool validateChainAddress(uint64_t chainCodeWord, uint64_t address) {
-    uint64_t codeWord = address ^chainCodeWord;
-
-    if (codeWord == 0) {
-        return false;
-    }
-
-    uint64_t parity = 0;
-    for (uint16_t i = 0; i < linearCodeN; i++) {
-        if ((codeWord & 1) == 1) {
-            parity ^= parityCheckMatrixColumns[i];
-        }
-        codeWord >>= 1;
-    }
-
-    return parity == 0;
-}
-
 parser_error_t chainIDFromPayer(const flow_payer_t *v, chain_id_e *chainID) {
     if (v->ctx.bufferLen != 8) {
         return PARSER_INVALID_ADDRESS;
     }
 
-    uint64_t address = 0;
-    for (uint8_t i = 0; i < 8; i++) {
-        address <<= 8;
-        address += v->ctx.buffer[i];
-    }
-
-    if (validateChainAddress(codeword_mainnet, address)) {
-        *chainID = CHAIN_ID_MAINNET;
-        return PARSER_OK;
-    }
-
-    if (validateChainAddress(codeword_testnet, address)) {
-        *chainID = CHAIN_ID_TESTNET;
-        return PARSER_OK;
-    }
-
-    if (validateChainAddress(codeword_emulatornet, address)) {
-        *chainID = CHAIN_ID_EMULATOR;
-        return PARSER_OK;
-    }
-
-    return PARSER_UNEXPECTED_VALUE;
+    const uint64_t address = uint64_from_BEarray(v->ctx.buffer);
+    return chainIDFromAddress(address, chainID);
 }
 
 parser_error_t parser_printChainID(const flow_payer_t *v,
@@ -175,6 +115,60 @@ parser_error_t parser_printChainID(const flow_payer_t *v,
     return PARSER_INVALID_ADDRESS;
 }
 
+parser_error_t parser_formatArgumentValue(const parser_context_t *argCtx, const flow_argument_value_t *value,
+                                         char *outVal, uint16_t outValLen) {
+    MEMZERO(outVal, outValLen);
+
+    uint64_t number = 0;
+    CHECK_PARSER_ERR(parser_argumentNumber(argCtx, value, &number))
+
+    const argument_type_e type = value->type == ARGUMENT_TYPE_OPTIONAL ? value->innerType : value->type;
+    switch (type) {
+        case ARGUMENT_TYPE_UFIX64:
+            if (fpuint64_to_str_trimmed(outVal, outValLen, number, UFIX64_DECIMALS) == 0) {
+                return PARSER_UNEXPECTED_BUFFER_END;
+            }
+            return PARSER_OK;
+        case ARGUMENT_TYPE_ADDRESS: {
+            uint8_t address[8];
+            for (uint8_t i = 0; i < sizeof(address); i++) {
+                address[i] = (uint8_t) (number >> (8u * (sizeof(address) - 1 - i)));
+            }
+            if (outValLen < 2 + 2 * sizeof(address) + 1) {
+                return PARSER_UNEXPECTED_BUFFER_END;
+            }
+            outVal[0] = '0';
+            outVal[1] = 'x';
+            if (array_to_hexstr(outVal + 2, outValLen - 2, address, sizeof(address)) != 2 * sizeof(address)) {
+                return PARSER_UNEXPECTED_BUFFER_END;
+            }
+            return PARSER_OK;
+        }
+        case ARGUMENT_TYPE_UINT8:
+        case ARGUMENT_TYPE_UINT16:
+        case ARGUMENT_TYPE_UINT32:
+        case ARGUMENT_TYPE_UINT64:
+            if (uint64_to_str(outVal, outValLen, number) != NULL) {
+                return PARSER_UNEXPECTED_BUFFER_END;
+            }
+            return PARSER_OK;
+        default:
+            return PARSER_UNEXPECTED_TYPE;
+    }
+}
+
+parser_error_t parser_getArgumentValue(uint8_t argIndex, flow_argument_value_t *value, uint64_t *number) {
+    *number = 0;
+    if (argIndex >= parser_tx_obj.arguments.argCount) {
+        return PARSER_UNEXPECTED_NUMBER_ITEMS;
+    }
+    MEMCPY(value, &parser_tx_obj.arguments.argValue[argIndex], sizeof(flow_argument_value_t));
+    if (!value->hasValue) {
+        return PARSER_OK;
+    }
+    return parser_argumentNumber(&parser_tx_obj.arguments.argCtx[argIndex], value, number);
+}
+
 parser_error_t parser_printArgument(const flow_argument_list_t *v,
                                                uint8_t argIndex, char *expectedType, jsmntype_t jsonType,
                                                char *outVal, uint16_t outValLen,
@@ -187,11 +181,17 @@ parser_error_t parser_printArgument(const flow_argument_list_t *v,
 
     *pageCount = 1;
 
-    parsed_json_t parsedJson = {false};
-    CHECK_PARSER_ERR(json_parse(&parsedJson, (char *) v->argCtx[argIndex].buffer, v->argCtx[argIndex].bufferLen));
+    parsed_json_t *parsedJson = NULL;
+    CHECK_PARSER_ERR(parser_scratchJson(&parsedJson))
+    CHECK_PARSER_ERR(parser_jsonParse(parsedJson, &v->argCtx[argIndex]));
     uint16_t valueTokenIndex;
-    CHECK_PARSER_ERR(json_matchKeyValue(&parsedJson, 0, expectedType, jsonType, &valueTokenIndex))
-    CHECK_PARSER_ERR(json_extractToken(outVal, outValLen, &parsedJson, valueTokenIndex))
+    CHECK_PARSER_ERR(json_matchKeyValue(parsedJson, 0, expectedType, jsonType, &valueTokenIndex))
+
+    if (v->argValue[argIndex].hasValue) {
+        CHECK_PARSER_ERR(parser_formatArgumentValue(&v->argCtx[argIndex], &v->argValue[argIndex], outVal, outValLen))
+    } else {
+        CHECK_PARSER_ERR(json_extractToken(outVal, outValLen, parsedJson, valueTokenIndex))
+    }
 
     return PARSER_OK;
 }
@@ -209,62 +209,114 @@ parser_error_t parser_printArgumentOptionalDelegatorID(const flow_argument_list_
 
     *pageCount = 1;
 
-    parsed_json_t parsedJson = {false};
-    CHECK_PARSER_ERR(json_parse(&parsedJson, (char *) v->argCtx[argIndex].buffer, v->argCtx[argIndex].bufferLen));
+    parsed_json_t *parsedJson = NULL;
+    CHECK_PARSER_ERR(parser_scratchJson(&parsedJson))
+    CHECK_PARSER_ERR(parser_jsonParse(parsedJson, &v->argCtx[argIndex]));
     uint16_t valueTokenIndex;
-    CHECK_PARSER_ERR(json_matchOptionalKeyValue(&parsedJson, 0, expectedType, jsonType, &valueTokenIndex))
+    CHECK_PARSER_ERR(json_matchOptionalKeyValue(parsedJson, 0, expectedType, jsonType, &valueTokenIndex))
     if (valueTokenIndex == JSON_MATCH_VALUE_IDX_NONE) {
         if (outValLen < 5) {
             return PARSER_UNEXPECTED_BUFFER_END;
         }         
         strncpy_s(outVal, "None", 5);
     }
+    else if (v->argValue[argIndex].hasValue) {
+        CHECK_PARSER_ERR(parser_formatArgumentValue(&v->argCtx[argIndex], &v->argValue[argIndex], outVal, outValLen))
+    }
     else {
-        CHECK_PARSER_ERR(json_extractToken(outVal, outValLen, &parsedJson, valueTokenIndex))
+        CHECK_PARSER_ERR(json_extractToken(outVal, outValLen, parsedJson, valueTokenIndex))
     }
 
     return PARSER_OK;
 }
 
 
-parser_error_t parser_printArgumentString(const parser_context_t *argumentCtx,
-                                             char *outVal, uint16_t outValLen,
-                                             uint8_t pageIdx, uint8_t *pageCount) {
+// Same as pageStringExt over the ASCII folding of a valid UTF-8 value holding foldedLen codepoints
+static void pageFoldedString(char *outVal, uint16_t outValLen,
+                             const char *value, uint16_t valueLen, uint16_t foldedLen,
+                             uint8_t pageIdx, uint8_t *pageCount) {
     MEMZERO(outVal, outValLen);
+    const uint16_t pageLen = outValLen - 1;
+    *pageCount = (uint8_t) ((foldedLen + pageLen - 1) / pageLen);
+    if (pageIdx >= *pageCount) {
+        return;
+    }
+
+    const uint32_t first = (uint32_t) pageIdx * pageLen;
+    uint32_t codepoint = 0;
+    uint16_t written = 0;
+    for (uint16_t i = 0; i < valueLen && written < pageLen; i++) {
+        const uint8_t c = (uint8_t) value[i];
+        if ((c & 0xC0u) == 0x80u) {
+            // continuation byte
+            continue;
+        }
+        if (codepoint++ < first) {
+            continue;
+        }
+        outVal[written++] = (char) (c >= 32 && c < 0x80 ? c : '.');
+    }
+}
+
+// Pages the String value at tokenIdx straight from the argument buffer, non ASCII codepoints are shown as '.'
+// maxValueLen == 0 means the length is only bounded by the number of pages that can be shown
+static parser_error_t parser_pageString(parsed_json_t *parsedJson, uint16_t tokenIdx, uint16_t maxValueLen,
+                                        char *outVal, uint16_t outValLen,
+                                        uint8_t pageIdx, uint8_t *pageCount) {
+    const char *value = NULL;
+    uint16_t valueLen = 0;
+    CHECK_PARSER_ERR(json_getStringSpan(parsedJson, tokenIdx, &value, &valueLen))
 
-    parsed_json_t parsedJson = {false};
-    CHECK_PARSER_ERR(json_parse(&parsedJson, (char *) argumentCtx->buffer, argumentCtx->bufferLen));
+    if (maxValueLen > 0 && valueLen > maxValueLen) {
+        return PARSER_UNEXPECTED_BUFFER_END;
+    }
+
+    size_t foldedLen = 0;
+    if (utf8_validate_asciify(value, valueLen, NULL, 0, &foldedLen) != zxerr_ok) {
+        return PARSER_UNEXPECTED_CHARACTERS;
+    }
+
+    if (outValLen < 2 || foldedLen > (uint32_t) (outValLen - 1) * UINT8_MAX) {
+        return PARSER_UNEXPECTED_BUFFER_END;
+    }
 
-    char bufferUI[ARGUMENT_BUFFER_SIZE_STRING];
-    CHECK_PARSER_ERR(json_extractString(bufferUI, sizeof(bufferUI), &parsedJson, 0))
-    pageString(outVal, outValLen, bufferUI, pageIdx, pageCount);
+    if (foldedLen == valueLen) {
+        pageStringExt(outVal, outValLen, value, valueLen, pageIdx, pageCount);
+    } else {
+        pageFoldedString(outVal, outValLen, value, valueLen, (uint16_t) foldedLen, pageIdx, pageCount);
+    }
 
-    // Check requested page is in range
-    if (pageIdx > *pageCount) {
+    // Check requested page is in range, an empty value has no pages
+    if (*pageCount > 0 && pageIdx >= *pageCount) {
         return PARSER_DISPLAY_PAGE_OUT_OF_RANGE;
     }
 
     return PARSER_OK;
 }
 
-parser_error_t parser_printArgumentPublicKey(const parser_context_t *argumentCtx,
+parser_error_t parser_printArgumentString(const parser_context_t *argumentCtx,
                                              char *outVal, uint16_t outValLen,
                                              uint8_t pageIdx, uint8_t *pageCount) {
     MEMZERO(outVal, outValLen);
 
-    parsed_json_t parsedJson = {false};
-    CHECK_PARSER_ERR(json_parse(&parsedJson, (char *) argumentCtx->buffer, argumentCtx->bufferLen));
+    parsed_json_t *parsedJson = NULL;
+    CHECK_PARSER_ERR(parser_scratchJson(&parsedJson))
+    CHECK_PARSER_ERR(parser_jsonParse(parsedJson, argumentCtx));
 
-    char bufferUI[ARGUMENT_BUFFER_SIZE_ACCOUNT_KEY];
-    CHECK_PARSER_ERR(json_extractString(bufferUI, sizeof(bufferUI), &parsedJson, 0))
-    pageString(outVal, outValLen, bufferUI, pageIdx, pageCount);
+    return parser_pageString(parsedJson, 0, 0, outVal, outValLen, pageIdx, pageCount);
+}
 
-    // Check requested page is in range
-    if (pageIdx > *pageCount) {
-        return PARSER_DISPLAY_PAGE_OUT_OF_RANGE;
-    }
+parser_error_t parser_printArgumentPublicKey(const parser_context_t *argumentCtx,
+                                             char *outVal, uint16_t outValLen,
+                                             uint8_t pageIdx, uint8_t *pageCount) {
+    MEMZERO(outVal, outValLen);
 
-    return PARSER_OK;
+    parsed_json_t *parsedJson = NULL;
+    CHECK_PARSER_ERR(parser_scratchJson(&parsedJson))
+    CHECK_PARSER_ERR(parser_jsonParse(parsedJson, argumentCtx));
+
+    return parser_pageString(parsedJson, 0, ARGUMENT_BUFFER_SIZE_ACCOUNT_KEY - 1,
+                             outVal, outValLen, pageIdx, pageCount);
 }
 
 parser_error_t parser_printArgumentPublicKeys(const parser_context_t *argumentCtx, uint8_t argumentIndex,
@@ -272,14 +324,16 @@ parser_error_t parser_printArgumentPublicKeys(const parser_context_t *argumentCt
                                               uint8_t pageIdx, uint8_t *pageCount) {
     MEMZERO(outVal, outValLen);
 
-    parsed_json_t parsedJson = {false};
-    CHECK_PARSER_ERR(json_parse(&parsedJson, (char *) argumentCtx->buffer, argumentCtx->bufferLen));
+    parsed_json_t *parsedJson = NULL;
+    CHECK_PARSER_ERR(parser_scratchJson(&parsedJson))
+    CHECK_PARSER_ERR(parser_jsonParse(parsedJson, argumentCtx));
 
     // Estimate number of pages
     uint16_t internalTokenElementIdx;
-    CHECK_PARSER_ERR(json_matchKeyValue(&parsedJson, 0, (char *) "Array", JSMN_ARRAY, &internalTokenElementIdx));
+    CHECK_PARSER_ERR(json_matchKeyValue(parsedJson, 0, (char *) "Array", JSMN_ARRAY, &internalTokenElementIdx));
     uint16_t arrayTokenCount;
-    CHECK_PARSER_ERR(array_get_element_count(&parsedJson, internalTokenElementIdx, &arrayTokenCount));
+    CHECK_PARSER_ERR(parser_chargeArrayWalk(parsedJson, internalTokenElementIdx))
+    CHECK_PARSER_ERR(array_get_element_count(parsedJson, internalTokenElementIdx, &arrayTokenCount));
     if (arrayTokenCount > MAX_JSON_ARRAY_TOKEN_COUNT) {  //indirectly limits the maximum number of public keys
         return PARSER_UNEXPECTED_NUMBER_ITEMS;
     }
@@ -287,17 +341,10 @@ parser_error_t parser_printArgumentPublicKeys(const parser_context_t *argumentCt
     zemu_log_stack("PublicKeys");
 
     uint16_t arrayElementToken;
-    char bufferUI[ARGUMENT_BUFFER_SIZE_ACCOUNT_KEY];
-    CHECK_PARSER_ERR(array_get_nth_element(&parsedJson, internalTokenElementIdx, argumentIndex, &arrayElementToken))
-    CHECK_PARSER_ERR(json_extractString(bufferUI, sizeof(bufferUI), &parsedJson, arrayElementToken))
-    pageString(outVal, outValLen, bufferUI, pageIdx, pageCount);
-
-    // Check requested page is in range
-    if (pageIdx > *pageCount) {
-        return PARSER_DISPLAY_PAGE_OUT_OF_RANGE;
-    }
-
-    return PARSER_OK;
+    CHECK_PARSER_ERR(parser_chargeArrayWalk(parsedJson, internalTokenElementIdx))
+    CHECK_PARSER_ERR(array_get_nth_element(parsedJson, internalTokenElementIdx, argumentIndex, &arrayElementToken))
+    return parser_pageString(parsedJson, arrayElementToken, ARGUMENT_BUFFER_SIZE_ACCOUNT_KEY - 1,
+                             outVal, outValLen, pageIdx, pageCount);
 }
 
 parser_error_t parser_printArgumentOptionalPublicKeys(const parser_context_t *argumentCtx, uint8_t argumentIndex,
@@ -305,12 +352,13 @@ parser_error_t parser_printArgumentOptionalPublicKeys(const parser_context_t *ar
                                               uint8_t pageIdx, uint8_t *pageCount) {
     MEMZERO(outVal, outValLen);
 
-    parsed_json_t parsedJson = {false};
-    CHECK_PARSER_ERR(json_parse(&parsedJson, (char *) argumentCtx->buffer, argumentCtx->bufferLen));
+    parsed_json_t *parsedJson = NULL;
+    CHECK_PARSER_ERR(parser_scratchJson(&parsedJson))
+    CHECK_PARSER_ERR(parser_jsonParse(parsedJson, argumentCtx));
 
     // Estimate number of pages
     uint16_t internalTokenElementIdx;
-    CHECK_PARSER_ERR(json_matchOptionalArray(&parsedJson, 0, &internalTokenElementIdx));
+    CHECK_PARSER_ERR(json_matchOptionalArray(parsedJson, 0, &internalTokenElementIdx));
     if (internalTokenElementIdx == JSON_MATCH_VALUE_IDX_NONE) {
         if (outValLen < 5) {
             return  PARSER_UNEXPECTED_BUFFER_END;
@@ -320,7 +368,8 @@ parser_error_t parser_printArgumentOptionalPublicKeys(const parser_context_t *ar
     }
     else {
         uint16_t arrayTokenCount;
-        CHECK_PARSER_ERR(array_get_element_count(&parsedJson, internalTokenElementIdx, &arrayTokenCount));
+        CHECK_PARSER_ERR(parser_chargeArrayWalk(parsedJson, internalTokenElementIdx))
+        CHECK_PARSER_ERR(array_get_element_count(parsedJson, internalTokenElementIdx, &arrayTokenCount));
         if (arrayTokenCount > MAX_JSON_ARRAY_TOKEN_COUNT) { //indirectly limits the maximum number of public keys
             return PARSER_UNEXPECTED_NUMBER_ITEMS;
         }
@@ -328,15 +377,10 @@ parser_error_t parser_printArgumentOptionalPublicKeys(const parser_context_t *ar
         zemu_log_stack("PublicKeys");
 
         uint16_t arrayElementToken;
-        char bufferUI[ARGUMENT_BUFFER_SIZE_ACCOUNT_KEY];
-        CHECK_PARSER_ERR(array_get_nth_element(&parsedJson, internalTokenElementIdx, argumentIndex, &arrayElementToken))
-        CHECK_PARSER_ERR(json_extractString(bufferUI, sizeof(bufferUI), &parsedJson, arrayElementToken))
-        pageString(outVal, outValLen, bufferUI, pageIdx, pageCount);
-
-        // Check requested page is in range
-        if (pageIdx > *pageCount) {
-            return PARSER_DISPLAY_PAGE_OUT_OF_RANGE;
-        }
+        CHECK_PARSER_ERR(parser_chargeArrayWalk(parsedJson, internalTokenElementIdx))
+        CHECK_PARSER_ERR(array_get_nth_element(parsedJson, internalTokenElementIdx, argumentIndex, &arrayElementToken))
+        CHECK_PARSER_ERR(parser_pageString(parsedJson, arrayElementToken, ARGUMENT_BUFFER_SIZE_ACCOUNT_KEY - 1,
+                                           outVal, outValLen, pageIdx, pageCount))
     }
 
     return PARSER_OK;
@@ -349,7 +393,7 @@ parser_error_t parser_printBlockId(const flow_reference_block_id_t *v,
         return PARSER_INVALID_ADDRESS;
     }
 
-    char outBuffer[100];
+    char outBuffer[2 * 32 + 1];
     MEMZERO(outBuffer, sizeof(outBuffer));
 
     if (array_to_hexstr(outBuffer, sizeof(outBuffer), v->ctx.buffer, v->ctx.bufferLen) != 64) {
@@ -363,7 +407,8 @@ parser_error_t parser_printBlockId(const flow_reference_block_id_t *v,
 parser_error_t parser_printGasLimit(const flow_gaslimit_t *v,
                                     char *outVal, uint16_t outValLen,
                                     uint8_t pageIdx, uint8_t *pageCount) {
-    char outBuffer[100];
+    // UINT64_MAX has 20 digits
+    char outBuffer[21];
     MEMZERO(outBuffer, sizeof(outBuffer));
 
     if (uint64_to_str(outBuffer, sizeof(outBuffer), *v) != NULL) {
@@ -381,7 +426,7 @@ __Z_INLINE parser_error_t parser_printPropKeyAddr(const flow_proposal_key_addres
         return PARSER_INVALID_ADDRESS;
     }
 
-    char outBuffer[100];
+    char outBuffer[2 * 8 + 1];
     MEMZERO(outBuffer, sizeof(outBuffer));
 
     if (array_to_hexstr(outBuffer, sizeof(outBuffer), v->ctx.buffer, v->ctx.bufferLen) != 16) {
@@ -395,7 +440,8 @@ __Z_INLINE parser_error_t parser_printPropKeyAddr(const flow_proposal_key_addres
 parser_error_t parser_printPropKeyId(const flow_proposal_keyid_t *v,
                                      char *outVal, uint16_t outValLen,
                                      uint8_t pageIdx, uint8_t *pageCount) {
-    char outBuffer[100];
+    // UINT64_MAX has 20 digits
+    char outBuffer[21];
     MEMZERO(outBuffer, sizeof(outBuffer));
 
     if (uint64_to_str(outBuffer, sizeof(outBuffer), *v) != NULL) {
@@ -409,7 +455,8 @@ parser_error_t parser_printPropKeyId(const flow_proposal_keyid_t *v,
 parser_error_t parser_printPropSeqNum(const flow_proposal_key_sequence_number_t *v,
                                       char *outVal, uint16_t outValLen,
                                       uint8_t pageIdx, uint8_t *pageCount) {
-    char outBuffer[100];
+    // UINT64_MAX has 20 digits
+    char outBuffer[21];
     MEMZERO(outBuffer, sizeof(outBuffer));
 
     if (uint64_to_str(outBuffer, sizeof(outBuffer), *v) != NULL) {
@@ -427,7 +474,7 @@ parser_error_t parser_printPayer(const flow_payer_t *v,
         return PARSER_INVALID_ADDRESS;
     }
 
-    char outBuffer[100];
+    char outBuffer[2 * 8 + 1];
     MEMZERO(outBuffer, sizeof(outBuffer));
 
     if (array_to_hexstr(outBuffer, sizeof(outBuffer), v->ctx.buffer, v->ctx.bufferLen) != 16) {
@@ -445,7 +492,7 @@ parser_error_t parser_printAuthorizer(const flow_proposal_authorizer_t *v,
         return PARSER_INVALID_ADDRESS;
     }
 
-    char outBuffer[100];
+    char outBuffer[2 * 8 + 1];
     MEMZERO(outBuffer, sizeof(outBuffer));
 
     if (array_to_hexstr(outBuffer, sizeof(outBuffer), v->ctx.buffer, v->ctx.bufferLen) != 16) {
@@ -2909,11 +2956,11 @@ parser_error_t parser_getItemTransferTopShotMoment(const parser_context_t *ctx,
 }
 
 
-parser_error_t parser_getItem(const parser_context_t *ctx,
-                              uint16_t displayIdx,
-                              char *outKey, uint16_t outKeyLen,
-                              char *outVal, uint16_t outValLen,
-                              uint8_t pageIdx, uint8_t *pageCount) {
+static parser_error_t _getItem(const parser_context_t *ctx,
+                               uint16_t displayIdx,
+                               char *outKey, uint16_t outKeyLen,
+                               char *outVal, uint16_t outValLen,
+                               uint8_t pageIdx, uint8_t *pageCount) {
     MEMZERO(outKey, outKeyLen);
     MEMZERO(outVal, outValLen);
     snprintf(outKey, outKeyLen, "? %d", displayIdx);
@@ -2927,6 +2974,7 @@ parser_error_t parser_getItem(const parser_context_t *ctx,
     if (displayIdx < 0 || displayIdx >= numItems) {
         return PARSER_NO_DATA;
     }
+    CHECK_PARSER_ERR(parser_chargeWork(0, 0, 1))
     *pageCount = 1;
 
     switch (parser_tx_obj.script.type) {
@@ -3062,3 +3110,14 @@ parser_error_t parser_getItem(const parser_context_t *ctx,
 
     return PARSER_UNEXPECTED_SCRIPT;
 }
+
+parser_error_t parser_getItem(const parser_context_t *ctx,
+                              uint16_t displayIdx,
+                              char *outKey, uint16_t outKeyLen,
+                              char *outVal, uint16_t outValLen,
+                              uint8_t pageIdx, uint8_t *pageCount) {
+    zb_mark_t mark;
+    parser_scratchBegin(&mark);
+    return parser_scratchEnd(mark, _getItem(ctx, displayIdx, outKey, outKeyLen, outVal, outValLen,
+                                            pageIdx, pageCount));
+}
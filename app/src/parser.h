@@ -37,6 +37,14 @@ parser_error_t parser_validate(const parser_context_t *ctx);
 //// returns the number of items in the current parsing context
 parser_error_t parser_getNumItems(const parser_context_t *ctx, uint8_t *num_items);
 
+// limits the work units (see parser_getWorkUnits) parse, validate and getItem may spend per transaction, 0 disables the limit
+void parser_setWorkBudget(uint32_t budget);
+
+// returns the work done since the last parser_parse
+void parser_getWork(parser_work_t *work);
+
+uint32_t parser_getWorkUnits(const parser_work_t *work);
+
 // retrieves a readable output for each field / page
 parser_error_t parser_getItem(const parser_context_t *ctx,
                               uint16_t displayIdx,
@@ -44,6 +52,16 @@ parser_error_t parser_getItem(const parser_context_t *ctx,
                               char *outVal, uint16_t outValLen,
                               uint8_t pageIdx, uint8_t *pageCount);
 
+// returns the decoded argIndex-th argument of the last parsed transaction, number is set when value->hasValue
+parser_error_t parser_getArgumentValue(uint8_t argIndex, flow_argument_value_t *value, uint64_t *number);
+
+// decodes the Address, UFix64 (scaled by 10^8) or UIntN the argument at argCtx holds
+parser_error_t parser_argumentNumber(const parser_context_t *argCtx, const flow_argument_value_t *value,
+                                     uint64_t *number);
+
+// formats a decoded Address, UFix64 or UIntN argument the same way it is shown on screen
+parser_error_t parser_formatArgumentValue(const parser_context_t *argCtx, const flow_argument_value_t *value,
+                                         char *outVal, uint16_t outValLen);
 
 ////for testing purposes
 parser_error_t parser_printArgumentOptionalDelegatorID(const flow_argument_list_t *v,
@@ -51,6 +69,10 @@ parser_error_t parser_printArgumentOptionalDelegatorID(const flow_argument_list_
                                                char *outVal, uint16_t outValLen,
                                                uint8_t pageIdx, uint8_t *pageCount);
 
+parser_error_t parser_printArgumentString(const parser_context_t *argumentCtx,
+                                         char *outVal, uint16_t outValLen,
+                                         uint8_t pageIdx, uint8_t *pageCount);
+
 parser_error_t parser_printArgumentOptionalPublicKeys(const parser_context_t *argumentCtx, uint8_t argumentIndex,
                                               char *outVal, uint16_t outValLen,
                                               uint8_t pageIdx, uint8_t *pageCount);
@@ -66,6 +66,8 @@ typedef enum {
     PARSER_UNEXPECTED_FIELD,
     PARSER_VALUE_OUT_OF_RANGE,
     PARSER_INVALID_ADDRESS,
+    PARSER_WORK_BUDGET_EXCEEDED,
+    PARSER_NO_MEMORY,
     // Context related errors
     PARSER_CONTEXT_MISMATCH,
     PARSER_CONTEXT_UNEXPECTED_SIZE,
@@ -82,6 +84,13 @@ typedef struct {
     uint16_t offset;
 } parser_context_t;
 
+// Work done since the last parser_parse
+typedef struct {
+    uint32_t tokensScanned;
+    uint32_t bytesHashed;
+    uint32_t itemsRendered;
+} parser_work_t;
+
 #ifdef __cplusplus
 }
 #endif
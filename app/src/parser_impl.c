@@ -20,9 +20,19 @@
 #include "parser_txdef.h"
 #include "app_mode.h"
 #include "rlp.h"
+#include "flow_address.h"
 
 parser_tx_t parser_tx_obj;
 
+static parser_work_t parser_work;
+static uint32_t parser_work_budget = 0;
+
+_Static_assert(sizeof(parsed_json_t) + sizeof(uint32_t) <= ZB_ARENA_SIZE, "parsed_json_t does not fit the zbuffer arena");
+
+static parsed_json_t *scratch_json = NULL;
+// Arena position before scratch_json was allocated
+static zb_mark_t scratch_json_mark;
+
 #define CHECK_KIND(KIND, EXPECTED_KIND) \
     if (KIND != EXPECTED_KIND) { return PARSER_RLP_ERROR_INVALID_KIND; }
 
@@ -48,6 +58,86 @@ parser_error_t parser_init(parser_context_t *ctx, const uint8_t *buffer, uint16_
     return PARSER_OK;
 }
 
+void parser_resetWork(void) {
+    MEMZERO(&parser_work, sizeof(parser_work));
+}
+
+void parser_setWorkBudget(uint32_t budget) {
+    parser_work_budget = budget;
+}
+
+void parser_getWork(parser_work_t *work) {
+    MEMCPY(work, &parser_work, sizeof(parser_work_t));
+}
+
+__Z_INLINE uint32_t saturatingAdd(uint32_t a, uint32_t b) {
+    return (a > UINT32_MAX - b) ? UINT32_MAX : a + b;
+}
+
+uint32_t parser_getWorkUnits(const parser_work_t *work) {
+    // a hash block costs roughly as much as scanning a token
+    uint32_t units = work->tokensScanned;
+    units = saturatingAdd(units, work->bytesHashed / 64 + (work->bytesHashed % 64 != 0));
+    units = saturatingAdd(units, work->itemsRendered);
+    return units;
+}
+
+parser_error_t parser_chargeWork(uint32_t tokensScanned, uint32_t bytesHashed, uint32_t itemsRendered) {
+    parser_work.tokensScanned = saturatingAdd(parser_work.tokensScanned, tokensScanned);
+    parser_work.bytesHashed = saturatingAdd(parser_work.bytesHashed, bytesHashed);
+    parser_work.itemsRendered = saturatingAdd(parser_work.itemsRendered, itemsRendered);
+
+    if (parser_work_budget != 0 && parser_getWorkUnits(&parser_work) > parser_work_budget) {
+        return PARSER_WORK_BUDGET_EXCEEDED;
+    }
+
+    return PARSER_OK;
+}
+
+parser_error_t parser_jsonParse(parsed_json_t *parsedJson, const parser_context_t *ctx) {
+    // Any parse scans at least one token, do not run the tokenizer when nothing is left to spend
+    if (parser_work_budget != 0 && parser_getWorkUnits(&parser_work) >= parser_work_budget) {
+        return PARSER_WORK_BUDGET_EXCEEDED;
+    }
+    CHECK_PARSER_ERR(json_parse(parsedJson, (const char *) ctx->buffer, ctx->bufferLen))
+    return parser_chargeWork(parsedJson->numberOfTokens, 0, 0);
+}
+
+parser_error_t parser_chargeArrayWalk(const parsed_json_t *parsedJson, uint16_t arrayTokenIdx) {
+    if (arrayTokenIdx >= parsedJson->numberOfTokens) {
+        return PARSER_NO_DATA;
+    }
+    return parser_chargeWork(parsedJson->numberOfTokens - arrayTokenIdx, 0, 0);
+}
+
+void parser_scratchBegin(zb_mark_t *mark) {
+    zb_mark(mark);
+}
+
+parser_error_t parser_scratchEnd(zb_mark_t mark, parser_error_t err) {
+    if (scratch_json != NULL && scratch_json_mark.top >= mark.top) {
+        scratch_json = NULL;
+    }
+    if (zb_release(mark) != zb_no_error && err == PARSER_OK) {
+        return PARSER_UNEXPECTED_ERROR;
+    }
+    return err;
+}
+
+parser_error_t parser_scratchJson(parsed_json_t **json) {
+    *json = NULL;
+    if (scratch_json == NULL) {
+        zb_mark(&scratch_json_mark);
+        if (zb_alloc(sizeof(parsed_json_t), (void **) &scratch_json) != zb_no_error) {
+            return PARSER_NO_MEMORY;
+        }
+    } else {
+        MEMZERO(scratch_json, sizeof(parsed_json_t));
+    }
+    *json = scratch_json;
+    return PARSER_OK;
+}
+
 const char *parser_getErrorDescription(parser_error_t err) {
     switch (err) {
         // General errors
@@ -96,6 +186,10 @@ const char *parser_getErrorDescription(parser_error_t err) {
             return "Value out of range";
         case PARSER_INVALID_ADDRESS:
             return "Invalid address format";
+        case PARSER_WORK_BUDGET_EXCEEDED:
+            return "Work budget exceeded";
+        case PARSER_NO_MEMORY:
+            return "Not enough scratch memory";
             /////////// Context specific
         case PARSER_CONTEXT_MISMATCH:
             return "context prefix is invalid";
@@ -337,10 +431,400 @@ parser_error_t json_extractString(char *outVal, uint16_t outValLen, parsed_json_
     return PARSER_OK;
 }
 
+parser_error_t json_validateDisplayString(parsed_json_t *parsedJson, uint16_t tokenIdx) {
+    CHECK_PARSER_ERR(json_validateToken(parsedJson, tokenIdx))
+
+    const jsmntok_t token = parsedJson->tokens[tokenIdx];
+    if (token.type != JSMN_STRING) {
+        return PARSER_UNEXPECTED_TYPE;
+    }
+
+    // Control characters cannot be displayed
+    for (int32_t i = token.start; i < token.end; i++) {
+        const uint8_t c = (uint8_t) parsedJson->buffer[i];
+        if (c < 32 || c == 0x7F) {
+            return PARSER_UNEXPECTED_CHARACTERS;
+        }
+    }
+
+    return PARSER_OK;
+}
+
+parser_error_t json_getStringSpan(parsed_json_t *parsedJson, uint16_t tokenIdx,
+                                  const char **value, uint16_t *valueLen) {
+    *value = NULL;
+    *valueLen = 0;
+
+    uint16_t internalTokenElemIdx;
+    CHECK_PARSER_ERR(json_matchKeyValue(
+            parsedJson, tokenIdx, (char *) "String", JSMN_STRING, &internalTokenElemIdx))
+    CHECK_PARSER_ERR(json_validateDisplayString(parsedJson, internalTokenElemIdx))
+
+    const jsmntok_t token = parsedJson->tokens[internalTokenElemIdx];
+    *value = parsedJson->buffer + token.start;
+    *valueLen = token.end - token.start;
+
+    return PARSER_OK;
+}
+
+parser_error_t chainIDFromAddress(uint64_t address, chain_id_e *chainID) {
+    return flowAddress_chainID(address, chainID);
+}
+
+parser_error_t json_readArgumentType(parsed_json_t *parsedJson, uint16_t tokenIdx, argument_type_e *type) {
+    *type = ARGUMENT_TYPE_UNKNOWN;
+    CHECK_PARSER_ERR(json_validateToken(parsedJson, tokenIdx))
+
+    const jsmntok_t token = parsedJson->tokens[tokenIdx];
+    if (token.type != JSMN_STRING) {
+        return PARSER_UNEXPECTED_TYPE;
+    }
+
+    struct known_argument_type_entry {
+        argument_type_e type;
+        char *name;
+    };
+
+    const struct known_argument_type_entry KNOWN_ARGUMENT_TYPES[] = {
+        {ARGUMENT_TYPE_STRING, "String"},
+        {ARGUMENT_TYPE_ADDRESS, "Address"},
+        {ARGUMENT_TYPE_UFIX64, "UFix64"},
+        {ARGUMENT_TYPE_UINT8, "UInt8"},
+        {ARGUMENT_TYPE_UINT16, "UInt16"},
+        {ARGUMENT_TYPE_UINT32, "UInt32"},
+        {ARGUMENT_TYPE_UINT64, "UInt64"},
+        {ARGUMENT_TYPE_OPTIONAL, "Optional"},
+        {ARGUMENT_TYPE_ARRAY, "Array"},
+        // sentinel, do not remove
+        {0, NULL}
+    };
+
+    const uint16_t tokenLen = token.end - token.start;
+    int i = 0;
+    while (KNOWN_ARGUMENT_TYPES[i].name) {
+        const char *name = PIC(KNOWN_ARGUMENT_TYPES[i].name);
+        if (strlen(name) == tokenLen && MEMCMP(name, parsedJson->buffer + token.start, tokenLen) == 0) {
+            *type = KNOWN_ARGUMENT_TYPES[i].type;
+            return PARSER_OK;
+        }
+        i++;
+    }
+
+    // Other cadence types are accepted but not decoded
+    return PARSER_OK;
+}
+
+// Numbers are decoded from the text of their json string. Arguments only keep where that text is
+// and decode it again when the value is needed.
+static parser_error_t json_readStringLiteral(parsed_json_t *parsedJson, uint16_t tokenIdx,
+                                             const char **literal, uint16_t *literalLen) {
+    *literal = NULL;
+    *literalLen = 0;
+    CHECK_PARSER_ERR(json_validateToken(parsedJson, tokenIdx))
+
+    const jsmntok_t token = parsedJson->tokens[tokenIdx];
+    if (token.type != JSMN_STRING) {
+        return PARSER_UNEXPECTED_TYPE;
+    }
+
+    *literal = parsedJson->buffer + token.start;
+    *literalLen = token.end - token.start;
+    return PARSER_OK;
+}
+
+static parser_error_t readUIntLiteral(const char *p, uint16_t len, uint64_t maxValue, uint64_t *value) {
+    *value = 0;
+    if (len == 0) {
+        return PARSER_UNEXPECTED_VALUE;
+    }
+
+    for (uint16_t i = 0; i < len; i++) {
+        const char c = p[i];
+        if (c < '0' || c > '9') {
+            return PARSER_UNEXPECTED_CHARACTERS;
+        }
+        const uint8_t digit = c - '0';
+        if (*value > (maxValue - digit) / 10) {
+            return PARSER_VALUE_OUT_OF_RANGE;
+        }
+        *value = *value * 10 + digit;
+    }
+
+    return PARSER_OK;
+}
+
+static parser_error_t readUFix64Literal(const char *p, uint16_t len, uint64_t *value) {
+    *value = 0;
+
+    // Expected syntax is [0-9]+\.[0-9]{1,8}
+    int32_t dotPosition = -1;
+    for (int32_t i = 0; i < len; i++) {
+        const char c = p[i];
+        if (c == '.' && dotPosition < 0) {
+            dotPosition = i;
+            continue;
+        }
+        if (c < '0' || c > '9') {
+            return PARSER_UNEXPECTED_CHARACTERS;
+        }
+    }
+
+    if (dotPosition <= 0) {
+        return PARSER_UNEXPECTED_VALUE;
+    }
+
+    const int32_t decimals = len - dotPosition - 1;
+    if (decimals < 1 || decimals > UFIX64_DECIMALS) {
+        return PARSER_UNEXPECTED_VALUE;
+    }
+
+    for (int32_t i = 0; i < len; i++) {
+        if (i == dotPosition) {
+            continue;
+        }
+        const uint8_t digit = p[i] - '0';
+        if (*value > (UINT64_MAX - digit) / 10) {
+            return PARSER_VALUE_OUT_OF_RANGE;
+        }
+        *value = *value * 10 + digit;
+    }
+
+    for (int32_t i = decimals; i < UFIX64_DECIMALS; i++) {
+        if (*value > UINT64_MAX / 10) {
+            return PARSER_VALUE_OUT_OF_RANGE;
+        }
+        *value *= 10;
+    }
+
+    return PARSER_OK;
+}
+
+__Z_INLINE parser_error_t hexValue(char c, uint8_t *out) {
+    if (c >= '0' && c <= '9') {
+        *out = c - '0';
+        return PARSER_OK;
+    }
+    if (c >= 'a' && c <= 'f') {
+        *out = c - 'a' + 10;
+        return PARSER_OK;
+    }
+    if (c >= 'A' && c <= 'F') {
+        *out = c - 'A' + 10;
+        return PARSER_OK;
+    }
+    return PARSER_UNEXPECTED_CHARACTERS;
+}
+
+static parser_error_t readAddressLiteral(const char *p, uint16_t len, uint64_t *address) {
+    *address = 0;
+
+    // 0x prefix followed by exactly 16 hex digits, the way addresses are shown
+    const uint16_t digits = 2 * sizeof(uint64_t);
+    if (len != 2 + digits || p[0] != '0' || p[1] != 'x') {
+        return PARSER_INVALID_ADDRESS;
+    }
+
+    for (uint16_t i = 0; i < digits; i++) {
+        uint8_t nibble = 0;
+        CHECK_PARSER_ERR(hexValue(p[2 + i], &nibble))
+        *address = (*address << 4u) | nibble;
+    }
+
+    chain_id_e chainID;
+    if (chainIDFromAddress(*address, &chainID) != PARSER_OK) {
+        return PARSER_INVALID_ADDRESS;
+    }
+
+    return PARSER_OK;
+}
+
+static parser_error_t readNumberLiteral(argument_type_e type, const char *p, uint16_t len, uint64_t *value) {
+    switch (type) {
+        case ARGUMENT_TYPE_UFIX64:
+            return readUFix64Literal(p, len, value);
+        case ARGUMENT_TYPE_ADDRESS:
+            return readAddressLiteral(p, len, value);
+        case ARGUMENT_TYPE_UINT8:
+            return readUIntLiteral(p, len, UINT8_MAX, value);
+        case ARGUMENT_TYPE_UINT16:
+            return readUIntLiteral(p, len, UINT16_MAX, value);
+        case ARGUMENT_TYPE_UINT32:
+            return readUIntLiteral(p, len, UINT32_MAX, value);
+        case ARGUMENT_TYPE_UINT64:
+            return readUIntLiteral(p, len, UINT64_MAX, value);
+        default:
+            *value = 0;
+            return PARSER_UNEXPECTED_TYPE;
+    }
+}
+
+parser_error_t json_readUInt(parsed_json_t *parsedJson, uint16_t tokenIdx, uint64_t maxValue, uint64_t *value) {
+    *value = 0;
+    const char *literal = NULL;
+    uint16_t literalLen = 0;
+    CHECK_PARSER_ERR(json_readStringLiteral(parsedJson, tokenIdx, &literal, &literalLen))
+    return readUIntLiteral(literal, literalLen, maxValue, value);
+}
+
+parser_error_t json_readUFix64(parsed_json_t *parsedJson, uint16_t tokenIdx, uint64_t *value) {
+    *value = 0;
+    const char *literal = NULL;
+    uint16_t literalLen = 0;
+    CHECK_PARSER_ERR(json_readStringLiteral(parsedJson, tokenIdx, &literal, &literalLen))
+    return readUFix64Literal(literal, literalLen, value);
+}
+
+parser_error_t json_readAddress(parsed_json_t *parsedJson, uint16_t tokenIdx, uint64_t *address) {
+    *address = 0;
+    const char *literal = NULL;
+    uint16_t literalLen = 0;
+    CHECK_PARSER_ERR(json_readStringLiteral(parsedJson, tokenIdx, &literal, &literalLen))
+    return readAddressLiteral(literal, literalLen, address);
+}
+
+// Matches {"type": <type>, "value": <value>} at tokenIdx
+static parser_error_t json_matchTypedValue(parsed_json_t *parsedJson, uint16_t tokenIdx,
+                                           argument_type_e *type, uint16_t *valueTokenIdx) {
+    CHECK_PARSER_ERR(json_validateToken(parsedJson, tokenIdx))
+
+    if (!(tokenIdx + 4 < parsedJson->numberOfTokens)) {
+        // we need this token and 4 more
+        return PARSER_JSON_INVALID_TOKEN_IDX;
+    }
+
+    if (parsedJson->tokens[tokenIdx].type != JSMN_OBJECT) {
+        return PARSER_UNEXPECTED_TYPE;
+    }
+
+    if (parsedJson->tokens[tokenIdx].size != 2) {
+        return PARSER_UNEXPECTED_NUMBER_ITEMS;
+    }
+
+    CHECK_PARSER_ERR(json_matchToken(parsedJson, tokenIdx + 1, (char *) "type"))
+    CHECK_PARSER_ERR(json_readArgumentType(parsedJson, tokenIdx + 2, type))
+    CHECK_PARSER_ERR(json_matchToken(parsedJson, tokenIdx + 3, (char *) "value"))
+
+    *valueTokenIdx = tokenIdx + 4;
+    return PARSER_OK;
+}
+
+// Decodes the value of a non optional argument
+static parser_error_t json_readArgumentContent(parsed_json_t *parsedJson, argument_type_e type,
+                                               uint16_t valueTokenIdx, flow_argument_value_t *v) {
+    switch (type) {
+        case ARGUMENT_TYPE_UFIX64:
+        case ARGUMENT_TYPE_ADDRESS:
+        case ARGUMENT_TYPE_UINT8:
+        case ARGUMENT_TYPE_UINT16:
+        case ARGUMENT_TYPE_UINT32:
+        case ARGUMENT_TYPE_UINT64: {
+            const char *literal = NULL;
+            uint16_t literalLen = 0;
+            uint64_t value = 0;
+            CHECK_PARSER_ERR(json_readStringLiteral(parsedJson, valueTokenIdx, &literal, &literalLen))
+            const parser_error_t err = readNumberLiteral(type, literal, literalLen, &value);
+            if (type == ARGUMENT_TYPE_UFIX64 && err == PARSER_VALUE_OUT_OF_RANGE) {
+                // Well formed literal that does not fit in 64 bits, it can only be shown verbatim
+                return PARSER_OK;
+            }
+            CHECK_PARSER_ERR(err)
+            v->valueOffset = (uint16_t) (literal - parsedJson->buffer);
+            v->valueLen = literalLen;
+            v->hasValue = true;
+            return PARSER_OK;
+        }
+        case ARGUMENT_TYPE_STRING:
+            return json_validateDisplayString(parsedJson, valueTokenIdx);
+        case ARGUMENT_TYPE_ARRAY: {
+            const jsmntok_t arrayToken = parsedJson->tokens[valueTokenIdx];
+            if (arrayToken.type != JSMN_ARRAY) {
+                return PARSER_UNEXPECTED_TYPE;
+            }
+            // Every element can be shown, not only the first one that gives the type.
+            // Elements are walked once, each one is left by skipping the tokens it encloses.
+            v->elementCount = 0;
+            uint16_t elementTokenIdx = valueTokenIdx + 1;
+            while (elementTokenIdx < parsedJson->numberOfTokens &&
+                   parsedJson->tokens[elementTokenIdx].start < arrayToken.end) {
+                uint16_t elementValueTokenIdx;
+                argument_type_e elementType;
+                CHECK_PARSER_ERR(json_matchTypedValue(parsedJson, elementTokenIdx,
+                                                      &elementType, &elementValueTokenIdx))
+                if (v->elementCount == 0) {
+                    v->innerType = elementType;
+                } else if (elementType != v->innerType) {
+                    // Cadence arrays hold a single type, the first element gives it for all of them
+                    return PARSER_UNEXPECTED_TYPE;
+                }
+                if (elementType == ARGUMENT_TYPE_STRING) {
+                    CHECK_PARSER_ERR(json_validateDisplayString(parsedJson, elementValueTokenIdx))
+                }
+                v->elementCount++;
+
+                const int32_t elementEnd = parsedJson->tokens[elementTokenIdx].end;
+                while (elementTokenIdx < parsedJson->numberOfTokens &&
+                       parsedJson->tokens[elementTokenIdx].start < elementEnd) {
+                    elementTokenIdx++;
+                }
+            }
+            return parser_chargeWork(elementTokenIdx - valueTokenIdx, 0, 0);
+        }
+        case ARGUMENT_TYPE_OPTIONAL:
+            // nested optionals are not used by any known template
+            return PARSER_UNEXPECTED_TYPE;
+        case ARGUMENT_TYPE_UNKNOWN:
+        default:
+            return PARSER_OK;
+    }
+}
+
+parser_error_t json_readArgumentValue(parsed_json_t *parsedJson, uint16_t tokenIdx, flow_argument_value_t *v) {
+    MEMZERO(v, sizeof(flow_argument_value_t));
+
+    argument_type_e type;
+    uint16_t valueTokenIdx;
+    CHECK_PARSER_ERR(json_matchTypedValue(parsedJson, tokenIdx, &type, &valueTokenIdx))
+    v->type = type;
+
+    if (type != ARGUMENT_TYPE_OPTIONAL) {
+        return json_readArgumentContent(parsedJson, type, valueTokenIdx, v);
+    }
+
+    if (parsedJson->tokens[valueTokenIdx].type == JSMN_PRIMITIVE) {  //optional null
+        CHECK_PARSER_ERR(json_matchNull(parsedJson, valueTokenIdx))
+        v->isNone = true;
+        return PARSER_OK;
+    }
+
+    argument_type_e innerType;
+    uint16_t innerValueTokenIdx;
+    CHECK_PARSER_ERR(json_matchTypedValue(parsedJson, valueTokenIdx, &innerType, &innerValueTokenIdx))
+
+    // The wrapped type is reported as innerType, keep the array element type out of it
+    CHECK_PARSER_ERR(json_readArgumentContent(parsedJson, innerType, innerValueTokenIdx, v))
+    v->innerType = innerType;
+
+    return PARSER_OK;
+}
+
+parser_error_t parser_argumentNumber(const parser_context_t *argCtx, const flow_argument_value_t *value,
+                                     uint64_t *number) {
+    *number = 0;
+    if (!value->hasValue) {
+        return PARSER_UNEXPECTED_VALUE;
+    }
+    if ((uint32_t) value->valueOffset + value->valueLen > argCtx->bufferLen) {
+        return PARSER_UNEXPECTED_BUFFER_END;
+    }
+
+    const argument_type_e type = value->type == ARGUMENT_TYPE_OPTIONAL ? value->innerType : value->type;
+    return readNumberLiteral(type, (const char *) argCtx->buffer + value->valueOffset, value->valueLen, number);
+}
+
 parser_error_t _matchScriptType(uint8_t scriptHash[32], script_type_e *scriptType) {
     *scriptType = SCRIPT_UNKNOWN;
 
-    char buffer[100];
+    char buffer[2 * CX_SHA256_SIZE + 1];
     MEMZERO(buffer, sizeof(buffer));
 
     // Check it is a known script digest
@@ -504,6 +988,7 @@ parser_error_t _readScript(parser_context_t *c, flow_script_t *v) {
     CTX_CHECK_AND_ADVANCE(c, bytesConsumed)
     CHECK_KIND(kind, RLP_KIND_STRING)
 
+    CHECK_PARSER_ERR(parser_chargeWork(0, v->ctx.bufferLen, 0))
     MEMZERO(v->digest, sizeof(v->digest));
     sha256(v->ctx.buffer, v->ctx.bufferLen, v->digest);
 
@@ -538,6 +1023,32 @@ parser_error_t _readArguments(parser_context_t *c, flow_argument_list_t *v) {
     return PARSER_OK;
 }
 
+parser_error_t _readArgumentValue(const parser_context_t *argCtx, flow_argument_value_t *v) {
+    size_t foldedLen = 0;
+    if (utf8_validate_asciify((const char *) argCtx->buffer, argCtx->bufferLen, NULL, 0, &foldedLen) != zxerr_ok) {
+        return PARSER_UNEXPECTED_CHARACTERS;
+    }
+
+    parsed_json_t *parsedJson = NULL;
+    CHECK_PARSER_ERR(parser_scratchJson(&parsedJson))
+    CHECK_PARSER_ERR(parser_jsonParse(parsedJson, argCtx))
+    CHECK_PARSER_ERR(json_readArgumentValue(parsedJson, 0, v))
+
+    v->validUtf8 = true;
+    v->isAscii = foldedLen == argCtx->bufferLen;
+    return PARSER_OK;
+}
+
+parser_error_t _decodeArguments(flow_argument_list_t *v) {
+    MEMZERO(v->argValue, sizeof(v->argValue));
+
+    for (uint16_t i = 0; i < v->argCount; i++) {
+        CHECK_PARSER_ERR(_readArgumentValue(&v->argCtx[i], &v->argValue[i]))
+    }
+
+    return PARSER_OK;
+}
+
 parser_error_t _readReferenceBlockId(parser_context_t *c, flow_reference_block_id_t *v) {
     rlp_kind_e kind;
     uint32_t bytesConsumed;
@@ -676,6 +1187,7 @@ parser_error_t _read(parser_context_t *c, parser_tx_t *v) {
         // root list should consume the complete buffer
         return PARSER_UNEXPECTED_BUFFER_END;
     }
+    v->envelope = ctx_rootList;
 
     // Consume external list
     CHECK_PARSER_ERR(rlp_decode(&ctx_rootList, &ctx_rootInnerList, &kind, &bytesConsumed))
@@ -685,6 +1197,7 @@ parser_error_t _read(parser_context_t *c, parser_tx_t *v) {
     // Go through the inner list
     CHECK_PARSER_ERR(_readScript(&ctx_rootInnerList, &v->script))
     CHECK_PARSER_ERR(_readArguments(&ctx_rootInnerList, &v->arguments))
+    CHECK_PARSER_ERR(_decodeArguments(&v->arguments))
     CHECK_PARSER_ERR(_readReferenceBlockId(&ctx_rootInnerList, &v->referenceBlockId))
     CHECK_PARSER_ERR(_readGasLimit(&ctx_rootInnerList, &v->gasLimit))
     CHECK_PARSER_ERR(_readProposalKeyAddress(&ctx_rootInnerList, &v->proposalKeyAddress))
@@ -712,20 +1225,22 @@ parser_error_t _validateTx(const parser_context_t *c, const parser_tx_t *v) {
 parser_error_t _countArgumentItems(const flow_argument_list_t *v, uint8_t argumentIndex, 
                                    uint8_t max_number_of_items, uint8_t *number_of_items) {
     *number_of_items = 0;
-    parsed_json_t parsedJson = {false};
+    parsed_json_t *parsedJson = NULL;
+    CHECK_PARSER_ERR(parser_scratchJson(&parsedJson))
 
     if (argumentIndex >= v->argCount) {
         return PARSER_UNEXPECTED_FIELD;
     }
 
     const parser_context_t argCtx = v->argCtx[argumentIndex];
-    CHECK_PARSER_ERR(json_parse(&parsedJson, (char *) argCtx.buffer, argCtx.bufferLen));
+    CHECK_PARSER_ERR(parser_jsonParse(parsedJson, &argCtx));
 
     // Get number of items
     uint16_t internalTokenElementIdx;
-    CHECK_PARSER_ERR(json_matchKeyValue(&parsedJson, 0, (char *) "Array", JSMN_ARRAY, &internalTokenElementIdx));
+    CHECK_PARSER_ERR(json_matchKeyValue(parsedJson, 0, (char *) "Array", JSMN_ARRAY, &internalTokenElementIdx));
     uint16_t arrayTokenCount;
-    CHECK_PARSER_ERR(array_get_element_count(&parsedJson, internalTokenElementIdx, &arrayTokenCount));
+    CHECK_PARSER_ERR(parser_chargeArrayWalk(parsedJson, internalTokenElementIdx))
+    CHECK_PARSER_ERR(array_get_element_count(parsedJson, internalTokenElementIdx, &arrayTokenCount));
     if (arrayTokenCount > max_number_of_items) {
         return PARSER_UNEXPECTED_NUMBER_ITEMS;
     }
@@ -738,17 +1253,18 @@ parser_error_t _countArgumentItems(const flow_argument_list_t *v, uint8_t argume
 parser_error_t _countArgumentOptionalItems(const flow_argument_list_t *v, uint8_t argumentIndex, 
                                            uint8_t max_number_of_items, uint8_t *number_of_items) {
     *number_of_items = 0;
-    parsed_json_t parsedJson = {false};
+    parsed_json_t *parsedJson = NULL;
+    CHECK_PARSER_ERR(parser_scratchJson(&parsedJson))
 
     if (argumentIndex >= v->argCount) {
         return PARSER_UNEXPECTED_FIELD;
     }
 
     const parser_context_t argCtx = v->argCtx[argumentIndex];
-    CHECK_PARSER_ERR(json_parse(&parsedJson, (char *) argCtx.buffer, argCtx.bufferLen));
+    CHECK_PARSER_ERR(parser_jsonParse(parsedJson, &argCtx));
 
     uint16_t internalTokenElementIdx;
-    CHECK_PARSER_ERR(json_matchOptionalArray(&parsedJson, 0, &internalTokenElementIdx));
+    CHECK_PARSER_ERR(json_matchOptionalArray(parsedJson, 0, &internalTokenElementIdx));
     if (internalTokenElementIdx == JSON_MATCH_VALUE_IDX_NONE) {
         *number_of_items = 1;
         return PARSER_OK;
@@ -756,7 +1272,8 @@ parser_error_t _countArgumentOptionalItems(const flow_argument_list_t *v, uint8_
     
     // Get numnber of items
     uint16_t arrayTokenCount;
-    CHECK_PARSER_ERR(array_get_element_count(&parsedJson, internalTokenElementIdx, &arrayTokenCount));
+    CHECK_PARSER_ERR(parser_chargeArrayWalk(parsedJson, internalTokenElementIdx))
+    CHECK_PARSER_ERR(array_get_element_count(parsedJson, internalTokenElementIdx, &arrayTokenCount));
     if (arrayTokenCount > max_number_of_items) {
         return PARSER_UNEXPECTED_NUMBER_ITEMS;
     }
@@ -20,6 +20,7 @@
 #include "crypto.h"
 #include "jsmn.h"
 #include <json/json_parser.h>
+#include "zbuffer.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -34,6 +35,27 @@ parser_error_t _matchScriptType(uint8_t scriptHash[32], script_type_e *scriptTyp
 
 parser_error_t _read(parser_context_t *c, parser_tx_t *v);
 
+// Work accounting, parser_chargeWork fails with PARSER_WORK_BUDGET_EXCEEDED once the budget is spent
+void parser_resetWork(void);
+
+parser_error_t parser_chargeWork(uint32_t tokensScanned, uint32_t bytesHashed, uint32_t itemsRendered);
+
+/// json_parse with its tokens charged, it is not run once the budget is spent
+parser_error_t parser_jsonParse(parsed_json_t *parsedJson, const parser_context_t *ctx);
+
+/// Charges a walk over the array at arrayTokenIdx before it is done, by the tokens that can follow it
+parser_error_t parser_chargeArrayWalk(const parsed_json_t *parsedJson, uint16_t arrayTokenIdx);
+
+// Scratch memory lives in the zbuffer arena. Parser entry points open a scope and release it when they return.
+// Only one argument json is parsed at a time, so every call within a scope shares the same one.
+void parser_scratchBegin(zb_mark_t *mark);
+
+/// Releases the scope opened with mark and passes err through
+parser_error_t parser_scratchEnd(zb_mark_t mark, parser_error_t err);
+
+/// Zeroed json of the current scope, allocated on first use
+parser_error_t parser_scratchJson(parsed_json_t **json);
+
 parser_error_t _validateTx(const parser_context_t *c, const parser_tx_t *v);
 
 parser_error_t _getNumItems(const parser_context_t *c, const parser_tx_t *v, uint8_t *numItems);
@@ -68,6 +90,33 @@ parser_error_t formatStrUInt8AsHex(const char *decStr, char *hexStr);
 
 parser_error_t json_extractString(char *outVal, uint16_t outValLen, parsed_json_t *parsedJson, uint16_t tokenIdx);
 
+//Checks that the token is a string that can be displayed, without control characters
+parser_error_t json_validateDisplayString(parsed_json_t *parsedJson, uint16_t tokenIdx);
+
+//Same match as json_extractString, but returns the span of the value inside the json buffer instead of copying it.
+//Values that can not be displayed are rejected.
+parser_error_t json_getStringSpan(parsed_json_t *parsedJson, uint16_t tokenIdx,
+                                  const char **value, uint16_t *valueLen);
+
+parser_error_t chainIDFromAddress(uint64_t address, chain_id_e *chainID);
+
+//Maps the cadence type name at tokenIdx to argument_type_e. Types not listed are reported as ARGUMENT_TYPE_UNKNOWN.
+parser_error_t json_readArgumentType(parsed_json_t *parsedJson, uint16_t tokenIdx, argument_type_e *type);
+
+//Reads a decimal string, fails with PARSER_VALUE_OUT_OF_RANGE if it exceeds maxValue.
+parser_error_t json_readUInt(parsed_json_t *parsedJson, uint16_t tokenIdx, uint64_t maxValue, uint64_t *value);
+
+//Reads an UFix64 string scaled by 10^UFIX64_DECIMALS.
+parser_error_t json_readUFix64(parsed_json_t *parsedJson, uint16_t tokenIdx, uint64_t *value);
+
+//Reads a 0x prefixed address and checks it belongs to a known chain.
+parser_error_t json_readAddress(parsed_json_t *parsedJson, uint16_t tokenIdx, uint64_t *address);
+
+//Decodes the {"type": ..., "value": ...} argument object at tokenIdx.
+parser_error_t json_readArgumentValue(parsed_json_t *parsedJson, uint16_t tokenIdx, flow_argument_value_t *v);
+
+parser_error_t _decodeArguments(flow_argument_list_t *v);
+
 #ifdef __cplusplus
 }
 #endif
@@ -94,10 +94,47 @@ typedef struct {
     parser_context_t ctx;
 } flow_reference_block_id_t;
 
+typedef enum {
+    ARGUMENT_TYPE_UNKNOWN,
+    ARGUMENT_TYPE_STRING,
+    ARGUMENT_TYPE_ADDRESS,
+    ARGUMENT_TYPE_UFIX64,
+    ARGUMENT_TYPE_UINT8,
+    ARGUMENT_TYPE_UINT16,
+    ARGUMENT_TYPE_UINT32,
+    ARGUMENT_TYPE_UINT64,
+    ARGUMENT_TYPE_OPTIONAL,
+    ARGUMENT_TYPE_ARRAY,
+} argument_type_e;
+
+// UFix64 values are kept as integers scaled by 10^8
+#define UFIX64_DECIMALS 8
+
+// One of these is kept per argument, the types are stored as uint8_t to keep it small
+typedef struct {
+    // argument_type_e
+    uint8_t type;
+    // Optional: wrapped type, Array: type shared by all its elements
+    uint8_t innerType;
+    // Optional holding null
+    bool isNone;
+    // An Address, UFix64 or UIntN (possibly wrapped by an Optional) that parser_argumentNumber decodes
+    bool hasValue;
+    // The raw argument was checked to be well formed UTF-8, isAscii tells if it holds only 7-bit characters
+    bool validUtf8;
+    bool isAscii;
+    // Number of elements of an Array (or of the Array wrapped by an Optional)
+    uint16_t elementCount;
+    // Where the text of the number is in the argument json, hasValue tells it is valid
+    uint16_t valueOffset;
+    uint16_t valueLen;
+} flow_argument_value_t;
+
 typedef struct {
     parser_context_t ctx;
     parser_context_t argCtx[PARSER_MAX_ARGCOUNT];
     uint16_t argCount;
+    flow_argument_value_t argValue[PARSER_MAX_ARGCOUNT];
 } flow_argument_list_t;
 
 typedef uint64_t flow_gaslimit_t;
@@ -134,6 +171,8 @@ typedef struct {
     flow_proposal_key_sequence_number_t  proposalKeySequenceNumber;
     flow_payer_t payer;
     flow_proposal_authorizers_t authorizers;
+    // Content of the root list: the payload and the payload signatures
+    parser_context_t envelope;
 } parser_tx_t;
 
 #ifdef __cplusplus
@@ -0,0 +1,577 @@
+/*******************************************************************************
+*   (c) 2021 Zondax GmbH
+*
+*  Licensed under the Apache License, Version 2.0 (the "License");
+*  you may not use this file except in compliance with the License.
+*  You may obtain a copy of the License at
+*
+*      http://www.apache.org/licenses/LICENSE-2.0
+*
+*  Unless required by applicable law or agreed to in writing, software
+*  distributed under the License is distributed on an "AS IS" BASIS,
+*  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+*  See the License for the specific language governing permissions and
+*  limitations under the License.
+********************************************************************************/
+
+#if !defined(TARGET_NANOS) && !defined(TARGET_NANOX) && !defined(TARGET_NANOS2)
+
+#include "sha256_host.h"
+#include "zxmacros.h"
+
+#if defined(__x86_64__) || defined(__i386__)
+#define SHA256_HOST_X86
+#include <cpuid.h>
+#include <immintrin.h>
+#define SHA256_SHANI_TARGET __attribute__((target("sha,sse4.1,ssse3")))
+#define SHA256_AVX2_TARGET __attribute__((target("avx2")))
+#elif defined(__aarch64__)
+#define SHA256_HOST_ARMV8
+#include <arm_neon.h>
+#if defined(__linux__)
+#include <sys/auxv.h>
+#include <asm/hwcap.h>
+#endif
+#if defined(__clang__)
+#define SHA256_ARMV8_TARGET __attribute__((target("crypto")))
+#else
+#define SHA256_ARMV8_TARGET __attribute__((target("+crypto")))
+#endif
+#endif
+
+static const uint32_t sha256_k[64] = {
+        0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1, 0x923f82a4, 0xab1c5ed5,
+        0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3, 0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174,
+        0xe49b69c1, 0xefbe4786, 0x0fc19dc6, 0x240ca1cc, 0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
+        0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7, 0xc6e00bf3, 0xd5a79147, 0x06ca6351, 0x14292967,
+        0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13, 0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85,
+        0xa2bfe8a1, 0xa81a664b, 0xc24b8b70, 0xc76c51a3, 0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
+        0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a, 0x5b9cca4f, 0x682e6ff3,
+        0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208, 0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2,
+};
+
+static const uint32_t sha256_iv[8] = {
+        0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a, 0x510e527f, 0x9b05688c, 0x1f83d9ab, 0x5be0cd19,
+};
+
+typedef void (*sha256_compress_fn)(uint32_t state[8], const uint8_t *blocks, size_t blockCount);
+typedef void (*sha256_multi_fn)(const uint8_t *const *messages, const size_t *messageLens, size_t count,
+                                uint8_t *digests);
+
+static uint32_t load_be32(const uint8_t *p) {
+    return ((uint32_t) p[0] << 24u) | ((uint32_t) p[1] << 16u) | ((uint32_t) p[2] << 8u) | p[3];
+}
+
+static void store_be32(uint8_t *p, uint32_t v) {
+    p[0] = (uint8_t) (v >> 24u);
+    p[1] = (uint8_t) (v >> 16u);
+    p[2] = (uint8_t) (v >> 8u);
+    p[3] = (uint8_t) v;
+}
+
+// Padding of the last partial block: 0x80, zeros and the bit length, one or two blocks
+static uint8_t sha256_pad(uint8_t tail[2 * SHA256_HOST_BLOCK_SIZE], const uint8_t *rest, size_t restLen,
+                          uint64_t totalLen) {
+    MEMZERO(tail, 2 * SHA256_HOST_BLOCK_SIZE);
+    if (restLen > 0) {
+        MEMCPY(tail, rest, restLen);
+    }
+    tail[restLen] = 0x80;
+    const uint8_t blocks = restLen + 9 > SHA256_HOST_BLOCK_SIZE ? 2 : 1;
+    const uint64_t bitLen = totalLen * 8;
+    store_be32(tail + blocks * SHA256_HOST_BLOCK_SIZE - 8, (uint32_t) (bitLen >> 32u));
+    store_be32(tail + blocks * SHA256_HOST_BLOCK_SIZE - 4, (uint32_t) bitLen);
+    return blocks;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// Portable
+
+#define ROTR32(x, n) (((x) >> (n)) | ((x) << (32u - (n))))
+
+static void sha256_compress_portable(uint32_t state[8], const uint8_t *blocks, size_t blockCount) {
+    for (; blockCount > 0; blockCount--, blocks += SHA256_HOST_BLOCK_SIZE) {
+        uint32_t w[16];
+        for (uint8_t i = 0; i < 16; i++) {
+            w[i] = load_be32(blocks + 4 * i);
+        }
+
+        uint32_t a = state[0], b = state[1], c = state[2], d = state[3];
+        uint32_t e = state[4], f = state[5], g = state[6], h = state[7];
+        for (uint8_t i = 0; i < 64; i++) {
+            // message schedule kept in a 16 word ring
+            if (i >= 16) {
+                const uint32_t w15 = w[(i + 1) & 15u];
+                const uint32_t w2 = w[(i + 14) & 15u];
+                const uint32_t s0 = ROTR32(w15, 7u) ^ ROTR32(w15, 18u) ^ (w15 >> 3u);
+                const uint32_t s1 = ROTR32(w2, 17u) ^ ROTR32(w2, 19u) ^ (w2 >> 10u);
+                w[i & 15u] += s0 + w[(i + 9) & 15u] + s1;
+            }
+            const uint32_t t1 = h + (ROTR32(e, 6u) ^ ROTR32(e, 11u) ^ ROTR32(e, 25u)) + ((e & f) ^ (~e & g)) +
+                                sha256_k[i] + w[i & 15u];
+            const uint32_t t2 = (ROTR32(a, 2u) ^ ROTR32(a, 13u) ^ ROTR32(a, 22u)) + ((a & b) | (c & (a | b)));
+            h = g;
+            g = f;
+            f = e;
+            e = d + t1;
+            d = c;
+            c = b;
+            b = a;
+            a = t1 + t2;
+        }
+        state[0] += a;
+        state[1] += b;
+        state[2] += c;
+        state[3] += d;
+        state[4] += e;
+        state[5] += f;
+        state[6] += g;
+        state[7] += h;
+    }
+}
+
+static void sha256_multi_sequential(const uint8_t *const *messages, const size_t *messageLens, size_t count,
+                                    uint8_t *digests) {
+    for (size_t i = 0; i < count; i++) {
+        sha256_host(messages[i], messageLens[i], digests + i * SHA256_HOST_DIGEST_SIZE);
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// x86: SHA-NI block function and AVX2 8 lane multi buffer
+
+#if defined(SHA256_HOST_X86)
+
+SHA256_SHANI_TARGET
+static void sha256_compress_shani(uint32_t state[8], const uint8_t *blocks, size_t blockCount) {
+    const __m128i byteSwap = _mm_set_epi64x(0x0c0d0e0f08090a0bULL, 0x0405060700010203ULL);
+
+    // the round instructions work on ABEF / CDGH
+    __m128i tmp = _mm_shuffle_epi32(_mm_loadu_si128((const __m128i *) &state[0]), 0xB1);
+    __m128i state1 = _mm_shuffle_epi32(_mm_loadu_si128((const __m128i *) &state[4]), 0x1B);
+    __m128i state0 = _mm_alignr_epi8(tmp, state1, 8);
+    state1 = _mm_blend_epi16(state1, tmp, 0xF0);
+
+    for (; blockCount > 0; blockCount--, blocks += SHA256_HOST_BLOCK_SIZE) {
+        const __m128i abefSave = state0;
+        const __m128i cdghSave = state1;
+        __m128i m[4];
+
+#pragma GCC unroll 16
+        for (uint8_t g = 0; g < 16; g++) {
+            if (g < 4) {
+                m[g] = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i *) (blocks + 16 * g)), byteSwap);
+            }
+            __m128i msg = _mm_add_epi32(m[g & 3u], _mm_loadu_si128((const __m128i *) &sha256_k[4 * g]));
+            state1 = _mm_sha256rnds2_epu32(state1, state0, msg);
+            if (g >= 3 && g < 15) {
+                tmp = _mm_alignr_epi8(m[g & 3u], m[(g - 1) & 3u], 4);
+                m[(g + 1) & 3u] = _mm_sha256msg2_epu32(_mm_add_epi32(m[(g + 1) & 3u], tmp), m[g & 3u]);
+            }
+            msg = _mm_shuffle_epi32(msg, 0x0E);
+            state0 = _mm_sha256rnds2_epu32(state0, state1, msg);
+            if (g >= 1 && g < 13) {
+                m[(g - 1) & 3u] = _mm_sha256msg1_epu32(m[(g - 1) & 3u], m[g & 3u]);
+            }
+        }
+
+        state0 = _mm_add_epi32(state0, abefSave);
+        state1 = _mm_add_epi32(state1, cdghSave);
+    }
+
+    tmp = _mm_shuffle_epi32(state0, 0x1B);
+    state1 = _mm_shuffle_epi32(state1, 0xB1);
+    state0 = _mm_blend_epi16(tmp, state1, 0xF0);
+    state1 = _mm_alignr_epi8(state1, tmp, 8);
+    _mm_storeu_si128((__m128i *) &state[0], state0);
+    _mm_storeu_si128((__m128i *) &state[4], state1);
+}
+
+// Rows of 8 words (one per lane) become 8 words of each lane, and the other way around
+#define TRANSPOSE_8X8(r) do {                                                             \
+    const __m256i t0 = _mm256_unpacklo_epi32(r[0], r[1]);                                 \
+    const __m256i t1 = _mm256_unpackhi_epi32(r[0], r[1]);                                 \
+    const __m256i t2 = _mm256_unpacklo_epi32(r[2], r[3]);                                 \
+    const __m256i t3 = _mm256_unpackhi_epi32(r[2], r[3]);                                 \
+    const __m256i t4 = _mm256_unpacklo_epi32(r[4], r[5]);                                 \
+    const __m256i t5 = _mm256_unpackhi_epi32(r[4], r[5]);                                 \
+    const __m256i t6 = _mm256_unpacklo_epi32(r[6], r[7]);                                 \
+    const __m256i t7 = _mm256_unpackhi_epi32(r[6], r[7]);                                 \
+    const __m256i u0 = _mm256_unpacklo_epi64(t0, t2);                                     \
+    const __m256i u1 = _mm256_unpackhi_epi64(t0, t2);                                     \
+    const __m256i u2 = _mm256_unpacklo_epi64(t1, t3);                                     \
+    const __m256i u3 = _mm256_unpackhi_epi64(t1, t3);                                     \
+    const __m256i u4 = _mm256_unpacklo_epi64(t4, t6);                                     \
+    const __m256i u5 = _mm256_unpackhi_epi64(t4, t6);                                     \
+    const __m256i u6 = _mm256_unpacklo_epi64(t5, t7);                                     \
+    const __m256i u7 = _mm256_unpackhi_epi64(t5, t7);                                     \
+    r[0] = _mm256_permute2x128_si256(u0, u4, 0x20);                                       \
+    r[1] = _mm256_permute2x128_si256(u1, u5, 0x20);                                       \
+    r[2] = _mm256_permute2x128_si256(u2, u6, 0x20);                                       \
+    r[3] = _mm256_permute2x128_si256(u3, u7, 0x20);                                       \
+    r[4] = _mm256_permute2x128_si256(u0, u4, 0x31);                                       \
+    r[5] = _mm256_permute2x128_si256(u1, u5, 0x31);                                       \
+    r[6] = _mm256_permute2x128_si256(u2, u6, 0x31);                                       \
+    r[7] = _mm256_permute2x128_si256(u3, u7, 0x31);                                       \
+} while (0)
+
+#define ROTR256(x, n) _mm256_or_si256(_mm256_srli_epi32((x), (n)), _mm256_slli_epi32((x), 32 - (n)))
+
+// One block of each lane, state is [word][lane]
+SHA256_AVX2_TARGET
+static void sha256_compress_avx2x8(uint32_t state[8][SHA256_HOST_LANES], const uint8_t *const blocks[SHA256_HOST_LANES]) {
+    const __m256i byteSwap = _mm256_set_epi8(12, 13, 14, 15, 8, 9, 10, 11, 4, 5, 6, 7, 0, 1, 2, 3,
+                                             12, 13, 14, 15, 8, 9, 10, 11, 4, 5, 6, 7, 0, 1, 2, 3);
+    __m256i w[16];
+    for (uint8_t half = 0; half < 2; half++) {
+        __m256i r[8];
+        for (uint8_t lane = 0; lane < SHA256_HOST_LANES; lane++) {
+            r[lane] = _mm256_shuffle_epi8(_mm256_loadu_si256((const __m256i *) (blocks[lane] + 32 * half)), byteSwap);
+        }
+        TRANSPOSE_8X8(r);
+        for (uint8_t i = 0; i < 8; i++) {
+            w[8 * half + i] = r[i];
+        }
+    }
+
+    __m256i a = _mm256_loadu_si256((const __m256i *) state[0]);
+    __m256i b = _mm256_loadu_si256((const __m256i *) state[1]);
+    __m256i c = _mm256_loadu_si256((const __m256i *) state[2]);
+    __m256i d = _mm256_loadu_si256((const __m256i *) state[3]);
+    __m256i e = _mm256_loadu_si256((const __m256i *) state[4]);
+    __m256i f = _mm256_loadu_si256((const __m256i *) state[5]);
+    __m256i g = _mm256_loadu_si256((const __m256i *) state[6]);
+    __m256i h = _mm256_loadu_si256((const __m256i *) state[7]);
+
+    for (uint8_t i = 0; i < 64; i++) {
+        if (i >= 16) {
+            const __m256i w15 = w[(i + 1) & 15u];
+            const __m256i w2 = w[(i + 14) & 15u];
+            const __m256i s0 = _mm256_xor_si256(_mm256_xor_si256(ROTR256(w15, 7), ROTR256(w15, 18)),
+                                                _mm256_srli_epi32(w15, 3));
+            const __m256i s1 = _mm256_xor_si256(_mm256_xor_si256(ROTR256(w2, 17), ROTR256(w2, 19)),
+                                                _mm256_srli_epi32(w2, 10));
+            w[i & 15u] = _mm256_add_epi32(_mm256_add_epi32(w[i & 15u], s0),
+                                          _mm256_add_epi32(w[(i + 9) & 15u], s1));
+        }
+        const __m256i bigSigma1 = _mm256_xor_si256(_mm256_xor_si256(ROTR256(e, 6), ROTR256(e, 11)), ROTR256(e, 25));
+        const __m256i ch = _mm256_xor_si256(_mm256_and_si256(e, f), _mm256_andnot_si256(e, g));
+        const __m256i t1 = _mm256_add_epi32(_mm256_add_epi32(h, bigSigma1),
+                                            _mm256_add_epi32(_mm256_add_epi32(ch, w[i & 15u]),
+                                                             _mm256_set1_epi32((int) sha256_k[i])));
+        const __m256i bigSigma0 = _mm256_xor_si256(_mm256_xor_si256(ROTR256(a, 2), ROTR256(a, 13)), ROTR256(a, 22));
+        const __m256i maj = _mm256_or_si256(_mm256_and_si256(a, b), _mm256_and_si256(c, _mm256_or_si256(a, b)));
+        const __m256i t2 = _mm256_add_epi32(bigSigma0, maj);
+        h = g;
+        g = f;
+        f = e;
+        e = _mm256_add_epi32(d, t1);
+        d = c;
+        c = b;
+        b = a;
+        a = _mm256_add_epi32(t1, t2);
+    }
+
+    const __m256i out[8] = {a, b, c, d, e, f, g, h};
+    for (uint8_t i = 0; i < 8; i++) {
+        __m256i *row = (__m256i *) state[i];
+        _mm256_storeu_si256(row, _mm256_add_epi32(_mm256_loadu_si256(row), out[i]));
+    }
+}
+
+typedef struct {
+    const uint8_t *data;
+    size_t fullBlocks;
+    uint8_t tail[2 * SHA256_HOST_BLOCK_SIZE];
+    uint8_t tailBlocks;
+    uint8_t tailPos;
+    size_t index;
+} sha256_lane_t;
+
+static void sha256_lane_start(sha256_lane_t *lane, uint32_t state[8][SHA256_HOST_LANES], uint8_t laneIdx,
+                              const uint8_t *message, size_t messageLen, size_t index) {
+    lane->data = message;
+    lane->fullBlocks = messageLen / SHA256_HOST_BLOCK_SIZE;
+    lane->tailBlocks = sha256_pad(lane->tail, message + lane->fullBlocks * SHA256_HOST_BLOCK_SIZE,
+                                  messageLen % SHA256_HOST_BLOCK_SIZE, messageLen);
+    lane->tailPos = 0;
+    lane->index = index;
+    for (uint8_t i = 0; i < 8; i++) {
+        state[i][laneIdx] = sha256_iv[i];
+    }
+}
+
+// Every lane hashes its own message, a lane that finishes picks up the next one.
+// Idle lanes hash a dummy block so the 8 lanes stay in lockstep.
+static void sha256_multi_avx2(const uint8_t *const *messages, const size_t *messageLens, size_t count,
+                              uint8_t *digests) {
+    static const uint8_t idleBlock[SHA256_HOST_BLOCK_SIZE] = {0};
+    uint32_t state[8][SHA256_HOST_LANES];
+    sha256_lane_t lanes[SHA256_HOST_LANES];
+    const uint8_t *blocks[SHA256_HOST_LANES];
+
+    size_t next = 0;
+    uint8_t active = 0;
+    for (uint8_t l = 0; l < SHA256_HOST_LANES; l++) {
+        if (next < count) {
+            sha256_lane_start(&lanes[l], state, l, messages[next], messageLens[next], next);
+            next++;
+            active++;
+        } else {
+            lanes[l].data = NULL;
+            lanes[l].fullBlocks = 0;
+            lanes[l].tailBlocks = 0;
+            lanes[l].tailPos = 0;
+        }
+    }
+
+    while (active > 0) {
+        for (uint8_t l = 0; l < SHA256_HOST_LANES; l++) {
+            const sha256_lane_t *lane = &lanes[l];
+            if (lane->fullBlocks > 0) {
+                blocks[l] = lane->data;
+            } else if (lane->tailPos < lane->tailBlocks) {
+                blocks[l] = lane->tail + lane->tailPos * SHA256_HOST_BLOCK_SIZE;
+            } else {
+                blocks[l] = idleBlock;
+            }
+        }
+
+        sha256_compress_avx2x8(state, blocks);
+
+        for (uint8_t l = 0; l < SHA256_HOST_LANES; l++) {
+            sha256_lane_t *lane = &lanes[l];
+            if (lane->fullBlocks > 0) {
+                lane->data += SHA256_HOST_BLOCK_SIZE;
+                lane->fullBlocks--;
+                continue;
+            }
+            if (lane->tailPos >= lane->tailBlocks) {
+                continue;
+            }
+            lane->tailPos++;
+            if (lane->tailPos < lane->tailBlocks) {
+                continue;
+            }
+
+            uint8_t *digest = digests + lane->index * SHA256_HOST_DIGEST_SIZE;
+            for (uint8_t i = 0; i < 8; i++) {
+                store_be32(digest + 4 * i, state[i][l]);
+            }
+            if (next < count) {
+                sha256_lane_start(lane, state, l, messages[next], messageLens[next], next);
+                next++;
+            } else {
+                active--;
+            }
+        }
+    }
+}
+
+#endif
+
+////////////////////////////////////////////////////////////////////////////////
+// aarch64: ARMv8 crypto extensions
+
+#if defined(SHA256_HOST_ARMV8)
+
+SHA256_ARMV8_TARGET
+static void sha256_compress_armv8(uint32_t state[8], const uint8_t *blocks, size_t blockCount) {
+    uint32x4_t state0 = vld1q_u32(&state[0]);
+    uint32x4_t state1 = vld1q_u32(&state[4]);
+
+    for (; blockCount > 0; blockCount--, blocks += SHA256_HOST_BLOCK_SIZE) {
+        const uint32x4_t abcdSave = state0;
+        const uint32x4_t efghSave = state1;
+        uint32x4_t m[4];
+        for (uint8_t i = 0; i < 4; i++) {
+            m[i] = vreinterpretq_u32_u8(vrev32q_u8(vld1q_u8(blocks + 16 * i)));
+        }
+
+        for (uint8_t g = 0; g < 16; g++) {
+            const uint32x4_t wk = vaddq_u32(m[g & 3u], vld1q_u32(&sha256_k[4 * g]));
+            if (g < 12) {
+                m[g & 3u] = vsha256su0q_u32(m[g & 3u], m[(g + 1) & 3u]);
+            }
+            const uint32x4_t abcd = state0;
+            state0 = vsha256hq_u32(state0, state1, wk);
+            state1 = vsha256h2q_u32(state1, abcd, wk);
+            if (g < 12) {
+                m[g & 3u] = vsha256su1q_u32(m[g & 3u], m[(g + 2) & 3u], m[(g + 3) & 3u]);
+            }
+        }
+
+        state0 = vaddq_u32(state0, abcdSave);
+        state1 = vaddq_u32(state1, efghSave);
+    }
+
+    vst1q_u32(&state[0], state0);
+    vst1q_u32(&state[4], state1);
+}
+
+#endif
+
+////////////////////////////////////////////////////////////////////////////////
+// Runtime dispatch
+
+static sha256_compress_fn sha256_compress = NULL;
+static sha256_multi_fn sha256_multi = NULL;
+static const char *sha256_compressName = "portable";
+static const char *sha256_multiName = "sequential";
+static sha256_host_mode_e sha256_mode = SHA256_HOST_AUTO;
+
+#if defined(SHA256_HOST_X86)
+static bool cpu_has_avx2(void) {
+    unsigned int eax, ebx, ecx, edx;
+    if (!__get_cpuid(1, &eax, &ebx, &ecx, &edx) || (ecx & bit_OSXSAVE) == 0) {
+        return false;
+    }
+    // the OS has to save the YMM registers
+    uint32_t xcr0Low, xcr0High;
+    __asm__ volatile("xgetbv" : "=a"(xcr0Low), "=d"(xcr0High) : "c"(0));
+    if ((xcr0Low & 0x6u) != 0x6u) {
+        return false;
+    }
+    return __get_cpuid_count(7, 0, &eax, &ebx, &ecx, &edx) && (ebx & bit_AVX2) != 0;
+}
+
+static bool cpu_has_shani(void) {
+    unsigned int eax, ebx, ecx, edx;
+    if (!__get_cpuid(1, &eax, &ebx, &ecx, &edx) || (ecx & bit_SSE4_1) == 0 || (ecx & bit_SSSE3) == 0) {
+        return false;
+    }
+    return __get_cpuid_count(7, 0, &eax, &ebx, &ecx, &edx) && (ebx & bit_SHA) != 0;
+}
+#endif
+
+#if defined(SHA256_HOST_ARMV8)
+static bool cpu_has_armv8_sha2(void) {
+#if defined(__linux__)
+    return (getauxval(AT_HWCAP) & HWCAP_SHA2) != 0;
+#elif defined(__APPLE__)
+    return true;
+#else
+    return false;
+#endif
+}
+#endif
+
+static void sha256_select(void) {
+    sha256_compress = sha256_compress_portable;
+    sha256_compressName = "portable";
+    sha256_multi = sha256_multi_sequential;
+    sha256_multiName = "sequential";
+    if (sha256_mode == SHA256_HOST_PORTABLE) {
+        return;
+    }
+
+#if defined(SHA256_HOST_X86)
+    if (cpu_has_shani()) {
+        sha256_compress = sha256_compress_shani;
+        sha256_compressName = "sha-ni";
+    }
+    // with SHA-NI a single stream is already faster than 8 AVX2 lanes
+    if (cpu_has_avx2() && (!cpu_has_shani() || sha256_mode == SHA256_HOST_SIMD_LANES)) {
+        sha256_multi = sha256_multi_avx2;
+        sha256_multiName = "avx2x8";
+    }
+#elif defined(SHA256_HOST_ARMV8)
+    if (cpu_has_armv8_sha2()) {
+        sha256_compress = sha256_compress_armv8;
+        sha256_compressName = "armv8";
+    }
+#endif
+}
+
+static sha256_compress_fn sha256_compressFn(void) {
+    if (sha256_compress == NULL) {
+        sha256_select();
+    }
+    return sha256_compress;
+}
+
+const char *sha256_host_backend(void) {
+    sha256_compressFn();
+    return sha256_compressName;
+}
+
+const char *sha256_host_multiBackend(void) {
+    sha256_compressFn();
+    return sha256_multiName;
+}
+
+bool sha256_host_setMode(sha256_host_mode_e mode) {
+    sha256_mode = mode;
+    sha256_select();
+    if (mode == SHA256_HOST_SIMD_LANES && sha256_multi == sha256_multi_sequential) {
+        sha256_mode = SHA256_HOST_AUTO;
+        sha256_select();
+        return false;
+    }
+    return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void sha256_host_init(sha256_host_ctx_t *ctx) {
+    MEMCPY(ctx->state, sha256_iv, sizeof(sha256_iv));
+    ctx->blockLen = 0;
+    ctx->totalLen = 0;
+}
+
+void sha256_host_update(sha256_host_ctx_t *ctx, const uint8_t *data, size_t len) {
+    const sha256_compress_fn compress = sha256_compressFn();
+    ctx->totalLen += len;
+
+    if (ctx->blockLen > 0) {
+        size_t n = SHA256_HOST_BLOCK_SIZE - ctx->blockLen;
+        if (n > len) {
+            n = len;
+        }
+        MEMCPY(ctx->block + ctx->blockLen, data, n);
+        ctx->blockLen += (uint8_t) n;
+        data += n;
+        len -= n;
+        if (ctx->blockLen < SHA256_HOST_BLOCK_SIZE) {
+            return;
+        }
+        compress(ctx->state, ctx->block, 1);
+        ctx->blockLen = 0;
+    }
+
+    // full blocks are hashed in place
+    const size_t blockCount = len / SHA256_HOST_BLOCK_SIZE;
+    if (blockCount > 0) {
+        compress(ctx->state, data, blockCount);
+        data += blockCount * SHA256_HOST_BLOCK_SIZE;
+        len -= blockCount * SHA256_HOST_BLOCK_SIZE;
+    }
+    if (len > 0) {
+        MEMCPY(ctx->block, data, len);
+        ctx->blockLen = (uint8_t) len;
+    }
+}
+
+void sha256_host_final(sha256_host_ctx_t *ctx, uint8_t digest[SHA256_HOST_DIGEST_SIZE]) {
+    uint8_t tail[2 * SHA256_HOST_BLOCK_SIZE];
+    const uint8_t tailBlocks = sha256_pad(tail, ctx->block, ctx->blockLen, ctx->totalLen);
+    sha256_compressFn()(ctx->state, tail, tailBlocks);
+    for (uint8_t i = 0; i < 8; i++) {
+        store_be32(digest + 4 * i, ctx->state[i]);
+    }
+    MEMZERO(ctx, sizeof(*ctx));
+}
+
+void sha256_host(const uint8_t *message, size_t messageLen, uint8_t digest[SHA256_HOST_DIGEST_SIZE]) {
+    sha256_host_ctx_t ctx;
+    sha256_host_init(&ctx);
+    sha256_host_update(&ctx, message, messageLen);
+    sha256_host_final(&ctx, digest);
+}
+
+void sha256_host_multi(const uint8_t *const *messages, const size_t *messageLens, size_t count, uint8_t *digests) {
+    sha256_compressFn();
+    sha256_multi(messages, messageLens, count, digests);
+}
+
+#endif
@@ -0,0 +1,69 @@
+/*******************************************************************************
+*   (c) 2021 Zondax GmbH
+*
+*  Licensed under the Apache License, Version 2.0 (the "License");
+*  you may not use this file except in compliance with the License.
+*  You may obtain a copy of the License at
+*
+*      http://www.apache.org/licenses/LICENSE-2.0
+*
+*  Unless required by applicable law or agreed to in writing, software
+*  distributed under the License is distributed on an "AS IS" BASIS,
+*  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+*  See the License for the specific language governing permissions and
+*  limitations under the License.
+********************************************************************************/
+#pragma once
+
+// Host SHA-256, the device uses cx_hash_sha256
+// The block function is picked at runtime: SHA-NI on x86, ARMv8 crypto extensions on aarch64, portable otherwise.
+// sha256_host_multi hashes independent messages in 8 lanes with AVX2 when the CPU has it.
+
+#if !defined(TARGET_NANOS) && !defined(TARGET_NANOX) && !defined(TARGET_NANOS2)
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+
+#define SHA256_HOST_DIGEST_SIZE 32
+#define SHA256_HOST_BLOCK_SIZE  64
+#define SHA256_HOST_LANES       8
+
+typedef struct {
+    uint32_t state[8];
+    uint8_t block[SHA256_HOST_BLOCK_SIZE];
+    uint8_t blockLen;
+    uint64_t totalLen;
+} sha256_host_ctx_t;
+
+void sha256_host_init(sha256_host_ctx_t *ctx);
+void sha256_host_update(sha256_host_ctx_t *ctx, const uint8_t *data, size_t len);
+void sha256_host_final(sha256_host_ctx_t *ctx, uint8_t digest[SHA256_HOST_DIGEST_SIZE]);
+
+void sha256_host(const uint8_t *message, size_t messageLen, uint8_t digest[SHA256_HOST_DIGEST_SIZE]);
+
+// Hashes count independent messages, digests holds count * SHA256_HOST_DIGEST_SIZE bytes
+void sha256_host_multi(const uint8_t *const *messages, const size_t *messageLens, size_t count, uint8_t *digests);
+
+// Names of the selected implementations: "sha-ni", "armv8" or "portable" / "avx2x8" or "sequential"
+const char *sha256_host_backend(void);
+const char *sha256_host_multiBackend(void);
+
+typedef enum {
+    SHA256_HOST_AUTO = 0,       // fastest paths the CPU supports
+    SHA256_HOST_PORTABLE,       // portable code only, to cross check the accelerated paths
+    SHA256_HOST_SIMD_LANES,     // SIMD lanes for sha256_host_multi even when SHA-NI is faster
+} sha256_host_mode_e;
+
+// Returns false, and keeps SHA256_HOST_AUTO, if the CPU lacks what the mode needs
+bool sha256_host_setMode(sha256_host_mode_e mode);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,181 @@
+/*******************************************************************************
+*   (c) 2021 Zondax GmbH
+*
+*  Licensed under the Apache License, Version 2.0 (the "License");
+*  you may not use this file except in compliance with the License.
+*  You may obtain a copy of the License at
+*
+*      http://www.apache.org/licenses/LICENSE-2.0
+*
+*  Unless required by applicable law or agreed to in writing, software
+*  distributed under the License is distributed on an "AS IS" BASIS,
+*  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+*  See the License for the specific language governing permissions and
+*  limitations under the License.
+********************************************************************************/
+
+#if !defined(TARGET_NANOS) && !defined(TARGET_NANOX) && !defined(TARGET_NANOS2)
+
+#include "sha3_host.h"
+#include "zxmacros.h"
+
+static const uint64_t keccak_rc[24] = {
+        0x0000000000000001, 0x0000000000008082, 0x800000000000808a, 0x8000000080008000,
+        0x000000000000808b, 0x0000000080000001, 0x8000000080008081, 0x8000000000008009,
+        0x000000000000008a, 0x0000000000000088, 0x0000000080008009, 0x000000008000000a,
+        0x000000008000808b, 0x800000000000008b, 0x8000000000008089, 0x8000000000008003,
+        0x8000000000008002, 0x8000000000000080, 0x000000000000800a, 0x800000008000000a,
+        0x8000000080008081, 0x8000000000008080, 0x0000000080000001, 0x8000000080008008,
+};
+
+#define ROTL64(x, n) (((x) << (n)) | ((x) >> (64u - (n))))
+
+// Rounds are unrolled over the 25 lanes so they stay in registers, lane (x, y) is axx with xx = x + 5y
+static void keccak_f1600(uint64_t st[25]) {
+    uint64_t a00 = st[0], a01 = st[1], a02 = st[2], a03 = st[3], a04 = st[4];
+    uint64_t a05 = st[5], a06 = st[6], a07 = st[7], a08 = st[8], a09 = st[9];
+    uint64_t a10 = st[10], a11 = st[11], a12 = st[12], a13 = st[13], a14 = st[14];
+    uint64_t a15 = st[15], a16 = st[16], a17 = st[17], a18 = st[18], a19 = st[19];
+    uint64_t a20 = st[20], a21 = st[21], a22 = st[22], a23 = st[23], a24 = st[24];
+
+    for (uint8_t round = 0; round < 24; round++) {
+        const uint64_t c0 = a00 ^ a05 ^ a10 ^ a15 ^ a20;
+        const uint64_t c1 = a01 ^ a06 ^ a11 ^ a16 ^ a21;
+        const uint64_t c2 = a02 ^ a07 ^ a12 ^ a17 ^ a22;
+        const uint64_t c3 = a03 ^ a08 ^ a13 ^ a18 ^ a23;
+        const uint64_t c4 = a04 ^ a09 ^ a14 ^ a19 ^ a24;
+        const uint64_t d0 = c4 ^ ROTL64(c1, 1u);
+        const uint64_t d1 = c0 ^ ROTL64(c2, 1u);
+        const uint64_t d2 = c1 ^ ROTL64(c3, 1u);
+        const uint64_t d3 = c2 ^ ROTL64(c4, 1u);
+        const uint64_t d4 = c3 ^ ROTL64(c0, 1u);
+
+        // theta, rho and pi: lane (x, y) moves to (y, 2x + 3y)
+        const uint64_t b00 = a00 ^ d0;
+        const uint64_t b01 = ROTL64(a06 ^ d1, 44u);
+        const uint64_t b02 = ROTL64(a12 ^ d2, 43u);
+        const uint64_t b03 = ROTL64(a18 ^ d3, 21u);
+        const uint64_t b04 = ROTL64(a24 ^ d4, 14u);
+        const uint64_t b05 = ROTL64(a03 ^ d3, 28u);
+        const uint64_t b06 = ROTL64(a09 ^ d4, 20u);
+        const uint64_t b07 = ROTL64(a10 ^ d0, 3u);
+        const uint64_t b08 = ROTL64(a16 ^ d1, 45u);
+        const uint64_t b09 = ROTL64(a22 ^ d2, 61u);
+        const uint64_t b10 = ROTL64(a01 ^ d1, 1u);
+        const uint64_t b11 = ROTL64(a07 ^ d2, 6u);
+        const uint64_t b12 = ROTL64(a13 ^ d3, 25u);
+        const uint64_t b13 = ROTL64(a19 ^ d4, 8u);
+        const uint64_t b14 = ROTL64(a20 ^ d0, 18u);
+        const uint64_t b15 = ROTL64(a04 ^ d4, 27u);
+        const uint64_t b16 = ROTL64(a05 ^ d0, 36u);
+        const uint64_t b17 = ROTL64(a11 ^ d1, 10u);
+        const uint64_t b18 = ROTL64(a17 ^ d2, 15u);
+        const uint64_t b19 = ROTL64(a23 ^ d3, 56u);
+        const uint64_t b20 = ROTL64(a02 ^ d2, 62u);
+        const uint64_t b21 = ROTL64(a08 ^ d3, 55u);
+        const uint64_t b22 = ROTL64(a14 ^ d4, 39u);
+        const uint64_t b23 = ROTL64(a15 ^ d0, 41u);
+        const uint64_t b24 = ROTL64(a21 ^ d1, 2u);
+
+        // chi
+        a00 = b00 ^ (~b01 & b02);
+        a01 = b01 ^ (~b02 & b03);
+        a02 = b02 ^ (~b03 & b04);
+        a03 = b03 ^ (~b04 & b00);
+        a04 = b04 ^ (~b00 & b01);
+        a05 = b05 ^ (~b06 & b07);
+        a06 = b06 ^ (~b07 & b08);
+        a07 = b07 ^ (~b08 & b09);
+        a08 = b08 ^ (~b09 & b05);
+        a09 = b09 ^ (~b05 & b06);
+        a10 = b10 ^ (~b11 & b12);
+        a11 = b11 ^ (~b12 & b13);
+        a12 = b12 ^ (~b13 & b14);
+        a13 = b13 ^ (~b14 & b10);
+        a14 = b14 ^ (~b10 & b11);
+        a15 = b15 ^ (~b16 & b17);
+        a16 = b16 ^ (~b17 & b18);
+        a17 = b17 ^ (~b18 & b19);
+        a18 = b18 ^ (~b19 & b15);
+        a19 = b19 ^ (~b15 & b16);
+        a20 = b20 ^ (~b21 & b22);
+        a21 = b21 ^ (~b22 & b23);
+        a22 = b22 ^ (~b23 & b24);
+        a23 = b23 ^ (~b24 & b20);
+        a24 = b24 ^ (~b20 & b21);
+
+        // iota
+        a00 ^= keccak_rc[round];
+    }
+
+    st[0] = a00, st[1] = a01, st[2] = a02, st[3] = a03, st[4] = a04;
+    st[5] = a05, st[6] = a06, st[7] = a07, st[8] = a08, st[9] = a09;
+    st[10] = a10, st[11] = a11, st[12] = a12, st[13] = a13, st[14] = a14;
+    st[15] = a15, st[16] = a16, st[17] = a17, st[18] = a18, st[19] = a19;
+    st[20] = a20, st[21] = a21, st[22] = a22, st[23] = a23, st[24] = a24;
+}
+
+static uint64_t load_le64(const uint8_t *p) {
+    uint64_t v = 0;
+    for (uint8_t i = 0; i < 8; i++) {
+        v |= (uint64_t) p[i] << (8u * i);
+    }
+    return v;
+}
+
+static void sha3_xorByte(uint64_t st[25], uint8_t pos, uint8_t value) {
+    st[pos / 8] ^= (uint64_t) value << (8u * (pos % 8));
+}
+
+void sha3_256_host_init(sha3_host_ctx_t *ctx) {
+    MEMZERO(ctx, sizeof(*ctx));
+}
+
+void sha3_256_host_update(sha3_host_ctx_t *ctx, const uint8_t *data, size_t len) {
+    // finish a partial block
+    while (len > 0 && ctx->blockLen > 0) {
+        sha3_xorByte(ctx->state, ctx->blockLen, *data);
+        data++;
+        len--;
+        ctx->blockLen++;
+        if (ctx->blockLen == SHA3_256_HOST_RATE) {
+            keccak_f1600(ctx->state);
+            ctx->blockLen = 0;
+        }
+    }
+
+    // whole blocks are absorbed a lane at a time
+    while (len >= SHA3_256_HOST_RATE) {
+        for (uint8_t i = 0; i < SHA3_256_HOST_RATE / 8; i++) {
+            ctx->state[i] ^= load_le64(data + 8 * i);
+        }
+        keccak_f1600(ctx->state);
+        data += SHA3_256_HOST_RATE;
+        len -= SHA3_256_HOST_RATE;
+    }
+
+    for (; len > 0; len--, data++) {
+        sha3_xorByte(ctx->state, ctx->blockLen++, *data);
+    }
+}
+
+void sha3_256_host_final(sha3_host_ctx_t *ctx, uint8_t digest[SHA3_256_HOST_DIGEST_SIZE]) {
+    // SHA3 domain separation and pad10*1
+    sha3_xorByte(ctx->state, ctx->blockLen, 0x06u);
+    sha3_xorByte(ctx->state, SHA3_256_HOST_RATE - 1, 0x80u);
+    keccak_f1600(ctx->state);
+
+    for (uint8_t i = 0; i < SHA3_256_HOST_DIGEST_SIZE; i++) {
+        digest[i] = (uint8_t) (ctx->state[i / 8] >> (8u * (i % 8)));
+    }
+    MEMZERO(ctx, sizeof(*ctx));
+}
+
+void sha3_256_host(const uint8_t *message, size_t messageLen, uint8_t digest[SHA3_256_HOST_DIGEST_SIZE]) {
+    sha3_host_ctx_t ctx;
+    sha3_256_host_init(&ctx);
+    sha3_256_host_update(&ctx, message, messageLen);
+    sha3_256_host_final(&ctx, digest);
+}
+
+#endif
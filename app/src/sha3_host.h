@@ -0,0 +1,48 @@
+/*******************************************************************************
+*   (c) 2021 Zondax GmbH
+*
+*  Licensed under the Apache License, Version 2.0 (the "License");
+*  you may not use this file except in compliance with the License.
+*  You may obtain a copy of the License at
+*
+*      http://www.apache.org/licenses/LICENSE-2.0
+*
+*  Unless required by applicable law or agreed to in writing, software
+*  distributed under the License is distributed on an "AS IS" BASIS,
+*  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+*  See the License for the specific language governing permissions and
+*  limitations under the License.
+********************************************************************************/
+#pragma once
+
+// Host SHA3-256 (Keccak-f[1600]), the device uses cx_sha3
+
+#if !defined(TARGET_NANOS) && !defined(TARGET_NANOX) && !defined(TARGET_NANOS2)
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+#include <stddef.h>
+
+#define SHA3_256_HOST_DIGEST_SIZE 32
+// Bytes absorbed per permutation
+#define SHA3_256_HOST_RATE        136
+
+typedef struct {
+    uint64_t state[25];
+    uint8_t blockLen;
+} sha3_host_ctx_t;
+
+void sha3_256_host_init(sha3_host_ctx_t *ctx);
+void sha3_256_host_update(sha3_host_ctx_t *ctx, const uint8_t *data, size_t len);
+void sha3_256_host_final(sha3_host_ctx_t *ctx, uint8_t digest[SHA3_256_HOST_DIGEST_SIZE]);
+
+void sha3_256_host(const uint8_t *message, size_t messageLen, uint8_t digest[SHA3_256_HOST_DIGEST_SIZE]);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,353 @@
+/*******************************************************************************
+*   (c) 2021 Zondax GmbH
+*
+*  Licensed under the Apache License, Version 2.0 (the "License");
+*  you may not use this file except in compliance with the License.
+*  You may obtain a copy of the License at
+*
+*      http://www.apache.org/licenses/LICENSE-2.0
+*
+*  Unless required by applicable law or agreed to in writing, software
+*  distributed under the License is distributed on an "AS IS" BASIS,
+*  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+*  See the License for the specific language governing permissions and
+*  limitations under the License.
+********************************************************************************/
+
+#include "tx_batch.h"
+#include "parser.h"
+#include <zxformat.h>
+#include <zxmacros.h>
+
+#if defined(HAVE_TX_BATCH)
+
+// Transactions of the same script type share a group, the summary shows one entry per group
+typedef struct {
+    script_type_e type;
+    char name[TX_BATCH_TYPE_LEN];
+    uint8_t count;
+    bool hasAmount;
+    uint64_t total;
+} tx_batch_group_t;
+
+typedef struct {
+    uint8_t group;
+    uint8_t numItems;
+    uint32_t offset;
+    uint16_t length;
+    uint8_t digest[CRYPTO_DIGEST_SIZE];
+} tx_batch_record_t;
+
+typedef struct {
+    bool active;
+    bool approved;
+    uint32_t path[HDPATH_LEN_DEFAULT];
+    tx_batch_buffer_t buffer;
+    uint8_t count;
+    uint8_t groupCount;
+    tx_batch_group_t groups[TX_BATCH_MAX];
+    tx_batch_record_t records[TX_BATCH_MAX];
+    // Transaction held by the parser for the review, 0 when none
+    uint8_t parsed;
+    parser_context_t ctx;
+} tx_batch_t;
+
+tx_batch_t tx_batch;
+
+void tx_batch_reset(const uint32_t path[HDPATH_LEN_DEFAULT], tx_batch_buffer_t buffer) {
+    MEMZERO(&tx_batch, sizeof(tx_batch));
+    MEMCPY(tx_batch.path, path, sizeof(tx_batch.path));
+    tx_batch.buffer = buffer;
+    tx_batch.active = true;
+}
+
+void tx_batch_clear(void) {
+    MEMZERO(&tx_batch, sizeof(tx_batch));
+}
+
+bool tx_batch_active(void) {
+    return tx_batch.active;
+}
+
+const uint32_t *tx_batch_path(void) {
+    return tx_batch.path;
+}
+
+uint8_t tx_batch_count(void) {
+    return tx_batch.count;
+}
+
+// Argument holding the amount of the script types that move tokens, the other types have no total
+static bool tx_batch_amountArgument(script_type_e type, uint8_t *argIndex) {
+    switch (type) {
+        case SCRIPT_TOKEN_TRANSFER:
+        case SCRIPT_TH01_WITHDRAW_UNLOCKED_TOKENS:
+        case SCRIPT_TH02_DEPOSIT_UNLOCKED_TOKENS:
+        case SCRIPT_TH08_STAKE_NEW_TOKENS:
+        case SCRIPT_TH09_RESTAKE_UNSTAKED_TOKENS:
+        case SCRIPT_TH10_RESTAKE_REWARDED_TOKENS:
+        case SCRIPT_TH11_UNSTAKE_TOKENS:
+        case SCRIPT_TH13_WITHDRAW_UNSTAKED_TOKENS:
+        case SCRIPT_TH14_WITHDRAW_REWARDED_TOKENS:
+        case SCRIPT_TH19_DELEGATE_NEW_TOKENS:
+        case SCRIPT_TH20_RESTAKE_UNSTAKED_DELEGATED_TOKENS:
+        case SCRIPT_TH21_RESTAKE_REWARDED_DELEGATED_TOKENS:
+        case SCRIPT_TH22_UNSTAKE_DELEGATED_TOKENS:
+        case SCRIPT_TH23_WITHDRAW_UNSTAKED_DELEGATED_TOKENS:
+        case SCRIPT_TH24_WITHDRAW_REWARDED_DELEGATED_TOKENS:
+        case SCRIPT_FUSD02_TRANSFER_FUSD:
+            *argIndex = 0;
+            return true;
+        case SCRIPT_TH17_REGISTER_DELEGATOR:
+        case SCRIPT_SCO02_REGISTER_DELEGATOR:
+        case SCRIPT_SCO15_WITHDRAW_FROM_MACHINE_ACCOUNT:
+            *argIndex = 1;
+            return true;
+        case SCRIPT_TH16_REGISTER_OPERATOR_NODE:
+        case SCRIPT_SCO05_REQUEST_UNSTAKING:
+        case SCRIPT_SCO06_STAKE_NEW_TOKENS:
+        case SCRIPT_SCO07_STAKE_REWARD_TOKENS:
+        case SCRIPT_SCO08_STAKE_UNSTAKED_TOKENS:
+        case SCRIPT_SCO10_WITHDRAW_REWARD_TOKENS:
+        case SCRIPT_SCO11_WITHDRAW_UNSTAKED_TOKENS:
+            *argIndex = 2;
+            return true;
+        case SCRIPT_TH06_REGISTER_NODE:
+        case SCRIPT_SCO03_REGISTER_NODE:
+            *argIndex = 5;
+            return true;
+        default:
+            return false;
+    }
+}
+
+// Type, count and total (only for types with amounts)
+__Z_INLINE uint8_t group_numItems(const tx_batch_group_t *group) {
+    return group->hasAmount ? 3 : 2;
+}
+
+static uint16_t tx_batch_numItems(void) {
+    uint16_t n = 1;
+    for (uint8_t g = 0; g < tx_batch.groupCount; g++) {
+        n += group_numItems(&tx_batch.groups[g]);
+    }
+    for (uint8_t i = 0; i < tx_batch.count; i++) {
+        n += tx_batch.records[i].numItems;
+    }
+    return n;
+}
+
+zxerr_t tx_batch_add(const parser_context_t *ctx, uint32_t offset, const uint8_t digest[CRYPTO_DIGEST_SIZE]) {
+    if (!tx_batch.active || tx_batch.approved) {
+        return zxerr_unknown;
+    }
+    if (tx_batch.count >= TX_BATCH_MAX) {
+        return zxerr_buffer_too_small;
+    }
+
+    uint8_t numItems = 0;
+    if (parser_getNumItems(ctx, &numItems) != PARSER_OK || numItems == 0) {
+        return zxerr_no_data;
+    }
+
+    uint8_t g = 0;
+    while (g < tx_batch.groupCount && tx_batch.groups[g].type != parser_tx_obj.script.type) {
+        g++;
+    }
+    const bool newGroup = g == tx_batch.groupCount;
+
+    uint8_t argIndex = 0;
+    const bool hasAmount = tx_batch_amountArgument(parser_tx_obj.script.type, &argIndex);
+    uint64_t amount = 0;
+    if (hasAmount) {
+        // An amount too large for 64 bits is only shown verbatim, it can not be part of a total
+        const flow_argument_value_t *value = &parser_tx_obj.arguments.argValue[argIndex];
+        if (argIndex >= parser_tx_obj.arguments.argCount ||
+            value->type != ARGUMENT_TYPE_UFIX64 || !value->hasValue) {
+            return zxerr_out_of_bounds;
+        }
+        if (parser_argumentNumber(&parser_tx_obj.arguments.argCtx[argIndex], value, &amount) != PARSER_OK) {
+            return zxerr_out_of_bounds;
+        }
+        if (!newGroup && tx_batch.groups[g].total + amount < tx_batch.groups[g].total) {
+            return zxerr_out_of_bounds;
+        }
+    }
+
+    const uint16_t groupItems = newGroup ? (hasAmount ? 3 : 2) : 0;
+    if (tx_batch_numItems() + groupItems + numItems > TX_BATCH_MAX_ITEMS) {
+        return zxerr_buffer_too_small;
+    }
+
+    tx_batch_group_t *group = &tx_batch.groups[g];
+    if (newGroup) {
+        // The first item of every transaction is its type
+        char key[20];
+        uint8_t pageCount = 0;
+        MEMZERO(group, sizeof(tx_batch_group_t));
+        if (parser_getItem(ctx, 0, key, sizeof(key), group->name, sizeof(group->name), 0, &pageCount) != PARSER_OK) {
+            MEMZERO(group, sizeof(tx_batch_group_t));
+            return zxerr_unknown;
+        }
+        group->type = parser_tx_obj.script.type;
+        group->hasAmount = hasAmount;
+        tx_batch.groupCount++;
+    }
+
+    group->count++;
+    group->total += amount;
+
+    tx_batch_record_t *record = &tx_batch.records[tx_batch.count];
+    record->group = g;
+    record->numItems = numItems;
+    record->offset = offset;
+    record->length = ctx->bufferLen;
+    MEMCPY(record->digest, digest, CRYPTO_DIGEST_SIZE);
+    tx_batch.count++;
+
+    // The buffer may have moved
+    tx_batch.parsed = 0;
+    return zxerr_ok;
+}
+
+void tx_batch_approve(void) {
+    tx_batch.approved = tx_batch.active && tx_batch.count > 0;
+}
+
+bool tx_batch_approved(void) {
+    return tx_batch.approved;
+}
+
+zxerr_t tx_batch_digest(uint8_t idx, uint8_t digest[CRYPTO_DIGEST_SIZE]) {
+    if (!tx_batch.approved) {
+        return zxerr_unknown;
+    }
+    if (idx >= tx_batch.count) {
+        return zxerr_out_of_bounds;
+    }
+    MEMCPY(digest, tx_batch.records[idx].digest, CRYPTO_DIGEST_SIZE);
+    return zxerr_ok;
+}
+
+static zxerr_t tx_batch_printAmount(uint64_t amount, char *outVal, uint16_t outValLen,
+                                    uint8_t pageIdx, uint8_t *pageCount) {
+    char buffer[32];
+    if (fpuint64_to_str_trimmed(buffer, sizeof(buffer), amount, UFIX64_DECIMALS) == 0) {
+        return zxerr_buffer_too_small;
+    }
+    pageString(outVal, outValLen, buffer, pageIdx, pageCount);
+    return zxerr_ok;
+}
+
+static zxerr_t tx_batch_printGroup(uint8_t g, uint8_t item,
+                                   char *outKey, uint16_t outKeyLen,
+                                   char *outVal, uint16_t outValLen,
+                                   uint8_t pageIdx, uint8_t *pageCount) {
+    const tx_batch_group_t *group = &tx_batch.groups[g];
+    switch (item) {
+        case 0:
+            snprintf(outKey, outKeyLen, "Type %d", g + 1);
+            pageString(outVal, outValLen, group->name, pageIdx, pageCount);
+            return zxerr_ok;
+        case 1:
+            snprintf(outKey, outKeyLen, "Count %d", g + 1);
+            snprintf(outVal, outValLen, "%d", group->count);
+            return zxerr_ok;
+        case 2:
+            snprintf(outKey, outKeyLen, "Total %d", g + 1);
+            return tx_batch_printAmount(group->total, outVal, outValLen, pageIdx, pageCount);
+        default:
+            return zxerr_no_data;
+    }
+}
+
+// The review parses one transaction at a time, the one shown last stays parsed
+static zxerr_t tx_batch_parse(uint8_t idx) {
+    if (tx_batch.parsed == idx + 1) {
+        return zxerr_ok;
+    }
+    tx_batch.parsed = 0;
+    if (tx_batch.buffer == NULL) {
+        return zxerr_unknown;
+    }
+
+    const tx_batch_record_t *record = &tx_batch.records[idx];
+    if (parser_parse(&tx_batch.ctx, tx_batch.buffer() + record->offset, record->length) != PARSER_OK) {
+        return zxerr_unknown;
+    }
+    tx_batch.parsed = idx + 1;
+    return zxerr_ok;
+}
+
+static zxerr_t tx_batch_printRecord(uint8_t idx, uint8_t item,
+                                    char *outKey, uint16_t outKeyLen,
+                                    char *outVal, uint16_t outValLen,
+                                    uint8_t pageIdx, uint8_t *pageCount) {
+    CHECK_ZXERR(tx_batch_parse(idx))
+
+    const parser_error_t err = parser_getItem(&tx_batch.ctx, item, outKey, outKeyLen, outVal, outValLen,
+                                              pageIdx, pageCount);
+    if (err == PARSER_NO_DATA ||
+        err == PARSER_DISPLAY_IDX_OUT_OF_RANGE ||
+        err == PARSER_DISPLAY_PAGE_OUT_OF_RANGE) {
+        return zxerr_no_data;
+    }
+    if (err != PARSER_OK) {
+        return zxerr_unknown;
+    }
+
+    // The type opens each transaction
+    if (item == 0) {
+        snprintf(outKey, outKeyLen, "Tx %d/%d", idx + 1, tx_batch.count);
+    }
+    return zxerr_ok;
+}
+
+zxerr_t tx_batch_getNumItems(uint8_t *num_items) {
+    if (tx_batch.count == 0) {
+        return zxerr_no_data;
+    }
+    *num_items = (uint8_t) tx_batch_numItems();
+    return zxerr_ok;
+}
+
+zxerr_t tx_batch_getItem(int8_t displayIdx,
+                         char *outKey, uint16_t outKeyLen,
+                         char *outVal, uint16_t outValLen,
+                         uint8_t pageIdx, uint8_t *pageCount) {
+    MEMZERO(outKey, outKeyLen);
+    MEMZERO(outVal, outValLen);
+    *pageCount = 1;
+
+    if (displayIdx < 0 || tx_batch.count == 0) {
+        return zxerr_no_data;
+    }
+
+    if (displayIdx == 0) {
+        snprintf(outKey, outKeyLen, "Transactions");
+        snprintf(outVal, outValLen, "%d", tx_batch.count);
+        return zxerr_ok;
+    }
+    uint8_t item = (uint8_t) (displayIdx - 1);
+
+    // Summary per type first, then the transactions one by one
+    for (uint8_t g = 0; g < tx_batch.groupCount; g++) {
+        const uint8_t n = group_numItems(&tx_batch.groups[g]);
+        if (item < n) {
+            return tx_batch_printGroup(g, item, outKey, outKeyLen, outVal, outValLen, pageIdx, pageCount);
+        }
+        item -= n;
+    }
+
+    for (uint8_t i = 0; i < tx_batch.count; i++) {
+        const uint8_t n = tx_batch.records[i].numItems;
+        if (item < n) {
+            return tx_batch_printRecord(i, item, outKey, outKeyLen, outVal, outValLen, pageIdx, pageCount);
+        }
+        item -= n;
+    }
+
+    return zxerr_no_data;
+}
+
+#endif
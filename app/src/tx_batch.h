@@ -0,0 +1,86 @@
+/*******************************************************************************
+*   (c) 2021 Zondax GmbH
+*
+*  Licensed under the Apache License, Version 2.0 (the "License");
+*  you may not use this file except in compliance with the License.
+*  You may obtain a copy of the License at
+*
+*      http://www.apache.org/licenses/LICENSE-2.0
+*
+*  Unless required by applicable law or agreed to in writing, software
+*  distributed under the License is distributed on an "AS IS" BASIS,
+*  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+*  See the License for the specific language governing permissions and
+*  limitations under the License.
+********************************************************************************/
+#pragma once
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdbool.h>
+#include "crypto.h"
+#include "parser_common.h"
+
+// The batch state does not fit next to the Nano S stack, INS_SIGN_BATCH is left out there
+#if !defined(TARGET_NANOS)
+#define HAVE_TX_BATCH
+#endif
+
+// Transactions a batch can hold, each keeps its digest and where it is in the transaction buffer
+#define TX_BATCH_MAX 16
+
+// Longest transaction type shown by the parser plus the terminator
+#define TX_BATCH_TYPE_LEN 41
+
+// The view addresses review items with an int8_t
+#define TX_BATCH_MAX_ITEMS 127
+
+/// Start of the buffer holding the transactions of the batch, it may move when transactions are added
+typedef const uint8_t *(*tx_batch_buffer_t)(void);
+
+/// Starts an empty batch signed with path
+/// \param buffer the transactions are read back from it for the review
+void tx_batch_reset(const uint32_t path[HDPATH_LEN_DEFAULT], tx_batch_buffer_t buffer);
+
+/// Drops the batch, it has to be started again
+void tx_batch_clear(void);
+
+/// Returns true between tx_batch_reset and tx_batch_clear
+bool tx_batch_active(void);
+
+/// Path the batch is signed with
+const uint32_t *tx_batch_path(void);
+
+/// Number of transactions in the batch
+uint8_t tx_batch_count(void);
+
+/// Adds the transaction parsed last to the batch
+/// \param ctx context of the last parser_parse
+/// \param offset where the transaction starts in the batch buffer, it has to stay there until the batch is cleared
+/// \param digest signable digest of the transaction for the batch path
+/// \return zxerr_buffer_too_small when the batch or its review is full,
+///         zxerr_out_of_bounds if its amount can not be added to the total of its type
+zxerr_t tx_batch_add(const parser_context_t *ctx, uint32_t offset, const uint8_t digest[CRYPTO_DIGEST_SIZE]);
+
+/// Marks the batch as reviewed, no transactions can be added afterwards
+void tx_batch_approve(void);
+
+bool tx_batch_approved(void);
+
+/// Digest of the idx-th transaction, only available once the batch was approved
+zxerr_t tx_batch_digest(uint8_t idx, uint8_t digest[CRYPTO_DIGEST_SIZE]);
+
+/// Review of the batch: counts per transaction type with the total of the types that move tokens,
+/// then every item of each transaction as in a single review
+zxerr_t tx_batch_getNumItems(uint8_t *num_items);
+
+zxerr_t tx_batch_getItem(int8_t displayIdx,
+                         char *outKey, uint16_t outKeyLen,
+                         char *outVal, uint16_t outValLen,
+                         uint8_t pageIdx, uint8_t *pageCount);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,251 @@
+/*******************************************************************************
+*   (c) 2021 Zondax GmbH
+*
+*  Licensed under the Apache License, Version 2.0 (the "License");
+*  you may not use this file except in compliance with the License.
+*  You may obtain a copy of the License at
+*
+*      http://www.apache.org/licenses/LICENSE-2.0
+*
+*  Unless required by applicable law or agreed to in writing, software
+*  distributed under the License is distributed on an "AS IS" BASIS,
+*  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+*  See the License for the specific language governing permissions and
+*  limitations under the License.
+********************************************************************************/
+
+// End to end sign protocol throughput
+//
+// Every valid envelope test vector is signed through handleApdu with the host harness in bench/host: INIT with the
+// path, ADD chunks of 250 bytes and LAST, which parses, reviews (every page rendered and approved) and signs.
+// A first pass checks each signature against the key returned by GET_PUBKEY, then the accepted transactions are
+// signed round robin and the latency of every instruction is reported.
+//
+// Usage: bench-apdu_sign [testvectors directory] [transactions]
+
+#include <json/json.h>
+#include <fmt/core.h>
+
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <map>
+#include <string>
+#include <vector>
+
+#include <apdu_host.h>
+#include <app_main.h>
+#include <coin.h>
+#include <crypto.h>
+#include <crypto_host.h>
+#include <hexutils.h>
+
+#define CHUNK_SIZE 250
+
+typedef std::vector<uint8_t> bytes_t;
+typedef std::chrono::steady_clock bench_clock;
+
+typedef struct {
+    std::string title;
+    uint32_t path[HDPATH_LEN_DEFAULT];
+    bytes_t blob;
+} tx_case_t;
+
+static std::map<std::string, std::vector<double>> latencies;
+
+static bytes_t apdu(uint8_t ins, uint8_t p1, const uint8_t *data, size_t dataLen) {
+    bytes_t out = {CLA, ins, p1, 0, (uint8_t) dataLen};
+    out.resize(OFFSET_DATA + dataLen);
+    std::copy(data, data + dataLen, out.begin() + OFFSET_DATA);
+    return out;
+}
+
+static uint16_t statusWord(uint16_t replyLen) {
+    if (replyLen < 2) {
+        return 0;
+    }
+    return (uint16_t) (G_io_apdu_buffer[replyLen - 2] << 8u | G_io_apdu_buffer[replyLen - 1]);
+}
+
+// Returns the status word, the reply data stays in G_io_apdu_buffer
+static uint16_t exchange(const std::string &label, const bytes_t &command, uint16_t *dataLen = nullptr) {
+    const auto start = bench_clock::now();
+    const uint16_t replyLen = apdu_host_exchange(command.data(), command.size());
+    const auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(bench_clock::now() - start);
+    latencies[label].push_back((double) elapsed.count());
+
+    if (dataLen != nullptr) {
+        *dataLen = replyLen >= 2 ? replyLen - 2 : 0;
+    }
+    return statusWord(replyLen);
+}
+
+static uint16_t sign(const tx_case_t &c, uint16_t *sigLen) {
+    uint16_t sw = exchange("sign init", apdu(INS_SIGN, PAYLOAD_TYPE_INIT, (const uint8_t *) c.path, sizeof(c.path)));
+    if (sw != APDU_CODE_OK) {
+        return sw;
+    }
+
+    size_t offset = 0;
+    while (c.blob.size() - offset > CHUNK_SIZE) {
+        sw = exchange("sign add", apdu(INS_SIGN, PAYLOAD_TYPE_ADD, c.blob.data() + offset, CHUNK_SIZE));
+        if (sw != APDU_CODE_OK) {
+            return sw;
+        }
+        offset += CHUNK_SIZE;
+    }
+
+    return exchange("sign last", apdu(INS_SIGN, PAYLOAD_TYPE_LAST, c.blob.data() + offset, c.blob.size() - offset),
+                    sigLen);
+}
+
+static bool verify(const tx_case_t &c, const bytes_t &signature) {
+    uint16_t answerLen = 0;
+    if (exchange("get pubkey", apdu(INS_GET_PUBKEY, 0, (const uint8_t *) c.path, sizeof(c.path)), &answerLen) !=
+        APDU_CODE_OK) {
+        return false;
+    }
+    const bytes_t answer(G_io_apdu_buffer, G_io_apdu_buffer + answerLen);
+
+    // The signed message is the domain tag followed by the transaction
+    bytes_t message(32, 0);
+    const char tag[] = "FLOW-V0.0-transaction";
+    std::copy(tag, tag + sizeof(tag) - 1, message.begin());
+    message.insert(message.end(), c.blob.begin(), c.blob.end());
+
+    const crypto_verify_item_t item = {c.path, answer.data(), message.data(), (uint16_t) message.size(),
+                                       signature.data(), (uint16_t) signature.size()};
+    crypto_verify_result_e result;
+    return crypto_verifyBatch(&item, 1, &result) == 1;
+}
+
+static std::vector<tx_case_t> loadCases(const std::string &filename) {
+    std::vector<tx_case_t> answer;
+
+    std::ifstream inFile(filename);
+    if (!inFile.is_open()) {
+        fmt::print(stderr, "Failed to open {}\n", filename);
+        return answer;
+    }
+
+    Json::CharReaderBuilder builder;
+    Json::Value obj;
+    JSONCPP_STRING errs;
+    Json::parseFromStream(builder, inFile, &obj, &errs);
+
+    // Alternate the curve and hash combinations over the cases
+    const uint32_t schemes[] = {0x0201, 0x0301, 0x0203, 0x0303};
+
+    for (const auto &v : obj) {
+        if (!v["valid"].asBool()) {
+            continue;
+        }
+
+        tx_case_t c;
+        c.title = v["title"].asString();
+
+        const bool mainnet = v["chainID"].asString() == "Mainnet";
+        c.path[0] = mainnet ? HDPATH_0_DEFAULT : HDPATH_0_TESTNET;
+        c.path[1] = mainnet ? HDPATH_1_DEFAULT : HDPATH_1_TESTNET;
+        c.path[2] = 0x80000000u | schemes[answer.size() % 4];
+        c.path[3] = 0;
+        c.path[4] = (uint32_t) answer.size() % 16;
+
+        const std::string hex = v["encodedTransactionEnvelopeHex"].asString();
+        c.blob.resize(hex.size() / 2);
+        parseHexString(c.blob.data(), c.blob.size(), hex.c_str());
+        answer.push_back(c);
+    }
+
+    return answer;
+}
+
+static void printLatencies(const std::string &label) {
+    auto &samples = latencies[label];
+    if (samples.empty()) {
+        return;
+    }
+    std::sort(samples.begin(), samples.end());
+
+    double total = 0;
+    for (double s : samples) {
+        total += s;
+    }
+    fmt::print("{:>12} | {:>8} {:>10.0f} {:>10.0f} {:>10.0f} {:>10.0f}\n", label, samples.size(),
+               total / samples.size(), samples[samples.size() / 2], samples[samples.size() * 99 / 100], samples.back());
+}
+
+int main(int argc, char **argv) {
+    const std::string vectorsDir = argc > 1 ? argv[1] : "tests/testvectors";
+    const uint32_t transactions = argc > 2 ? (uint32_t) std::stoul(argv[2]) : 2000;
+
+    auto cases = loadCases(vectorsDir + "/manifestEnvelopeCases.json");
+    const auto other = loadCases(vectorsDir + "/validEnvelopeCases.json");
+    cases.insert(cases.end(), other.begin(), other.end());
+
+    // seed and generator tables are built once, outside of the measurements
+    crypto_host_init();
+    apdu_host_init();
+
+    std::vector<tx_case_t> accepted;
+    std::map<uint16_t, uint32_t> rejected;
+    size_t blobBytes = 0;
+    for (const auto &c : cases) {
+        uint16_t sigLen = 0;
+        const uint16_t sw = sign(c, &sigLen);
+        if (sw != APDU_CODE_OK) {
+            rejected[sw]++;
+            continue;
+        }
+        if (!verify(c, bytes_t(G_io_apdu_buffer, G_io_apdu_buffer + sigLen))) {
+            fmt::print(stderr, "invalid signature: {}\n", c.title);
+            return 1;
+        }
+        accepted.push_back(c);
+        blobBytes += c.blob.size();
+    }
+
+    fmt::print("{} transactions, {} signed and verified, average {} bytes\n", cases.size(), accepted.size(),
+               accepted.empty() ? 0 : blobBytes / accepted.size());
+    for (const auto &r : rejected) {
+        fmt::print("  rejected with {:04X}: {}\n", r.first, r.second);
+    }
+    if (accepted.empty()) {
+        return 1;
+    }
+
+    latencies.clear();
+    apdu_host_review_stats_t before;
+    apdu_host_reviewStats(&before);
+
+    const auto start = bench_clock::now();
+    for (uint32_t i = 0; i < transactions; i++) {
+        uint16_t sigLen = 0;
+        if (sign(accepted[i % accepted.size()], &sigLen) != APDU_CODE_OK || sigLen == 0) {
+            fmt::print(stderr, "sign failed: {}\n", accepted[i % accepted.size()].title);
+            return 1;
+        }
+    }
+    const auto elapsed = std::chrono::duration<double>(bench_clock::now() - start);
+
+    apdu_host_review_stats_t after;
+    apdu_host_reviewStats(&after);
+    const uint32_t reviews = after.reviews - before.reviews;
+
+    fmt::print("{:.0f} tx/s, {:.1f} items and {:.1f} pages per review\n\n", transactions / elapsed.count(),
+               (double) (after.items - before.items) / reviews, (double) (after.pages - before.pages) / reviews);
+
+    // Instructions without a transaction, for reference
+    const uint32_t path[HDPATH_LEN_DEFAULT] = {HDPATH_0_DEFAULT, HDPATH_1_DEFAULT, 0x80000201u, 0, 0};
+    for (uint32_t i = 0; i < transactions; i++) {
+        exchange("get version", apdu(INS_GET_VERSION, 0, nullptr, 0));
+        exchange("get pubkey", apdu(INS_GET_PUBKEY, 0, (const uint8_t *) path, sizeof(path)));
+    }
+
+    fmt::print("{:>12} | {:>8} {:>10} {:>10} {:>10} {:>10}\n", "ns", "count", "mean", "p50", "p99", "max");
+    for (const char *label : {"sign init", "sign add", "sign last", "get version", "get pubkey"}) {
+        printLatencies(label);
+    }
+
+    return 0;
+}
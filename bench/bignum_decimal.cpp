@@ -0,0 +1,89 @@
+/*******************************************************************************
+*   (c) 2021 Zondax GmbH
+*
+*  Licensed under the Apache License, Version 2.0 (the "License");
+*  you may not use this file except in compliance with the License.
+*  You may obtain a copy of the License at
+*
+*      http://www.apache.org/licenses/LICENSE-2.0
+*
+*  Unless required by applicable law or agreed to in writing, software
+*  distributed under the License is distributed on an "AS IS" BASIS,
+*  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+*  See the License for the specific language governing permissions and
+*  limitations under the License.
+********************************************************************************/
+
+// Bignum to decimal microbenchmark
+//
+// Compares the double dabble conversion (bignumBigEndian_to_bcd + bignumBigEndian_bcdprint) with the
+// base 10^9 limb conversion (bignumBigEndian_to_str) for 64, 128 and 256 bit values.
+//
+// Usage: bench-bignum_decimal [iterations]
+
+#include <fmt/core.h>
+
+#include <chrono>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <bignum.h>
+
+namespace {
+    typedef std::chrono::steady_clock bench_clock;
+
+    template<typename F>
+    double nsPerValue(uint32_t iterations, F f) {
+        size_t sink = 0;
+        const auto start = bench_clock::now();
+        for (uint32_t i = 0; i < iterations; i++) {
+            sink += f(i);
+        }
+        const auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(bench_clock::now() - start);
+        if (sink == 0) {
+            fmt::print(stderr, "conversion failed\n");
+        }
+        return (double) elapsed.count() / iterations;
+    }
+}
+
+int main(int argc, char **argv) {
+    const uint32_t iterations = argc > 1 ? (uint32_t) std::stoul(argv[1]) : 100000;
+    const uint16_t widths[] = {8, 16, 32};
+    const size_t valueCount = 64;
+
+    fmt::print("{:>6} | {:>14} {:>14} {:>8}\n", "bits", "double dabble", "base 10^9", "speedup");
+
+    std::mt19937 rng(42);
+    for (const auto width : widths) {
+        std::vector<std::vector<uint8_t>> values(valueCount, std::vector<uint8_t>(width));
+        for (auto &v : values) {
+            for (auto &b : v) {
+                b = (uint8_t) rng();
+            }
+        }
+
+        // Each input byte needs up to 2.41 decimal digits, a BCD byte holds 2
+        uint8_t bcd[2 * 32];
+        const uint16_t bcdLen = (uint16_t) (width * 5 / 4 + 1);
+        char out[100];
+
+        const double reference = nsPerValue(iterations, [&](uint32_t i) {
+            const auto &v = values[i % valueCount];
+            bignumBigEndian_to_bcd(bcd, bcdLen, v.data(), width);
+            bignumBigEndian_bcdprint(out, sizeof(out), bcd, bcdLen);
+            return (size_t) out[0];
+        });
+        const double limbs = nsPerValue(iterations, [&](uint32_t i) {
+            const auto &v = values[i % valueCount];
+            bignumBigEndian_to_str(out, sizeof(out), v.data(), width);
+            return (size_t) out[0];
+        });
+
+        fmt::print("{:>6} | {:>11.1f} ns {:>11.1f} ns {:>7.1f}x\n",
+                   8 * width, reference, limbs, reference / limbs);
+    }
+
+    return 0;
+}
@@ -0,0 +1,115 @@
+/*******************************************************************************
+*   (c) 2021 Zondax GmbH
+*
+*  Licensed under the Apache License, Version 2.0 (the "License");
+*  you may not use this file except in compliance with the License.
+*  You may obtain a copy of the License at
+*
+*      http://www.apache.org/licenses/LICENSE-2.0
+*
+*  Unless required by applicable law or agreed to in writing, software
+*  distributed under the License is distributed on an "AS IS" BASIS,
+*  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+*  See the License for the specific language governing permissions and
+*  limitations under the License.
+********************************************************************************/
+
+// Host signing throughput
+//
+// Runs crypto_sign (BIP32 derivation, digest, RFC6979 ECDSA and RSV conversion) and crypto_extractPublicKey
+// through the host crypto backend for every curve and hash combination, then crypto_verifyBatch on the
+// signatures of 16 accounts, one at a time and as a single batch.
+//
+// Usage: bench-crypto_sign [iterations]
+
+#include <fmt/core.h>
+
+#include <chrono>
+#include <string>
+#include <vector>
+
+#include <crypto.h>
+#include <crypto_host.h>
+
+namespace {
+    typedef std::chrono::steady_clock bench_clock;
+
+    template<typename F>
+    double perSecond(uint32_t iterations, F f) {
+        const auto start = bench_clock::now();
+        for (uint32_t i = 0; i < iterations; i++) {
+            if (f(i) != zxerr_ok) {
+                fmt::print(stderr, "operation failed\n");
+                return 0;
+            }
+        }
+        const auto elapsed = std::chrono::duration<double>(bench_clock::now() - start);
+        return iterations / elapsed.count();
+    }
+}
+
+int main(int argc, char **argv) {
+    const uint32_t iterations = argc > 1 ? (uint32_t) std::stoul(argv[1]) : 2000;
+
+    const struct {
+        const char *name;
+        uint32_t scheme;
+    } schemes[] = {
+            {"secp256k1 sha2", 0x0201},
+            {"secp256k1 sha3", 0x0203},
+            {"secp256r1 sha2", 0x0301},
+            {"secp256r1 sha3", 0x0303},
+    };
+
+    // seed and generator tables are built once, outside of the measurements
+    crypto_host_init();
+
+    uint8_t message[300];
+    for (size_t i = 0; i < sizeof(message); i++) {
+        message[i] = (uint8_t) i;
+    }
+
+    fmt::print("{:>16} | {:>12} {:>12} {:>12} {:>12}\n", "scheme", "sign/s", "pubkey/s", "verify/s", "batch/s");
+    for (const auto &s : schemes) {
+        uint32_t path[HDPATH_LEN_DEFAULT] = {HDPATH_0_DEFAULT, HDPATH_1_DEFAULT, 0x80000000u | s.scheme, 0, 0};
+
+        const double signs = perSecond(iterations, [&](uint32_t i) {
+            uint8_t signature[32 + 32 + 1 + 73];
+            uint16_t sigSize = 0;
+            path[4] = i % 16;
+            return crypto_sign(path, message, sizeof(message), signature, sizeof(signature), &sigSize);
+        });
+        const double pubkeys = perSecond(iterations, [&](uint32_t i) {
+            uint8_t pubKey[SECP256K1_PK_LEN];
+            path[4] = i % 16;
+            return crypto_extractPublicKey(path, pubKey, sizeof(pubKey));
+        });
+
+        std::vector<uint8_t> answers(iterations * 200);
+        std::vector<uint8_t> signatures(iterations * 138);
+        std::vector<crypto_verify_item_t> items(iterations);
+        std::vector<uint32_t> paths(iterations * HDPATH_LEN_DEFAULT);
+        for (uint32_t i = 0; i < iterations; i++) {
+            uint32_t *itemPath = &paths[i * HDPATH_LEN_DEFAULT];
+            std::copy(path, path + HDPATH_LEN_DEFAULT, itemPath);
+            itemPath[4] = i % 16;
+            uint16_t addrLen = 0, sigSize = 0;
+            crypto_fillAddress(itemPath, &answers[i * 200], 200, &addrLen);
+            crypto_sign(itemPath, message, sizeof(message), &signatures[i * 138], 138, &sigSize);
+            items[i] = {itemPath, &answers[i * 200], message, sizeof(message), &signatures[i * 138], sigSize};
+        }
+
+        std::vector<crypto_verify_result_e> results(iterations);
+        const double verifies = perSecond(iterations, [&](uint32_t i) {
+            return crypto_verifyBatch(&items[i], 1, &results[i]) == 1 ? zxerr_ok : zxerr_unknown;
+        });
+        const double batch = perSecond(1, [&](uint32_t) {
+            return crypto_verifyBatch(items.data(), items.size(), results.data()) == items.size()
+                   ? zxerr_ok : zxerr_unknown;
+        }) * iterations;
+
+        fmt::print("{:>16} | {:>12.0f} {:>12.0f} {:>12.0f} {:>12.0f}\n", s.name, signs, pubkeys, verifies, batch);
+    }
+
+    return 0;
+}
@@ -0,0 +1,124 @@
+/*******************************************************************************
+*   (c) 2021 Zondax GmbH
+*
+*  Licensed under the Apache License, Version 2.0 (the "License");
+*  you may not use this file except in compliance with the License.
+*  You may obtain a copy of the License at
+*
+*      http://www.apache.org/licenses/LICENSE-2.0
+*
+*  Unless required by applicable law or agreed to in writing, software
+*  distributed under the License is distributed on an "AS IS" BASIS,
+*  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+*  See the License for the specific language governing permissions and
+*  limitations under the License.
+********************************************************************************/
+
+// Hex codec microbenchmark
+//
+// Compares hex_encode / hex_decode against the nibble at a time encoder and the ctype based decoder they replaced,
+// for the sizes the app deals with: addresses (8), block ids and hashes (32) and transaction blobs.
+//
+// Usage: bench-hex_codec [iterations]
+
+#include <fmt/core.h>
+
+#include <cctype>
+#include <chrono>
+#include <string>
+#include <vector>
+
+#include <hexutils.h>
+
+namespace {
+    size_t referenceEncode(char *dst, size_t dstLen, const uint8_t *src, size_t count) {
+        if (dstLen < (count * 2 + 1)) {
+            return 0;
+        }
+        const char hexchars[] = "0123456789abcdef";
+        for (size_t i = 0; i < count; i++, src++) {
+            *dst++ = hexchars[*src >> 4u];
+            *dst++ = hexchars[*src & 0x0Fu];
+        }
+        *dst = 0;
+        return count * 2;
+    }
+
+    uint8_t referenceHex2dec(char c, uint8_t *out) {
+        c = (char) tolower((int) c);
+        if (!isxdigit((int) c)) {
+            return 1;
+        }
+        if (isdigit((int) c)) {
+            *out = (char) (c - '0');
+            return 0;
+        }
+        *out = (char) (c - 'a' + 10);
+        return 0;
+    }
+
+    size_t referenceDecode(uint8_t *out, size_t outLen, const char *input, size_t len) {
+        if ((len / 2) > outLen || len % 2 == 1) {
+            return 0;
+        }
+        for (size_t i = 0; i < len; i += 2) {
+            uint8_t tmp1, tmp2;
+            if (referenceHex2dec(input[i], &tmp1) || referenceHex2dec(input[i + 1], &tmp2)) {
+                return 0;
+            }
+            out[i >> 1u] = (tmp1 << 4u) + tmp2;
+        }
+        return len / 2;
+    }
+
+    typedef std::chrono::steady_clock bench_clock;
+
+    template<typename F>
+    double nsPerByte(size_t bytes, uint32_t iterations, F f) {
+        size_t sink = 0;
+        const auto start = bench_clock::now();
+        for (uint32_t i = 0; i < iterations; i++) {
+            sink += f();
+        }
+        const auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(bench_clock::now() - start);
+        if (sink == 0) {
+            fmt::print(stderr, "codec failed\n");
+        }
+        return (double) elapsed.count() / iterations / bytes;
+    }
+}
+
+int main(int argc, char **argv) {
+    const uint32_t iterations = argc > 1 ? (uint32_t) std::stoul(argv[1]) : 100000;
+    const size_t sizes[] = {8, 32, 256, 4096};
+
+    fmt::print("{:>6} | {:>12} {:>12} {:>8} | {:>12} {:>12} {:>8}\n",
+               "bytes", "enc ref", "enc new", "speedup", "dec ref", "dec new", "speedup");
+
+    for (const auto size : sizes) {
+        std::vector<uint8_t> data(size);
+        for (size_t i = 0; i < size; i++) {
+            data[i] = (uint8_t) (i * 131 + 7);
+        }
+        std::vector<char> text(2 * size + 1);
+        std::vector<uint8_t> decoded(size);
+
+        const double encRef = nsPerByte(size, iterations, [&]() {
+            return referenceEncode(text.data(), text.size(), data.data(), size);
+        });
+        const double encNew = nsPerByte(size, iterations, [&]() {
+            return hex_encode(text.data(), text.size(), data.data(), size);
+        });
+        const double decRef = nsPerByte(size, iterations, [&]() {
+            return referenceDecode(decoded.data(), decoded.size(), text.data(), 2 * size);
+        });
+        const double decNew = nsPerByte(size, iterations, [&]() {
+            return hex_decode(decoded.data(), decoded.size(), text.data(), 2 * size);
+        });
+
+        fmt::print("{:>6} | {:>9.3f} ns {:>9.3f} ns {:>7.1f}x | {:>9.3f} ns {:>9.3f} ns {:>7.1f}x\n",
+                   size, encRef, encNew, encRef / encNew, decRef, decNew, decRef / decNew);
+    }
+
+    return 0;
+}
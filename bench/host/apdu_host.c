@@ -0,0 +1,238 @@
+/*******************************************************************************
+*   (c) 2021 Zondax GmbH
+*
+*  Licensed under the Apache License, Version 2.0 (the "License");
+*  you may not use this file except in compliance with the License.
+*  You may obtain a copy of the License at
+*
+*      http://www.apache.org/licenses/LICENSE-2.0
+*
+*  Unless required by applicable law or agreed to in writing, software
+*  distributed under the License is distributed on an "AS IS" BASIS,
+*  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+*  See the License for the specific language governing permissions and
+*  limitations under the License.
+********************************************************************************/
+
+#include "apdu_host.h"
+
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "app_main.h"
+#include "view.h"
+#include "view_internal.h"
+#include "zxmacros.h"
+
+unsigned char G_io_apdu_buffer[IO_APDU_BUFFER_SIZE];
+
+static try_context_t *try_context_current;
+
+// Length of the reply sent by io_exchange during the current exchange
+static uint16_t host_reply_len;
+
+typedef struct {
+    bool pending;
+    viewfunc_getItem_t getItem;
+    viewfunc_getNumItems_t getNumItems;
+    viewfunc_accept_t accept;
+} host_review_t;
+
+static host_review_t host_review;
+static apdu_host_review_stats_t host_review_stats;
+
+////////////////////////////////////////////////////////
+// os.h
+
+try_context_t *try_context_get() {
+    return try_context_current;
+}
+
+try_context_t *try_context_set(try_context_t *context) {
+    try_context_t *previous = try_context_current;
+    try_context_current = context;
+    return previous;
+}
+
+void os_longjmp(unsigned int exception) {
+    if (try_context_current == NULL) {
+        fprintf(stderr, "exception 0x%04X thrown outside of TRY\n", exception);
+        abort();
+    }
+    longjmp(try_context_current->jmp_buf, (int) exception);
+}
+
+static unsigned int host_version(unsigned char *version, unsigned int maxlength) {
+    const char name[] = "host";
+    const unsigned int len = sizeof(name) - 1 < maxlength ? sizeof(name) - 1 : maxlength;
+    MEMCPY(version, name, len);
+    return len;
+}
+
+unsigned int os_version(unsigned char *version, unsigned int maxlength) {
+    return host_version(version, maxlength);
+}
+
+unsigned int os_seph_version(unsigned char *version, unsigned int maxlength) {
+    return host_version(version, maxlength);
+}
+
+// The device restarts the app
+void reset() {
+    app_init();
+}
+
+////////////////////////////////////////////////////////
+// os_io_seproxyhal.h
+
+unsigned short io_exchange(unsigned char channel_and_flags, unsigned short tx_len) {
+    // The app only sends replies of approved reviews, APDUs are received by apdu_host_exchange
+    if ((channel_and_flags & IO_RETURN_AFTER_TX) == 0) {
+        fprintf(stderr, "io_exchange can only send on the host\n");
+        abort();
+    }
+    host_reply_len = tx_len;
+    return 0;
+}
+
+void io_seproxyhal_init() {}
+
+void io_seproxyhal_general_status() {}
+
+unsigned int io_seproxyhal_spi_is_status_sent() {
+    return 1;
+}
+
+void io_seproxyhal_spi_send(const unsigned char *buffer, unsigned short length) {}
+
+unsigned short io_seproxyhal_spi_recv(unsigned char *buffer, unsigned short maxlength, unsigned int flags) {
+    return 0;
+}
+
+void USB_power(unsigned char enabled) {}
+
+////////////////////////////////////////////////////////
+// view.h
+
+void view_init() {}
+
+void view_idle_show(uint8_t item_idx) {}
+
+void view_error_show() {}
+
+void view_review_init(viewfunc_getItem_t viewfuncGetItem,
+                      viewfunc_getNumItems_t viewfuncGetNumItems,
+                      viewfunc_accept_t viewfuncAccept) {
+    host_review.getItem = viewfuncGetItem;
+    host_review.getNumItems = viewfuncGetNumItems;
+    host_review.accept = viewfuncAccept;
+}
+
+void view_review_show() {
+    host_review.pending = true;
+}
+
+// Scrolls through every page as a user would and approves
+static void host_review_run() {
+    char key[MAX_CHARS_PER_KEY_LINE];
+    char value[MAX_CHARS_PER_VALUE1_LINE];
+
+    host_review.pending = false;
+    host_review_stats.reviews++;
+
+    uint8_t numItems = 0;
+    if (host_review.getNumItems(&numItems) != zxerr_ok) {
+        host_review_stats.errors++;
+        numItems = 0;
+    }
+
+    for (uint8_t idx = 0; idx < numItems; idx++) {
+        uint8_t pageCount = 1;
+        for (uint8_t pageIdx = 0; pageIdx < pageCount; pageIdx++) {
+            if (host_review.getItem(idx, key, sizeof(key), value, sizeof(value), pageIdx, &pageCount) != zxerr_ok) {
+                host_review_stats.errors++;
+                break;
+            }
+            host_review_stats.pages++;
+        }
+        host_review_stats.items++;
+    }
+
+    if (host_review.accept != NULL) {
+        host_review.accept();
+    }
+}
+
+////////////////////////////////////////////////////////
+
+void apdu_host_init() {
+    MEMZERO(&host_review, sizeof(host_review));
+    MEMZERO(&host_review_stats, sizeof(host_review_stats));
+    app_init();
+}
+
+void apdu_host_reviewStats(apdu_host_review_stats_t *stats) {
+    *stats = host_review_stats;
+}
+
+uint16_t apdu_host_exchange(const uint8_t *apdu, uint16_t apduLen) {
+    volatile uint32_t rx = apduLen;
+    volatile uint32_t tx = 0;
+    volatile uint32_t flags = 0;
+    volatile uint16_t sw = 0;
+
+    if (apduLen > sizeof(G_io_apdu_buffer)) {
+        set_code(G_io_apdu_buffer, 0, APDU_CODE_WRONG_LENGTH);
+        return 2;
+    }
+    MEMCPY(G_io_apdu_buffer, apdu, apduLen);
+    host_reply_len = 0;
+
+    // Same as the loop in main.c
+    BEGIN_TRY
+    {
+        TRY
+        {
+            if (rx == 0)
+                THROW(APDU_CODE_EMPTY_BUFFER);
+
+            handle_generic_apdu(&flags, &tx, rx);
+            CHECK_APP_CANARY()
+
+            handleApdu(&flags, &tx, rx);
+            CHECK_APP_CANARY()
+
+            // On the device the next io_exchange waits for the user, the reply is sent from the review
+            if ((flags & IO_ASYNCH_REPLY) && host_review.pending) {
+                host_review_run();
+                tx = host_reply_len;
+            }
+        }
+        CATCH(EXCEPTION_IO_RESET)
+        {
+            app_init();
+            tx = 0;
+        }
+        CATCH_OTHER(e)
+        {
+            switch (e & 0xF000) {
+                case 0x6000:
+                case 0x9000:
+                    sw = e;
+                    break;
+                default:
+                    sw = 0x6800 | (e & 0x7FF);
+                    break;
+            }
+            G_io_apdu_buffer[tx] = sw >> 8;
+            G_io_apdu_buffer[tx + 1] = sw;
+            tx += 2;
+        }
+        FINALLY
+        {}
+    }
+    END_TRY;
+
+    return tx;
+}
@@ -0,0 +1,54 @@
+/*******************************************************************************
+*   (c) 2021 Zondax GmbH
+*
+*  Licensed under the Apache License, Version 2.0 (the "License");
+*  you may not use this file except in compliance with the License.
+*  You may obtain a copy of the License at
+*
+*      http://www.apache.org/licenses/LICENSE-2.0
+*
+*  Unless required by applicable law or agreed to in writing, software
+*  distributed under the License is distributed on an "AS IS" BASIS,
+*  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+*  See the License for the specific language governing permissions and
+*  limitations under the License.
+********************************************************************************/
+#pragma once
+
+// In process replay of APDUs through handleApdu, process_chunk, the buffering layer and tx_parse.
+// apdu_handler.c and app/src/common are built against the BOLOS stand-ins in this directory and the host
+// crypto backend. main.c is replaced by apdu_host_exchange, the UI by a review that approves right away.
+// This is for tests and benchmarks only.
+
+#if !defined(TARGET_NANOS) && !defined(TARGET_NANOX) && !defined(TARGET_NANOS2)
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+#include "os_io_seproxyhal.h"
+
+typedef struct {
+    uint32_t reviews;
+    uint32_t items;
+    uint32_t pages;
+    // getItem calls that did not return zxerr_ok, the review is approved anyway
+    uint32_t errors;
+} apdu_host_review_stats_t;
+
+// app_init, as main.c runs it before the first APDU
+void apdu_host_init(void);
+
+// One turn of the main.c loop. An asynchronous reply is completed by the review: every page of every item is
+// rendered with the Nano S line sizes and then approved.
+// The reply (data and status word) is left in G_io_apdu_buffer, returns its length.
+uint16_t apdu_host_exchange(const uint8_t *apdu, uint16_t apduLen);
+
+void apdu_host_reviewStats(apdu_host_review_stats_t *stats);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
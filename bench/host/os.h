@@ -0,0 +1,115 @@
+/*******************************************************************************
+*   (c) 2021 Zondax GmbH
+*
+*  Licensed under the Apache License, Version 2.0 (the "License");
+*  you may not use this file except in compliance with the License.
+*  You may obtain a copy of the License at
+*
+*      http://www.apache.org/licenses/LICENSE-2.0
+*
+*  Unless required by applicable law or agreed to in writing, software
+*  distributed under the License is distributed on an "AS IS" BASIS,
+*  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+*  See the License for the specific language governing permissions and
+*  limitations under the License.
+********************************************************************************/
+#pragma once
+
+// Host stand-in for the BOLOS SDK os.h: only what apdu_handler.c and app/src/common use.
+// Exceptions follow the SDK, setjmp based with a chain of open TRY blocks.
+
+#if !defined(TARGET_NANOS) && !defined(TARGET_NANOX) && !defined(TARGET_NANOS2)
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <setjmp.h>
+#include <stdint.h>
+#include <string.h>
+
+#define NV_CONST
+#define NV_VOLATILE
+
+// Nano X
+#define TARGET_ID 0x33000004
+
+// The app Makefile passes the real version
+#ifndef LEDGER_MAJOR_VERSION
+#define LEDGER_MAJOR_VERSION 0
+#define LEDGER_MINOR_VERSION 0
+#define LEDGER_PATCH_VERSION 0
+#endif
+
+#define INVALID_PARAMETER 2
+#define EXCEPTION_IO_RESET 0x10
+
+typedef unsigned short exception_t;
+
+typedef struct try_context_s {
+    jmp_buf jmp_buf;
+    struct try_context_s *previous;
+    exception_t ex;
+} try_context_t;
+
+try_context_t *try_context_get(void);
+
+try_context_t *try_context_set(try_context_t *context);
+
+// Jumps to the innermost open TRY, aborts when there is none
+void os_longjmp(unsigned int exception) __attribute__((noreturn));
+
+#define BEGIN_TRY                                                   \
+    {                                                               \
+        try_context_t __try_context;
+
+#define TRY                                                         \
+        __try_context.ex = setjmp(__try_context.jmp_buf);           \
+        if (__try_context.ex == 0) {                                \
+            __try_context.previous = try_context_set(&__try_context);
+
+#define CATCH(x)                                                    \
+            goto __FINALLY;                                         \
+        } else if (__try_context.ex == (x)) {                       \
+            __try_context.ex = 0;                                   \
+            try_context_set(__try_context.previous);
+
+#define CATCH_OTHER(e)                                              \
+            goto __FINALLY;                                         \
+        } else {                                                    \
+            exception_t e = __try_context.ex;                       \
+            __try_context.ex = 0;                                   \
+            try_context_set(__try_context.previous);
+
+#define FINALLY                                                     \
+            goto __FINALLY;                                         \
+        }                                                           \
+        __FINALLY:                                                  \
+        if (try_context_get() == &__try_context) {                  \
+            try_context_set(__try_context.previous);                \
+        }
+
+#define END_TRY                                                     \
+        if (__try_context.ex != 0) {                                \
+            THROW(__try_context.ex);                                \
+        }                                                           \
+    }
+
+#define THROW(x) os_longjmp(x)
+
+#define os_memcmp memcmp
+#define os_memcpy memcpy
+#define os_memmove memmove
+#define os_memset memset
+
+unsigned int os_version(unsigned char *version, unsigned int maxlength);
+
+unsigned int os_seph_version(unsigned char *version, unsigned int maxlength);
+
+void reset(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,67 @@
+/*******************************************************************************
+*   (c) 2021 Zondax GmbH
+*
+*  Licensed under the Apache License, Version 2.0 (the "License");
+*  you may not use this file except in compliance with the License.
+*  You may obtain a copy of the License at
+*
+*      http://www.apache.org/licenses/LICENSE-2.0
+*
+*  Unless required by applicable law or agreed to in writing, software
+*  distributed under the License is distributed on an "AS IS" BASIS,
+*  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+*  See the License for the specific language governing permissions and
+*  limitations under the License.
+********************************************************************************/
+#pragma once
+
+// Host stand-in for the BOLOS SDK os_io_seproxyhal.h.
+// There is no SE proxy: io_exchange only records the length of the reply left in G_io_apdu_buffer.
+
+#include "os.h"
+
+#if !defined(TARGET_NANOS) && !defined(TARGET_NANOX) && !defined(TARGET_NANOS2)
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define IO_APDU_BUFFER_SIZE (5 + 255)
+#define IO_SEPROXYHAL_BUFFER_SIZE_B 128
+
+#define CHANNEL_APDU 0
+#define CHANNEL_KEYBOARD 1
+#define CHANNEL_SPI 2
+
+#define IO_RESET_AFTER_REPLIED 0x80
+#define IO_RECEIVE_DATA 0x40
+#define IO_RETURN_AFTER_TX 0x20
+#define IO_ASYNCH_REPLY 0x10
+#define IO_FLAGS 0xF0
+
+#define SEPROXYHAL_TAG_BUTTON_PUSH_EVENT 0x05
+#define SEPROXYHAL_TAG_FINGER_EVENT 0x0C
+#define SEPROXYHAL_TAG_DISPLAY_PROCESSED_EVENT 0x0D
+#define SEPROXYHAL_TAG_TICKER_EVENT 0x0E
+
+extern unsigned char G_io_apdu_buffer[IO_APDU_BUFFER_SIZE];
+
+unsigned short io_exchange(unsigned char channel_and_flags, unsigned short tx_len);
+
+void io_seproxyhal_init(void);
+
+void io_seproxyhal_general_status(void);
+
+unsigned int io_seproxyhal_spi_is_status_sent(void);
+
+void io_seproxyhal_spi_send(const unsigned char *buffer, unsigned short length);
+
+unsigned short io_seproxyhal_spi_recv(unsigned char *buffer, unsigned short maxlength, unsigned int flags);
+
+void USB_power(unsigned char enabled);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
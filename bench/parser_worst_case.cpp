@@ -0,0 +1,423 @@
+/*******************************************************************************
+*   (c) 2021 Zondax GmbH
+*
+*  Licensed under the Apache License, Version 2.0 (the "License");
+*  you may not use this file except in compliance with the License.
+*  You may obtain a copy of the License at
+*
+*      http://www.apache.org/licenses/LICENSE-2.0
+*
+*  Unless required by applicable law or agreed to in writing, software
+*  distributed under the License is distributed on an "AS IS" BASIS,
+*  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+*  See the License for the specific language governing permissions and
+*  limitations under the License.
+********************************************************************************/
+
+// Worst case parser benchmark
+//
+// For every script type found in the test vectors, the transaction is inflated as far as the parser still
+// accepts it: 16 authorizers, arguments up to PARSER_MAX_ARGCOUNT - 1, argument arrays up to
+// MAX_JSON_ARRAY_TOKEN_COUNT (or until MAX_NUMBER_OF_TOKENS is reached) and long string arguments.
+// Parse, validate and full render are then timed and the work counted by the parser is reported, together with
+// the peak zbuffer scratch memory.
+//
+// Usage: bench-parser_worst_case [testvectors directory] [iterations]
+
+#include <json/json.h>
+#include <fmt/core.h>
+
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <map>
+#include <string>
+#include <vector>
+
+#include <hexutils.h>
+#include <zbuffer.h>
+#include "parser.h"
+
+// Mirror the limits in parser.c
+#define MAX_JSON_ARRAY_TOKEN_COUNT 64
+#define MAX_AUTHORIZERS 16
+// Longest string a device transaction buffer can comfortably hold
+#define MAX_STRING_LENGTH 255
+
+#define DISPLAY_BUFFER_LEN 40
+
+typedef std::vector<uint8_t> bytes_t;
+
+////////////////////////////////////////////////////////
+// RLP encoding
+
+static void rlpLength(bytes_t &out, size_t len, uint8_t shortOffset, uint8_t longOffset) {
+    if (len <= 55) {
+        out.push_back(shortOffset + len);
+        return;
+    }
+
+    bytes_t lenBytes;
+    for (size_t tmp = len; tmp > 0; tmp >>= 8u) {
+        lenBytes.insert(lenBytes.begin(), (uint8_t) (tmp & 0xFFu));
+    }
+    out.push_back(longOffset + lenBytes.size());
+    out.insert(out.end(), lenBytes.begin(), lenBytes.end());
+}
+
+static bytes_t rlpString(const bytes_t &data) {
+    bytes_t out;
+    if (data.size() == 1 && data[0] < 0x80) {
+        return data;
+    }
+    rlpLength(out, data.size(), 0x80, 0xb7);
+    out.insert(out.end(), data.begin(), data.end());
+    return out;
+}
+
+static bytes_t rlpString(const std::string &data) {
+    return rlpString(bytes_t(data.begin(), data.end()));
+}
+
+static bytes_t rlpUint(uint64_t value) {
+    bytes_t data;
+    for (; value > 0; value >>= 8u) {
+        data.insert(data.begin(), (uint8_t) (value & 0xFFu));
+    }
+    return rlpString(data);
+}
+
+static bytes_t rlpList(const std::vector<bytes_t> &items) {
+    bytes_t payload;
+    for (const auto &item : items) {
+        payload.insert(payload.end(), item.begin(), item.end());
+    }
+    bytes_t out;
+    rlpLength(out, payload.size(), 0xc0, 0xf7);
+    out.insert(out.end(), payload.begin(), payload.end());
+    return out;
+}
+
+static bytes_t fromHex(const std::string &s) {
+    bytes_t out(s.size() / 2);
+    parseHexString(out.data(), out.size(), s.c_str());
+    return out;
+}
+
+////////////////////////////////////////////////////////
+// Transactions
+
+typedef struct {
+    std::string title;
+    std::string chainID;
+    Json::Value message;
+} tx_template_t;
+
+static std::string toCompactJson(const Json::Value &v) {
+    Json::StreamWriterBuilder builder;
+    builder["indentation"] = "";
+    return Json::writeString(builder, v);
+}
+
+static bytes_t encodeTx(const Json::Value &message) {
+    std::vector<bytes_t> arguments;
+    for (const auto &a : message["arguments"]) {
+        arguments.push_back(rlpString(toCompactJson(a)));
+    }
+
+    std::vector<bytes_t> authorizers;
+    for (const auto &a : message["authorizers"]) {
+        authorizers.push_back(rlpString(fromHex(a.asString())));
+    }
+
+    const auto payload = rlpList({
+        rlpString(message["script"].asString()),
+        rlpList(arguments),
+        rlpString(fromHex(message["refBlock"].asString())),
+        rlpUint(message["gasLimit"].asUInt64()),
+        rlpString(fromHex(message["proposalKey"]["address"].asString())),
+        rlpUint(message["proposalKey"]["keyId"].asUInt64()),
+        rlpUint(message["proposalKey"]["sequenceNum"].asUInt64()),
+        rlpString(fromHex(message["payer"].asString())),
+        rlpList(authorizers),
+    });
+
+    return rlpList({payload});
+}
+
+static void setChain(const std::string &chainID) {
+    hdPath[0] = HDPATH_0_DEFAULT;
+    hdPath[1] = HDPATH_1_DEFAULT;
+    if (chainID == "Testnet" || chainID == "Emulator") {
+        hdPath[0] = HDPATH_0_TESTNET;
+        hdPath[1] = HDPATH_1_TESTNET;
+    }
+}
+
+static parser_error_t renderAll(parser_context_t *ctx) {
+    char key[DISPLAY_BUFFER_LEN];
+    char value[DISPLAY_BUFFER_LEN];
+
+    uint8_t numItems = 0;
+    parser_error_t err = parser_getNumItems(ctx, &numItems);
+    if (err != PARSER_OK) {
+        return err;
+    }
+
+    for (uint8_t idx = 0; idx < numItems; idx++) {
+        uint8_t pageCount = 1;
+        for (uint8_t pageIdx = 0; pageIdx < pageCount; pageIdx++) {
+            err = parser_getItem(ctx, idx, key, sizeof(key), value, sizeof(value), pageIdx, &pageCount);
+            if (err != PARSER_OK) {
+                return err;
+            }
+        }
+    }
+
+    return PARSER_OK;
+}
+
+static bool isAccepted(const Json::Value &message) {
+    const auto blob = encodeTx(message);
+    parser_context_t ctx;
+    return parser_parse(&ctx, blob.data(), blob.size()) == PARSER_OK &&
+           parser_validate(&ctx) == PARSER_OK &&
+           renderAll(&ctx) == PARSER_OK;
+}
+
+////////////////////////////////////////////////////////
+// Inflation
+
+// Returns the array holding the elements of an Array or Optional(Array) argument
+static Json::Value *argumentArray(Json::Value &argument) {
+    if (argument["type"] == "Array" && argument["value"].isArray()) {
+        return &argument["value"];
+    }
+    if (argument["type"] == "Optional" && argument["value"].isObject()) {
+        return argumentArray(argument["value"]);
+    }
+    return nullptr;
+}
+
+static Json::Value *argumentString(Json::Value &argument) {
+    if (argument["type"] == "String") {
+        return &argument["value"];
+    }
+    if (argument["type"] == "Optional" && argument["value"].isObject()) {
+        return argumentString(argument["value"]);
+    }
+    return nullptr;
+}
+
+// Grows every argument string by repeating its own content, so hex strings stay hex
+static void inflateStrings(Json::Value &message) {
+    for (auto &argument : message["arguments"]) {
+        Json::Value *value = argumentString(argument);
+        if (value == nullptr || value->asString().empty()) {
+            continue;
+        }
+
+        const std::string original = value->asString();
+        for (size_t len = MAX_STRING_LENGTH; len > original.size(); len--) {
+            std::string inflated;
+            while (inflated.size() < len) {
+                inflated += original;
+            }
+            *value = inflated.substr(0, len);
+            if (isAccepted(message)) {
+                break;
+            }
+            *value = original;
+        }
+    }
+}
+
+static void inflateArrays(Json::Value &message) {
+    for (auto &argument : message["arguments"]) {
+        Json::Value *array = argumentArray(argument);
+        if (array == nullptr || array->empty()) {
+            continue;
+        }
+
+        const Json::Value original = *array;
+        for (uint32_t count = MAX_JSON_ARRAY_TOKEN_COUNT; count > original.size(); count--) {
+            Json::Value inflated(Json::arrayValue);
+            for (uint32_t i = 0; i < count; i++) {
+                inflated.append(original[i % original.size()]);
+            }
+            *array = inflated;
+            if (isAccepted(message)) {
+                break;
+            }
+            *array = original;
+        }
+    }
+}
+
+static void inflateArguments(Json::Value &message) {
+    Json::Value &arguments = message["arguments"];
+    if (arguments.empty()) {
+        return;
+    }
+
+    while (arguments.size() < PARSER_MAX_ARGCOUNT - 1) {
+        arguments.append(arguments[arguments.size() - 1]);
+        if (!isAccepted(message)) {
+            arguments.resize(arguments.size() - 1);
+            return;
+        }
+    }
+}
+
+static void inflateAuthorizers(Json::Value &message) {
+    const Json::Value original = message["authorizers"];
+    Json::Value inflated(Json::arrayValue);
+    for (uint32_t i = 0; i < MAX_AUTHORIZERS; i++) {
+        inflated.append(message["payer"]);
+    }
+    message["authorizers"] = inflated;
+    if (!isAccepted(message)) {
+        message["authorizers"] = original;
+    }
+}
+
+////////////////////////////////////////////////////////
+// Measurement
+
+typedef struct {
+    double ns;
+    parser_work_t work;
+} phase_result_t;
+
+typedef std::chrono::steady_clock bench_clock;
+
+static double elapsedNs(bench_clock::time_point start, uint32_t iterations) {
+    const auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(bench_clock::now() - start);
+    return (double) elapsed.count() / iterations;
+}
+
+static parser_work_t workDelta(const parser_work_t &after, const parser_work_t &before) {
+    parser_work_t delta;
+    delta.tokensScanned = after.tokensScanned - before.tokensScanned;
+    delta.bytesHashed = after.bytesHashed - before.bytesHashed;
+    delta.itemsRendered = after.itemsRendered - before.itemsRendered;
+    return delta;
+}
+
+static void measure(const bytes_t &blob, uint32_t iterations, phase_result_t results[3]) {
+    parser_context_t ctx;
+    parser_work_t before;
+    parser_work_t after;
+
+    auto start = bench_clock::now();
+    for (uint32_t i = 0; i < iterations; i++) {
+        parser_parse(&ctx, blob.data(), blob.size());
+    }
+    results[0].ns = elapsedNs(start, iterations);
+    parser_getWork(&results[0].work);
+
+    start = bench_clock::now();
+    for (uint32_t i = 0; i < iterations; i++) {
+        parser_validate(&ctx);
+    }
+    results[1].ns = elapsedNs(start, iterations);
+
+    parser_parse(&ctx, blob.data(), blob.size());
+    parser_getWork(&before);
+    parser_validate(&ctx);
+    parser_getWork(&after);
+    results[1].work = workDelta(after, before);
+
+    start = bench_clock::now();
+    for (uint32_t i = 0; i < iterations; i++) {
+        renderAll(&ctx);
+    }
+    results[2].ns = elapsedNs(start, iterations);
+
+    parser_getWork(&before);
+    renderAll(&ctx);
+    parser_getWork(&after);
+    results[2].work = workDelta(after, before);
+}
+
+static std::vector<tx_template_t> loadTemplates(const std::string &filename) {
+    std::vector<tx_template_t> answer;
+
+    std::ifstream inFile(filename);
+    if (!inFile.is_open()) {
+        fmt::print(stderr, "Failed to open {}\n", filename);
+        return answer;
+    }
+
+    Json::CharReaderBuilder builder;
+    Json::Value obj;
+    JSONCPP_STRING errs;
+    Json::parseFromStream(builder, inFile, &obj, &errs);
+
+    for (const auto &v : obj) {
+        if (!v["valid"].asBool()) {
+            continue;
+        }
+        answer.push_back({v["title"].asString(), v["chainID"].asString(), v["envelopeMessage"]});
+    }
+
+    return answer;
+}
+
+int main(int argc, char **argv) {
+    const std::string vectorsDir = argc > 1 ? argv[1] : "tests/testvectors";
+    const uint32_t iterations = argc > 2 ? (uint32_t) std::stoul(argv[2]) : 200;
+
+    std::vector<tx_template_t> templates = loadTemplates(vectorsDir + "/manifestEnvelopeCases.json");
+    const auto other = loadTemplates(vectorsDir + "/validEnvelopeCases.json");
+    templates.insert(templates.end(), other.begin(), other.end());
+
+    // Pick the first template of every script type
+    std::map<int, tx_template_t> byScriptType;
+    for (const auto &t : templates) {
+        setChain(t.chainID);
+        const auto blob = encodeTx(t.message);
+        parser_context_t ctx;
+        if (parser_parse(&ctx, blob.data(), blob.size()) != PARSER_OK) {
+            continue;
+        }
+        const int type = parser_tx_obj.script.type;
+        if (byScriptType.find(type) == byScriptType.end()) {
+            byScriptType[type] = t;
+        }
+    }
+
+    fmt::print("{:>4} {:<44} {:>6} {:>4} {:>4} | {:>10} {:>7} | {:>10} {:>7} | {:>10} {:>7} {:>5} | {:>7}\n",
+               "type", "template", "bytes", "args", "auth",
+               "parse ns", "units", "valid. ns", "units", "render ns", "units", "items", "scratch");
+
+    for (int type = SCRIPT_TOKEN_TRANSFER; type <= SCRIPT_TS02_TRANSFER_TOP_SHOT_MOMENT; type++) {
+        const auto it = byScriptType.find(type);
+        if (it == byScriptType.end()) {
+            fmt::print("{:>4} {:<44} no template\n", type, "-");
+            continue;
+        }
+
+        setChain(it->second.chainID);
+        Json::Value message = it->second.message;
+        inflateAuthorizers(message);
+        inflateArguments(message);
+        inflateArrays(message);
+        inflateStrings(message);
+
+        const auto blob = encodeTx(message);
+        phase_result_t results[3];
+        zb_init();
+        measure(blob, iterations, results);
+
+        fmt::print("{:>4} {:<44} {:>6} {:>4} {:>4} | {:>10.0f} {:>7} | {:>10.0f} {:>7} | {:>10.0f} {:>7} {:>5} | {:>7}\n",
+                   type, it->second.title.substr(0, 44), blob.size(),
+                   message["arguments"].size(), message["authorizers"].size(),
+                   results[0].ns, parser_getWorkUnits(&results[0].work),
+                   results[1].ns, parser_getWorkUnits(&results[1].work),
+                   results[2].ns, parser_getWorkUnits(&results[2].work), results[2].work.itemsRendered,
+                   zb_high_water_mark());
+    }
+
+    return 0;
+}
@@ -0,0 +1,106 @@
+/*******************************************************************************
+*   (c) 2021 Zondax GmbH
+*
+*  Licensed under the Apache License, Version 2.0 (the "License");
+*  you may not use this file except in compliance with the License.
+*  You may obtain a copy of the License at
+*
+*      http://www.apache.org/licenses/LICENSE-2.0
+*
+*  Unless required by applicable law or agreed to in writing, software
+*  distributed under the License is distributed on an "AS IS" BASIS,
+*  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+*  See the License for the specific language governing permissions and
+*  limitations under the License.
+********************************************************************************/
+
+// Host SHA-256 throughput
+//
+// Hashes a batch of script sized messages with picosha2, the portable block function, the selected
+// accelerated block function, and sha256_host_multi with and without the SIMD lanes.
+//
+// Usage: bench-sha256_host [rounds]
+
+#include <fmt/core.h>
+
+#include <chrono>
+#include <string>
+#include <vector>
+
+#include "picosha2.h"
+#include "sha256_host.h"
+
+namespace {
+    typedef std::chrono::steady_clock bench_clock;
+
+    struct batch_t {
+        std::vector<std::vector<uint8_t>> messages;
+        std::vector<const uint8_t *> pointers;
+        std::vector<size_t> lens;
+        size_t totalBytes = 0;
+    };
+
+    batch_t makeBatch(size_t count) {
+        batch_t batch;
+        batch.messages.resize(count);
+        for (size_t i = 0; i < count; i++) {
+            // between 200 and 1000 bytes, the size of typical transaction scripts
+            auto &m = batch.messages[i];
+            m.resize(200 + (i * 37) % 800);
+            for (size_t j = 0; j < m.size(); j++) {
+                m[j] = (uint8_t) (i + j);
+            }
+            batch.pointers.push_back(m.data());
+            batch.lens.push_back(m.size());
+            batch.totalBytes += m.size();
+        }
+        return batch;
+    }
+
+    template<typename F>
+    void measure(const std::string &name, const batch_t &batch, uint32_t rounds, F f) {
+        const auto start = bench_clock::now();
+        for (uint32_t r = 0; r < rounds; r++) {
+            f();
+        }
+        const auto elapsed = std::chrono::duration<double>(bench_clock::now() - start);
+        fmt::print("{:>22} | {:>10.1f} MB/s\n", name, (double) batch.totalBytes * rounds / elapsed.count() / 1e6);
+    }
+}
+
+int main(int argc, char **argv) {
+    const uint32_t rounds = argc > 1 ? (uint32_t) std::stoul(argv[1]) : 20;
+    const batch_t batch = makeBatch(4096);
+    std::vector<uint8_t> digests(batch.pointers.size() * SHA256_HOST_DIGEST_SIZE);
+
+    const auto hashEach = [&]() {
+        for (size_t i = 0; i < batch.pointers.size(); i++) {
+            sha256_host(batch.pointers[i], batch.lens[i], digests.data() + i * SHA256_HOST_DIGEST_SIZE);
+        }
+    };
+    const auto hashMulti = [&]() {
+        sha256_host_multi(batch.pointers.data(), batch.lens.data(), batch.pointers.size(), digests.data());
+    };
+
+    measure("picosha2", batch, rounds, [&]() {
+        for (size_t i = 0; i < batch.pointers.size(); i++) {
+            uint8_t *digest = digests.data() + i * SHA256_HOST_DIGEST_SIZE;
+            picosha2::hash256(batch.pointers[i], batch.pointers[i] + batch.lens[i],
+                              digest, digest + SHA256_HOST_DIGEST_SIZE);
+        }
+    });
+
+    sha256_host_setMode(SHA256_HOST_PORTABLE);
+    measure("portable", batch, rounds, hashEach);
+
+    sha256_host_setMode(SHA256_HOST_AUTO);
+    measure(sha256_host_backend(), batch, rounds, hashEach);
+    measure(std::string("multi ") + sha256_host_multiBackend(), batch, rounds, hashMulti);
+
+    if (sha256_host_setMode(SHA256_HOST_SIMD_LANES)) {
+        measure(std::string("multi ") + sha256_host_multiBackend(), batch, rounds, hashMulti);
+        sha256_host_setMode(SHA256_HOST_AUTO);
+    }
+
+    return 0;
+}
@@ -30,6 +30,7 @@
 #include "addr.h"
 #include "app_mode.h"
 #include "zxerror.h"
+#include "zxformat.h"
 
 #include <string.h>
 #include <stdio.h>
@@ -119,30 +120,97 @@ void h_paging_decrease() {
 ///////////////////////////////////
 // Paging related
 
+// Renders the current item once and keeps what is needed for its pages
+static zxerr_t h_review_cache_item() {
+    viewdata.cache.itemValid = false;
+#if defined(VIEW_CACHE_VALUE_LEN)
+    // The whole value is rendered at once and its pages are sliced from the copy.
+    // Values longer than the copy are paged by getItem.
+    uint8_t pageCount = 1;
+    CHECK_ZXERR(viewdata.viewfuncGetItem(
+            viewdata.itemIdx,
+            viewdata.cache.key, MAX_CHARS_PER_KEY_LINE,
+            viewdata.cache.value, VIEW_CACHE_VALUE_LEN,
+            0, &pageCount))
+
+    viewdata.cache.whole = pageCount == 1;
+    viewdata.cache.pageCount = pageCount;
+    if (viewdata.cache.whole) {
+        const uint16_t pageLen = MAX_CHARS_PER_VALUE1_LINE - 1;
+        viewdata.cache.valueLen = strlen(viewdata.cache.value);
+        if (viewdata.cache.valueLen > pageLen) {
+            viewdata.cache.pageCount = (uint8_t) ((viewdata.cache.valueLen + pageLen - 1) / pageLen);
+        }
+    } else if (pageCount > 1) {
+        viewdata.cache.pageCount = 1;
+        CHECK_ZXERR(viewdata.viewfuncGetItem(
+                viewdata.itemIdx,
+                viewdata.cache.key, MAX_CHARS_PER_KEY_LINE,
+                viewdata.value, MAX_CHARS_PER_VALUE1_LINE,
+                0, &viewdata.cache.pageCount))
+    }
+#else
+    viewdata.cache.pageCount = 1;
+    CHECK_ZXERR(viewdata.viewfuncGetItem(
+            viewdata.itemIdx,
+            viewdata.cache.key, MAX_CHARS_PER_KEY_LINE,
+            viewdata.value, MAX_CHARS_PER_VALUE1_LINE,
+            0, &viewdata.cache.pageCount))
+#endif
+
+    viewdata.cache.itemIdx = viewdata.itemIdx;
+    viewdata.cache.itemValid = true;
+    return zxerr_ok;
+}
+
+// Items are rendered once when they are reached, moving between their pages uses the cache
+static zxerr_t h_review_render() {
+    bool rendered = false;
+    if (!viewdata.cache.itemValid || viewdata.cache.itemIdx != viewdata.itemIdx) {
+        CHECK_ZXERR(h_review_cache_item())
+        rendered = true;
+    }
+
+    viewdata.pageCount = viewdata.cache.pageCount;
+    if (viewdata.pageCount != 0 && viewdata.pageIdx >= viewdata.pageCount) {
+        // get last page
+        viewdata.pageIdx = viewdata.pageCount - 1;
+    }
+
+    MEMCPY(viewdata.key, viewdata.cache.key, MAX_CHARS_PER_KEY_LINE);
+#if defined(VIEW_CACHE_VALUE_LEN)
+    if (viewdata.cache.whole) {
+        uint8_t pageCount = 0;
+        pageStringExt(viewdata.value, MAX_CHARS_PER_VALUE1_LINE,
+                      viewdata.cache.value, viewdata.cache.valueLen,
+                      viewdata.pageIdx, &pageCount);
+        return zxerr_ok;
+    }
+#endif
+    if (rendered && viewdata.pageIdx == 0) {
+        return zxerr_ok;
+    }
+    return viewdata.viewfuncGetItem(
+            viewdata.itemIdx,
+            viewdata.key, MAX_CHARS_PER_KEY_LINE,
+            viewdata.value, MAX_CHARS_PER_VALUE1_LINE,
+            viewdata.pageIdx, &viewdata.pageCount);
+}
+
 zxerr_t h_review_update_data() {
     if (viewdata.viewfuncGetNumItems == NULL) {
         return zxerr_no_data;
     }
 
     do {
-        viewdata.pageCount = 1;
-        CHECK_ZXERR(viewdata.viewfuncGetNumItems(&viewdata.itemCount))
+        if (!viewdata.cache.numItemsValid) {
+            CHECK_ZXERR(viewdata.viewfuncGetNumItems(&viewdata.cache.numItems))
+            viewdata.cache.numItemsValid = true;
+        }
+        viewdata.itemCount = viewdata.cache.numItems;
 
         // be sure we are not out of bounds
-        CHECK_ZXERR(viewdata.viewfuncGetItem(
-                viewdata.itemIdx,
-                viewdata.key, MAX_CHARS_PER_KEY_LINE,
-                viewdata.value, MAX_CHARS_PER_VALUE1_LINE,
-                0, &viewdata.pageCount))
-        if (viewdata.pageCount != 0 && viewdata.pageIdx > viewdata.pageCount) {
-            // try again and get last page
-            viewdata.pageIdx = viewdata.pageCount - 1;
-        }
-        CHECK_ZXERR(viewdata.viewfuncGetItem(
-                viewdata.itemIdx,
-                viewdata.key, MAX_CHARS_PER_KEY_LINE,
-                viewdata.value, MAX_CHARS_PER_VALUE1_LINE,
-                viewdata.pageIdx, &viewdata.pageCount))
+        CHECK_ZXERR(h_review_render())
 
         viewdata.itemCount++;
 
@@ -184,6 +252,7 @@ void view_review_init(viewfunc_getItem_t viewfuncGetItem,
     viewdata.viewfuncGetItem = viewfuncGetItem;
     viewdata.viewfuncGetNumItems = viewfuncGetNumItems;
     viewdata.viewfuncAccept = viewfuncAccept;
+    MEMZERO(&viewdata.cache, sizeof(viewdata.cache));
 }
 
 void view_review_show() {
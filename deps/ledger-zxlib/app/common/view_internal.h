@@ -17,6 +17,7 @@
 #pragma once
 
 #include <stdint.h>
+#include <stdbool.h>
 #include "coin.h"
 #include "zxerror.h"
 #include "view.h"
@@ -33,6 +34,9 @@
 #define MAX_CHARS_PER_VALUE1_LINE   (2*MAX_CHARS_PER_VALUE_LINE+1)
 #define MAX_CHARS_PER_VALUE2_LINE   (MAX_CHARS_PER_VALUE_LINE+1)
 #define MAX_CHARS_HEXMESSAGE        40
+// Values up to this length are kept whole by the review cache, their pages are sliced from the copy.
+// A public key in hex fits, longer values are paged by getItem.
+#define VIEW_CACHE_VALUE_LEN        (128 + 1)
 #endif
 
 // This takes data from G_io_apdu_buffer that is prefilled with the address
@@ -53,6 +57,21 @@ typedef struct {
     uint8_t itemCount;
     uint8_t pageIdx;
     uint8_t pageCount;
+
+    // Item count and last rendered item of the review, reset by view_review_init
+    struct {
+        bool numItemsValid;
+        uint8_t numItems;
+        bool itemValid;
+        uint8_t itemIdx;
+        uint8_t pageCount;
+        char key[MAX_CHARS_PER_KEY_LINE];
+#if defined(VIEW_CACHE_VALUE_LEN)
+        bool whole;
+        uint16_t valueLen;
+        char value[VIEW_CACHE_VALUE_LEN];
+#endif
+    } cache;
 } view_t;
 
 extern view_t viewdata;
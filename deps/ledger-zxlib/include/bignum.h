@@ -29,6 +29,13 @@ void bignumLittleEndian_to_bcd(uint8_t *bcdOut, uint16_t bcdOutLen, const uint8_
 bool_t bignumBigEndian_bcdprint(char *outBuffer, uint16_t outBufferLen, const uint8_t *bcdIn, uint16_t bcdInLen);
 void bignumBigEndian_to_bcd(uint8_t *bcdOut, uint16_t bcdOutLen, const uint8_t *binValue, uint16_t binValueLen);
 
+// Widest value (after dropping leading zero bytes) accepted by the *_to_str functions
+#define BIGNUM_TO_STR_MAX_BYTES 64
+
+// Print a binary value in decimal, the output is the same as *_to_bcd followed by *_bcdprint
+bool_t bignumLittleEndian_to_str(char *outBuffer, uint16_t outBufferLen, const uint8_t *binValue, uint16_t binValueLen);
+bool_t bignumBigEndian_to_str(char *outBuffer, uint16_t outBufferLen, const uint8_t *binValue, uint16_t binValueLen);
+
 
 #ifdef __cplusplus
 }
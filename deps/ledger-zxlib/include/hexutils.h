@@ -25,6 +25,14 @@ extern "C" {
 
 size_t parseHexString(uint8_t *out, uint16_t outLen, const char *input);
 
+// Writes srcLen bytes as lowercase hex plus a NULL terminator, dstLen must be at least 2 * srcLen + 1
+// Returns the number of characters written (without terminator) or 0 when dst is too small
+size_t hex_encode(char *dst, size_t dstLen, const uint8_t *src, size_t srcLen);
+
+// Decodes srcLen hex characters (either case), anything other than an hex digit is rejected
+// Returns the number of bytes written or 0 on error
+size_t hex_decode(uint8_t *dst, size_t dstLen, const char *src, size_t srcLen);
+
 #ifdef __cplusplus
 }
 #endif
@@ -15,26 +15,67 @@
 ********************************************************************************/
 #pragma once
 
+#ifdef __cplusplus
+extern "C" {
+#endif
+
 #include <inttypes.h>
 #include <stdint.h>
 
+// Scratch arena. On device it sits right above the stack canary, so the stack grows down towards it.
+#ifndef ZB_ARENA_SIZE
+#if defined(TARGET_NANOS)
+#define ZB_ARENA_SIZE       2048
+#else
+#define ZB_ARENA_SIZE       4096
+#endif
+#endif
+
+// Live allocations, each one is followed by its own canary
+#define ZB_MAX_ALLOCATIONS  8
+
 typedef enum {
     zb_no_error,
     zb_misaligned_buffer,
-    zb_not_allocated
+    zb_not_allocated,
+    zb_no_memory,
+    zb_invalid_mark,
+    zb_canary_broken
 } zbuffer_error_e;
 
+// Arena position, allocations made after it are released together
+typedef struct {
+    uint16_t top;
+    uint8_t count;
+} zb_mark_t;
+
+// release every allocation and reset the high water mark
 zbuffer_error_e zb_init();
 
-// allocate a block at the end of the stack
-// maximum size will not be checked
+// allocate a single block at the start of the arena, releasing anything allocated before
 zbuffer_error_e zb_allocate(uint16_t size);
 
-// deallocate memory block as the end of the stack
+// deallocate the block of zb_allocate
 zbuffer_error_e zb_deallocate();
 
-// obtain a pointer to the allocated block
+// obtain a pointer to the block of zb_allocate
 zbuffer_error_e zb_get(uint8_t **buffer);
 
-// check that the block boundary has not been corrupted
+// check that no block boundary has been corrupted
 zbuffer_error_e zb_check_canary();
+
+// remember the current arena position
+zbuffer_error_e zb_mark(zb_mark_t *mark);
+
+// bump allocate size bytes (rounded up to 4), the block is zeroed
+zbuffer_error_e zb_alloc(uint16_t size, void **buffer);
+
+// check the canaries of the allocations made after mark, then flush and release them
+zbuffer_error_e zb_release(zb_mark_t mark);
+
+// highest number of arena bytes in use since zb_init, canaries included
+uint16_t zb_high_water_mark();
+
+#ifdef __cplusplus
+}
+#endif
@@ -20,27 +20,17 @@ extern "C" {
 #endif
 
 #include "zxmacros.h"
+#include "zxerror.h"
+#include "hexutils.h"
+
+// Writes the decimal representation of magnitude (preceded by '-' when negative) and a NULL terminator
+// Returns NULL on success or an error message when data is too small
+const char *decimal_to_str(char *data, int dataLen, uint64_t magnitude, uint8_t negative);
 
 #define NUM_TO_STR(TYPE) __Z_INLINE const char * TYPE##_to_str(char *data, int dataLen, TYPE##_t number) { \
-    if (dataLen < 2) return "Buffer too small";     \
-    MEMZERO(data, dataLen);                         \
-    char *p = data;                                 \
-    if (number < 0) { *(p++) = '-'; data++; }       \
-    else if (number == 0) { *(p++) = '0'; }         \
-    TYPE##_t tmp;                                   \
-    while (number != 0) {                           \
-        if (p - data >= (dataLen - 1)) {    return "Buffer too small";  }   \
-        tmp = number % 10;                          \
-        tmp = tmp < 0 ? -tmp : tmp;                 \
-        *(p++) = (char) ('0' + tmp);                \
-        number /= 10u;                              \
-    }                                               \
-    while (p > data) {                              \
-        p--;                                        \
-        char z = *data; *data = *p; *p = z;         \
-        data++;                                     \
-    }                                               \
-    return NULL;                                    \
+    const uint8_t negative = number < 0;            \
+    const uint64_t magnitude = negative ? (uint64_t) 0 - (uint64_t) number : (uint64_t) number; \
+    return decimal_to_str(data, dataLen, magnitude, negative); \
 }
 
 NUM_TO_STR(int64)
@@ -159,54 +149,14 @@ __Z_INLINE int64_t str_to_int64(const char *start, const char *end, char *error)
 
 uint8_t intstr_to_fpstr_inplace(char *number, size_t number_max_size, uint8_t decimalPlaces);
 
-__Z_INLINE uint8_t fpstr_to_str(char *out, uint16_t outLen, const char *number, uint8_t decimals) {
-    MEMZERO(out, outLen);
-    size_t digits = strlen(number);
-
-    if (decimals == 0) {
-        if (digits == 0) {
-            snprintf(out, outLen, "0");
-            return 0;
-        } else if (outLen < digits) {
-            snprintf(out, outLen, "ERR");
-            return 1;
-        }
-        strcpy(out, number);
-        return 0;
-    }
-
-    if ((outLen < decimals + 2) ||
-        (outLen < digits + 1)) {
-        snprintf(out, outLen, "ERR");
-        return 1;
-    }
-
-    if (digits <= decimals) {
-        // First part
-        strcpy(out, "0.");
-        out += 2;
-        MEMSET(out, '0', decimals - digits);
-        out += decimals - digits;
-    } else {
-        const size_t shift = digits - decimals;
-        strcpy(out, number);
-        number += shift;
-        out += shift;
-        *out++ = '.';
-    }
+// Inserts a decimal point in a string of digits, returns 0 on success, otherwise writes "ERR" and returns 1
+uint8_t fpstr_to_str(char *out, uint16_t outLen, const char *number, uint8_t decimals);
 
-    strcpy(out, number);
-    return 0;
-}
+// Formats value / 10^decimals, returns the length written ("ERR" when out is too small)
+uint16_t fpuint64_to_str(char *out, uint16_t outLen, const uint64_t value, uint8_t decimals);
 
-__Z_INLINE uint16_t fpuint64_to_str(char *out, uint16_t outLen, const uint64_t value, uint8_t decimals) {
-    char buffer[30];
-    MEMZERO(buffer, sizeof(buffer));
-    int64_to_str(buffer, sizeof(buffer), value);
-    fpstr_to_str(out, outLen, buffer, decimals);
-    uint16_t len = (uint16_t) strlen(out);
-    return len;
-}
+// Same as fpuint64_to_str followed by number_inplace_trimming, returns 0 when out is too small
+uint16_t fpuint64_to_str_trimmed(char *out, uint16_t outLen, const uint64_t value, uint8_t decimals);
 
 __Z_INLINE void number_inplace_trimming(char *s) {
     const size_t len = strlen(s);
@@ -239,19 +189,7 @@ __Z_INLINE uint64_t uint64_from_BEarray(const uint8_t data[8]) {
 }
 
 __Z_INLINE uint32_t array_to_hexstr(char *dst, uint16_t dstLen, const uint8_t *src, uint8_t count) {
-
-    if (dstLen < (count * 2 + 1)) {
-        return 0;
-    }
-
-    const char hexchars[] = "0123456789abcdef";
-    for (uint8_t i = 0; i < count; i++, src++) {
-        *dst++ = hexchars[*src >> 4u];
-        *dst++ = hexchars[*src & 0x0Fu];
-    }
-    *dst = 0; // terminate string
-
-    return (uint32_t) (count * 2);
+    return (uint32_t) hex_encode(dst, dstLen, src, count);
 }
 
 __Z_INLINE void pageStringExt(char *outValue, uint16_t outValueLen,
@@ -295,6 +233,13 @@ size_t asciify(char *utf8_in);
 
 size_t asciify_ext(const char *utf8_in, char *ascii_only_out);
 
+// One pass UTF-8 validation and ASCII folding of inLen bytes, codepoints outside [32, 127] are folded to '.'
+// ascii_out can be NULL to validate only, otherwise it needs room for the folded string and a NULL terminator
+// (inLen + 1 is always enough). foldedLen is the number of codepoints, equal to inLen only for pure ASCII input.
+zxerr_t utf8_validate_asciify(const char *utf8_in, size_t inLen,
+                              char *ascii_out, size_t asciiOutLen,
+                              size_t *foldedLen);
+
 #ifdef __cplusplus
 }
 #endif
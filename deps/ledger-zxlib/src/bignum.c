@@ -146,3 +146,103 @@ void bignumBigEndian_to_bcd(uint8_t *bcdOut, uint16_t bcdOutLen,
         }
     }
 }
+
+#define BIGNUM_LIMB_COUNT ((BIGNUM_TO_STR_MAX_BYTES + 3) / 4)
+#define BIGNUM_CHUNK_BASE 1000000000u
+#define BIGNUM_CHUNK_DIGITS 9u
+
+// limbs are little endian 32-bit words, limbCount excludes leading zero limbs
+static bool_t bignum_limbs_to_str(char *outBuffer, uint16_t outBufferLen, uint32_t *limbs, uint16_t limbCount) {
+    // Digits are produced 9 at a time from the least significant end and written backwards
+    // from the end of outBuffer, one byte is kept for the NULL terminator
+    char *p = outBuffer + outBufferLen - 1;
+
+    while (limbCount > 0) {
+        // limbs /= 10^9, remainder is the next chunk of 9 digits
+        uint64_t remainder = 0;
+        for (int16_t i = (int16_t) (limbCount - 1); i >= 0; i--) {
+            const uint64_t current = (remainder << 32u) | limbs[i];
+            limbs[i] = (uint32_t) (current / BIGNUM_CHUNK_BASE);
+            remainder = current % BIGNUM_CHUNK_BASE;
+        }
+        while (limbCount > 0 && limbs[limbCount - 1] == 0) {
+            limbCount--;
+        }
+
+        uint32_t chunk = (uint32_t) remainder;
+        // Only the most significant chunk drops its leading zeros
+        const uint8_t chunkDigits = limbCount > 0 ? BIGNUM_CHUNK_DIGITS : 0;
+        uint8_t written = 0;
+        do {
+            if (p == outBuffer) {
+                MEMZERO(outBuffer, outBufferLen);
+                strcpy(outBuffer, "ERR");
+                return bool_false;
+            }
+            *--p = (char) ('0' + chunk % 10u);
+            chunk /= 10u;
+            written++;
+        } while (chunk != 0 || written < chunkDigits);
+    }
+
+    const size_t len = (size_t) (outBuffer + outBufferLen - 1 - p);
+    if (len == 0) {
+        MEMZERO(outBuffer, outBufferLen);
+        outBuffer[0] = '0';
+        return bool_true;
+    }
+
+    memmove(outBuffer, p, len);
+    MEMZERO(outBuffer + len, outBufferLen - len);
+    return bool_true;
+}
+
+bool_t bignumLittleEndian_to_str(char *outBuffer, uint16_t outBufferLen,
+                                 const uint8_t *binValue, uint16_t binValueLen) {
+    MEMZERO(outBuffer, outBufferLen);
+    if (outBufferLen < 4) {
+        return bool_false;
+    }
+
+    while (binValueLen > 0 && binValue[binValueLen - 1] == 0) {
+        binValueLen--;
+    }
+    if (binValueLen > BIGNUM_TO_STR_MAX_BYTES) {
+        strcpy(outBuffer, "ERR");
+        return bool_false;
+    }
+
+    uint32_t limbs[BIGNUM_LIMB_COUNT];
+    MEMZERO(limbs, sizeof(limbs));
+    for (uint16_t i = 0; i < binValueLen; i++) {
+        limbs[i >> 2u] |= (uint32_t) binValue[i] << (8u * (i & 3u));
+    }
+
+    return bignum_limbs_to_str(outBuffer, outBufferLen, limbs, (uint16_t) ((binValueLen + 3) / 4));
+}
+
+bool_t bignumBigEndian_to_str(char *outBuffer, uint16_t outBufferLen,
+                              const uint8_t *binValue, uint16_t binValueLen) {
+    MEMZERO(outBuffer, outBufferLen);
+    if (outBufferLen < 4) {
+        return bool_false;
+    }
+
+    while (binValueLen > 0 && *binValue == 0) {
+        binValue++;
+        binValueLen--;
+    }
+    if (binValueLen > BIGNUM_TO_STR_MAX_BYTES) {
+        strcpy(outBuffer, "ERR");
+        return bool_false;
+    }
+
+    uint32_t limbs[BIGNUM_LIMB_COUNT];
+    MEMZERO(limbs, sizeof(limbs));
+    for (uint16_t i = 0; i < binValueLen; i++) {
+        const uint16_t bytePos = binValueLen - i - 1;
+        limbs[bytePos >> 2u] |= (uint32_t) binValue[i] << (8u * (bytePos & 3u));
+    }
+
+    return bignum_limbs_to_str(outBuffer, outBufferLen, limbs, (uint16_t) ((binValueLen + 3) / 4));
+}
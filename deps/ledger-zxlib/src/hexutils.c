@@ -13,24 +13,231 @@
 *  See the License for the specific language governing permissions and
 *  limitations under the License.
 ********************************************************************************/
-
-#include <ctype.h>
 #include <string.h>
 #include "hexutils.h"
 
-uint8_t hex2dec(char c, uint8_t *out) {
-    c = (char) tolower((int) c);
+#if !defined(TARGET_NANOS) && !defined(TARGET_NANOX) && !defined(TARGET_NANOS2)
+#if defined(__AVX2__)
+#include <immintrin.h>
+#define HEX_USE_AVX2
+#define HEX_USE_SSSE3
+#elif defined(__SSSE3__)
+#include <tmmintrin.h>
+#define HEX_USE_SSSE3
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+#include <arm_neon.h>
+#define HEX_USE_NEON
+#endif
+#endif
 
-    if (!isxdigit((int) c)) {
-        return 1;
+// Two lowercase characters per byte value
+static const char hex_pairs[513] =
+        "000102030405060708090a0b0c0d0e0f"
+        "101112131415161718191a1b1c1d1e1f"
+        "202122232425262728292a2b2c2d2e2f"
+        "303132333435363738393a3b3c3d3e3f"
+        "404142434445464748494a4b4c4d4e4f"
+        "505152535455565758595a5b5c5d5e5f"
+        "606162636465666768696a6b6c6d6e6f"
+        "707172737475767778797a7b7c7d7e7f"
+        "808182838485868788898a8b8c8d8e8f"
+        "909192939495969798999a9b9c9d9e9f"
+        "a0a1a2a3a4a5a6a7a8a9aaabacadaeaf"
+        "b0b1b2b3b4b5b6b7b8b9babbbcbdbebf"
+        "c0c1c2c3c4c5c6c7c8c9cacbcccdcecf"
+        "d0d1d2d3d4d5d6d7d8d9dadbdcdddedf"
+        "e0e1e2e3e4e5e6e7e8e9eaebecedeeef"
+        "f0f1f2f3f4f5f6f7f8f9fafbfcfdfeff";
+
+// Nibble value of every character, 0xFF for anything that is not an hex digit
+static const uint8_t hex_nibbles[256] = {
+        0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+        0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+        0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+        0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+        0xFF, 0x0A, 0x0B, 0x0C, 0x0D, 0x0E, 0x0F, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+        0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+        0xFF, 0x0A, 0x0B, 0x0C, 0x0D, 0x0E, 0x0F, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+        0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+        0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+        0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+        0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+        0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+        0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+        0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+        0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+        0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+};
+
+#if defined(HEX_USE_SSSE3)
+static const char hex_digits[16] = {'0', '1', '2', '3', '4', '5', '6', '7', '8', '9', 'a', 'b', 'c', 'd', 'e', 'f'};
+
+// Nibble values of 16 characters, sets *invalid when any of them is not an hex digit
+__attribute__((always_inline)) static inline __m128i hex_nibbles_sse(__m128i chars, int *invalid) {
+    const __m128i digits = _mm_sub_epi8(chars, _mm_set1_epi8('0'));
+    const __m128i isDigit = _mm_cmpeq_epi8(_mm_min_epu8(digits, _mm_set1_epi8(9)), digits);
+    const __m128i alpha = _mm_sub_epi8(_mm_or_si128(chars, _mm_set1_epi8(0x20)), _mm_set1_epi8('a'));
+    const __m128i isAlpha = _mm_cmpeq_epi8(_mm_min_epu8(alpha, _mm_set1_epi8(5)), alpha);
+
+    *invalid |= _mm_movemask_epi8(_mm_or_si128(isDigit, isAlpha)) ^ 0xFFFF;
+    return _mm_or_si128(_mm_and_si128(isDigit, digits),
+                        _mm_and_si128(isAlpha, _mm_add_epi8(alpha, _mm_set1_epi8(10))));
+}
+#endif
+
+#if defined(HEX_USE_AVX2)
+__attribute__((always_inline)) static inline __m256i hex_nibbles_avx2(__m256i chars, int *invalid) {
+    const __m256i digits = _mm256_sub_epi8(chars, _mm256_set1_epi8('0'));
+    const __m256i isDigit = _mm256_cmpeq_epi8(_mm256_min_epu8(digits, _mm256_set1_epi8(9)), digits);
+    const __m256i alpha = _mm256_sub_epi8(_mm256_or_si256(chars, _mm256_set1_epi8(0x20)), _mm256_set1_epi8('a'));
+    const __m256i isAlpha = _mm256_cmpeq_epi8(_mm256_min_epu8(alpha, _mm256_set1_epi8(5)), alpha);
+
+    *invalid |= ~_mm256_movemask_epi8(_mm256_or_si256(isDigit, isAlpha));
+    return _mm256_or_si256(_mm256_and_si256(isDigit, digits),
+                           _mm256_and_si256(isAlpha, _mm256_add_epi8(alpha, _mm256_set1_epi8(10))));
+}
+#endif
+
+#if defined(HEX_USE_NEON)
+__attribute__((always_inline)) static inline uint8x16_t hex_nibbles_neon(uint8x16_t chars, uint8x16_t *invalid) {
+    const uint8x16_t digits = vsubq_u8(chars, vdupq_n_u8('0'));
+    const uint8x16_t isDigit = vcleq_u8(digits, vdupq_n_u8(9));
+    const uint8x16_t alpha = vsubq_u8(vorrq_u8(chars, vdupq_n_u8(0x20)), vdupq_n_u8('a'));
+    const uint8x16_t isAlpha = vcleq_u8(alpha, vdupq_n_u8(5));
+
+    *invalid = vorrq_u8(*invalid, vmvnq_u8(vorrq_u8(isDigit, isAlpha)));
+    return vorrq_u8(vandq_u8(isDigit, digits), vandq_u8(isAlpha, vaddq_u8(alpha, vdupq_n_u8(10))));
+}
+#endif
+
+size_t hex_encode(char *dst, size_t dstLen, const uint8_t *src, size_t srcLen) {
+    if (dst == NULL || dstLen < srcLen * 2 + 1) {
+        return 0;
+    }
+
+    size_t i = 0;
+#if defined(HEX_USE_AVX2)
+    {
+        const __m256i lut = _mm256_broadcastsi128_si256(_mm_loadu_si128((const __m128i *) hex_digits));
+        const __m256i mask = _mm256_set1_epi8(0x0F);
+        for (; i + 32 <= srcLen; i += 32) {
+            const __m256i in = _mm256_loadu_si256((const __m256i *) (src + i));
+            const __m256i hi = _mm256_shuffle_epi8(lut, _mm256_and_si256(_mm256_srli_epi16(in, 4), mask));
+            const __m256i lo = _mm256_shuffle_epi8(lut, _mm256_and_si256(in, mask));
+            const __m256i first = _mm256_unpacklo_epi8(hi, lo);
+            const __m256i second = _mm256_unpackhi_epi8(hi, lo);
+            _mm256_storeu_si256((__m256i *) (dst + 2 * i), _mm256_permute2x128_si256(first, second, 0x20));
+            _mm256_storeu_si256((__m256i *) (dst + 2 * i + 32), _mm256_permute2x128_si256(first, second, 0x31));
+        }
+    }
+#endif
+#if defined(HEX_USE_SSSE3)
+    {
+        const __m128i lut = _mm_loadu_si128((const __m128i *) hex_digits);
+        const __m128i mask = _mm_set1_epi8(0x0F);
+        for (; i + 16 <= srcLen; i += 16) {
+            const __m128i in = _mm_loadu_si128((const __m128i *) (src + i));
+            const __m128i hi = _mm_shuffle_epi8(lut, _mm_and_si128(_mm_srli_epi16(in, 4), mask));
+            const __m128i lo = _mm_shuffle_epi8(lut, _mm_and_si128(in, mask));
+            _mm_storeu_si128((__m128i *) (dst + 2 * i), _mm_unpacklo_epi8(hi, lo));
+            _mm_storeu_si128((__m128i *) (dst + 2 * i + 16), _mm_unpackhi_epi8(hi, lo));
+        }
+    }
+#endif
+#if defined(HEX_USE_NEON)
+    {
+        const uint8x16_t lut = vld1q_u8((const uint8_t *) "0123456789abcdef");
+        for (; i + 16 <= srcLen; i += 16) {
+            const uint8x16_t in = vld1q_u8(src + i);
+            uint8x16x2_t out;
+            out.val[0] = vqtbl1q_u8(lut, vshrq_n_u8(in, 4));
+            out.val[1] = vqtbl1q_u8(lut, vandq_u8(in, vdupq_n_u8(0x0F)));
+            vst2q_u8((uint8_t *) dst + 2 * i, out);
+        }
+    }
+#endif
+
+    for (; i < srcLen; i++) {
+        const char *pair = hex_pairs + 2 * src[i];
+        dst[2 * i] = pair[0];
+        dst[2 * i + 1] = pair[1];
     }
 
-    if (isdigit((int) c)) {
-        *out = (char) (c - '0');
+    dst[2 * srcLen] = 0;
+    return 2 * srcLen;
+}
+
+size_t hex_decode(uint8_t *dst, size_t dstLen, const char *src, size_t srcLen) {
+    if (dst == NULL || src == NULL || srcLen % 2 != 0 || srcLen / 2 > dstLen) {
         return 0;
     }
 
-    *out = (char) (c - 'a' + 10);
+    const uint8_t *in = (const uint8_t *) src;
+    size_t i = 0;
+#if defined(HEX_USE_AVX2)
+    {
+        int invalid = 0;
+        for (; i + 64 <= srcLen; i += 64) {
+            const __m256i a = hex_nibbles_avx2(_mm256_loadu_si256((const __m256i *) (in + i)), &invalid);
+            const __m256i b = hex_nibbles_avx2(_mm256_loadu_si256((const __m256i *) (in + i + 32)), &invalid);
+            const __m256i weights = _mm256_set1_epi16(0x0110);
+            const __m256i packed = _mm256_packus_epi16(_mm256_maddubs_epi16(a, weights),
+                                                       _mm256_maddubs_epi16(b, weights));
+            _mm256_storeu_si256((__m256i *) (dst + i / 2), _mm256_permute4x64_epi64(packed, 0xD8));
+        }
+        if (invalid) {
+            return 0;
+        }
+    }
+#endif
+#if defined(HEX_USE_SSSE3)
+    {
+        int invalid = 0;
+        for (; i + 32 <= srcLen; i += 32) {
+            const __m128i a = hex_nibbles_sse(_mm_loadu_si128((const __m128i *) (in + i)), &invalid);
+            const __m128i b = hex_nibbles_sse(_mm_loadu_si128((const __m128i *) (in + i + 16)), &invalid);
+            const __m128i weights = _mm_set1_epi16(0x0110);
+            _mm_storeu_si128((__m128i *) (dst + i / 2),
+                             _mm_packus_epi16(_mm_maddubs_epi16(a, weights), _mm_maddubs_epi16(b, weights)));
+        }
+        if (invalid) {
+            return 0;
+        }
+    }
+#endif
+#if defined(HEX_USE_NEON)
+    {
+        uint8x16_t invalid = vdupq_n_u8(0);
+        for (; i + 32 <= srcLen; i += 32) {
+            const uint8x16x2_t chars = vld2q_u8(in + i);
+            const uint8x16_t hi = hex_nibbles_neon(chars.val[0], &invalid);
+            const uint8x16_t lo = hex_nibbles_neon(chars.val[1], &invalid);
+            vst1q_u8(dst + i / 2, vorrq_u8(vshlq_n_u8(hi, 4), lo));
+        }
+        if (vmaxvq_u8(invalid) != 0) {
+            return 0;
+        }
+    }
+#endif
+
+    for (; i < srcLen; i += 2) {
+        const uint8_t hi = hex_nibbles[in[i]];
+        const uint8_t lo = hex_nibbles[in[i + 1]];
+        if ((hi | lo) & 0xF0u) {
+            return 0;
+        }
+        dst[i / 2] = (uint8_t) ((hi << 4u) | lo);
+    }
+
+    return srcLen / 2;
+}
+
+uint8_t hex2dec(char c, uint8_t *out) {
+    const uint8_t v = hex_nibbles[(uint8_t) c];
+    if (v == 0xFF) {
+        return 1;
+    }
+    *out = v;
     return 0;
 }
 
@@ -43,15 +250,5 @@ size_t parseHexString(uint8_t *out, uint16_t outLen, const char *input) {
         return 0;
     }
 
-    for (size_t i = 0; i < len; i += 2) {
-        uint8_t tmp1, tmp2;
-        if (hex2dec(input[i], &tmp1))
-            return 0;
-        if (hex2dec(input[i + 1], &tmp2))
-            return 0;
-
-        out[i >> 1u] = (tmp1 << 4u) + tmp2;
-    }
-
-    return (len / 2);
+    return hex_decode(out, outLen, input, len);
 }
@@ -17,72 +17,122 @@
 #include "zbuffer.h"
 #include "zxmacros.h"
 
+#define CANARY_EXPECTED 0x987def82u
+#define CANARY_SIZE     sizeof(uint32_t)
+
 typedef struct {
-    uint8_t *ptr;
-    uint16_t size;
+    uint16_t top;
+    uint16_t highWaterMark;
+    uint8_t count;
+    // Offset of the canary after each live allocation
+    uint16_t canary[ZB_MAX_ALLOCATIONS];
 } zbuffer_t;
 
 zbuffer_t zbuffer_internal;
 
-#define CANARY_EXPECTED 0x987def82u
+#if defined (TARGET_NANOS) || defined(TARGET_NANOX) || defined(TARGET_NANOS2)
+#define ZB_BASE ((uint8_t *) (&app_stack_canary + 4))
+#else
+uint32_t zbuffer_arena[ZB_ARENA_SIZE / sizeof(uint32_t)];
+#define ZB_BASE ((uint8_t *) zbuffer_arena)
+#endif
 
-zbuffer_error_e zb_get(uint8_t **buffer) {
+static zbuffer_error_e zb_canary_failed() {
 #if defined (TARGET_NANOS) || defined(TARGET_NANOX) || defined(TARGET_NANOS2)
-    *buffer = NULL;
-    if (zbuffer_internal.size == 0 || zbuffer_internal.ptr == NULL) {
-        return zb_not_allocated;
-    }
-    *buffer = zbuffer_internal.ptr;
+    handle_stack_overflow();
 #endif
+    return zb_canary_broken;
+}
+
+static zbuffer_error_e zb_check_from(uint8_t first) {
+    for (uint8_t i = first; i < zbuffer_internal.count; i++) {
+        const uint32_t *zb_canary = (const uint32_t *) (ZB_BASE + zbuffer_internal.canary[i]);
+        if (*zb_canary != CANARY_EXPECTED) {
+            return zb_canary_failed();
+        }
+    }
     return zb_no_error;
 }
 
 zbuffer_error_e zb_init() {
-#if defined (TARGET_NANOS) || defined(TARGET_NANOX) || defined(TARGET_NANOS2)
-    zbuffer_internal.size = 0;
-    zbuffer_internal.ptr = NULL;
-#endif
+    MEMZERO(&zbuffer_internal, sizeof(zbuffer_internal));
     return zb_no_error;
 }
 
-zbuffer_error_e zb_allocate(uint16_t size) {
-#if defined (TARGET_NANOS) || defined(TARGET_NANOX) || defined(TARGET_NANOS2)
-    if (size % 4 != 0) {
-        size += size % 4;
+zbuffer_error_e zb_mark(zb_mark_t *mark) {
+    mark->top = zbuffer_internal.top;
+    mark->count = zbuffer_internal.count;
+    return zb_no_error;
+}
+
+zbuffer_error_e zb_alloc(uint16_t size, void **buffer) {
+    *buffer = NULL;
+    const uint32_t blockSize = ((uint32_t) size + 3u) & ~3u;
+    if (zbuffer_internal.count >= ZB_MAX_ALLOCATIONS ||
+        zbuffer_internal.top + blockSize + CANARY_SIZE > ZB_ARENA_SIZE) {
+        return zb_no_memory;
     }
-    zbuffer_internal.size = size;
-    zbuffer_internal.ptr = (uint8_t * )(&app_stack_canary + 4);
 
-    uint32_t *zb_canary = (uint32_t * )(zbuffer_internal.ptr + zbuffer_internal.size + 4);
-    *zb_canary = CANARY_EXPECTED;
-#endif
+    uint8_t *ptr = ZB_BASE + zbuffer_internal.top;
+    const uint16_t canary = (uint16_t) (zbuffer_internal.top + blockSize);
+    *(uint32_t *) (ZB_BASE + canary) = CANARY_EXPECTED;
+
+    zbuffer_internal.canary[zbuffer_internal.count++] = canary;
+    zbuffer_internal.top = (uint16_t) (canary + CANARY_SIZE);
+    if (zbuffer_internal.top > zbuffer_internal.highWaterMark) {
+        zbuffer_internal.highWaterMark = zbuffer_internal.top;
+    }
+
+    MEMZERO(ptr, blockSize);
+    *buffer = ptr;
     return zb_no_error;
 }
 
-zbuffer_error_e zb_deallocate() {
-#if defined (TARGET_NANOS) || defined(TARGET_NANOX) || defined(TARGET_NANOS2)
-    if (zbuffer_internal.size == 0) {
-        return zb_not_allocated;
+zbuffer_error_e zb_release(zb_mark_t mark) {
+    if (mark.count > zbuffer_internal.count || mark.top > zbuffer_internal.top) {
+        return zb_invalid_mark;
     }
 
+    const zbuffer_error_e err = zb_check_from(mark.count);
+
     // Flush any information
-    MEMZERO(zbuffer_internal.ptr, zbuffer_internal.size);
+    MEMZERO(ZB_BASE + mark.top, zbuffer_internal.top - mark.top);
+    zbuffer_internal.top = mark.top;
+    zbuffer_internal.count = mark.count;
+    return err;
+}
 
-    zb_init();
-#endif
+uint16_t zb_high_water_mark() {
+    return zbuffer_internal.highWaterMark;
+}
+
+zbuffer_error_e zb_allocate(uint16_t size) {
+    const zb_mark_t start = {0, 0};
+    zb_release(start);
+
+    void *ptr = NULL;
+    return zb_alloc(size, &ptr);
+}
+
+zbuffer_error_e zb_get(uint8_t **buffer) {
+    *buffer = NULL;
+    if (zbuffer_internal.count == 0) {
+        return zb_not_allocated;
+    }
+    *buffer = ZB_BASE;
     return zb_no_error;
 }
 
+zbuffer_error_e zb_deallocate() {
+    if (zbuffer_internal.count == 0) {
+        return zb_not_allocated;
+    }
+
+    const zb_mark_t start = {0, 0};
+    return zb_release(start);
+}
+
 zbuffer_error_e zb_check_canary() {
-#if defined (TARGET_NANOS) || defined(TARGET_NANOX) || defined(TARGET_NANOS2)
     CHECK_APP_CANARY();
-    if (zbuffer_internal.size != 0) {
-        // allocated
-        uint32_t *zb_canary = (uint32_t * )(zbuffer_internal.ptr + zbuffer_internal.size + 4);
-        if (*zb_canary != CANARY_EXPECTED) {
-            handle_stack_overflow();
-        }
-    }
-#endif
-    return zb_no_error;
+    return zb_check_from(0);
 }
@@ -15,6 +15,161 @@
 ********************************************************************************/
 #include "zxformat.h"
 
+static const char digit_pairs[201] =
+        "00010203040506070809"
+        "10111213141516171819"
+        "20212223242526272829"
+        "30313233343536373839"
+        "40414243444546474849"
+        "50515253545556575859"
+        "60616263646566676869"
+        "70717273747576777879"
+        "80818283848586878889"
+        "90919293949596979899";
+
+static const uint64_t powers_of_ten[20] = {
+        1ull, 10ull, 100ull, 1000ull, 10000ull, 100000ull, 1000000ull, 10000000ull, 100000000ull,
+        1000000000ull, 10000000000ull, 100000000000ull, 1000000000000ull, 10000000000000ull,
+        100000000000000ull, 1000000000000000ull, 10000000000000000ull, 100000000000000000ull,
+        1000000000000000000ull, 10000000000000000000ull,
+};
+
+__Z_INLINE uint8_t count_digits(uint64_t value) {
+    uint8_t digits = 1;
+    while (digits < 20 && value >= powers_of_ten[digits]) {
+        digits++;
+    }
+    return digits;
+}
+
+// Writes exactly `digits` digits of value ending right before end, two at a time
+__Z_INLINE void write_digits_backwards(char *end, uint64_t value, uint8_t digits) {
+    while (digits >= 2) {
+        const char *pair = digit_pairs + 2 * (value % 100);
+        value /= 100;
+        *--end = pair[1];
+        *--end = pair[0];
+        digits -= 2;
+    }
+    if (digits == 1) {
+        *--end = (char) ('0' + value % 10);
+    }
+}
+
+const char *decimal_to_str(char *data, int dataLen, uint64_t magnitude, uint8_t negative) {
+    if (dataLen < 2) {
+        return "Buffer too small";
+    }
+
+    const uint8_t digits = count_digits(magnitude);
+    const int len = digits + (negative ? 1 : 0);
+    if (len + 1 > dataLen) {
+        MEMZERO(data, dataLen);
+        return "Buffer too small";
+    }
+
+    if (negative) {
+        data[0] = '-';
+    }
+    write_digits_backwards(data + len, magnitude, digits);
+    MEMZERO(data + len, dataLen - len);
+    return NULL;
+}
+
+uint8_t fpstr_to_str(char *out, uint16_t outLen, const char *number, uint8_t decimals) {
+    const size_t digits = strlen(number);
+
+    if (decimals == 0) {
+        if (digits == 0) {
+            MEMZERO(out, outLen);
+            snprintf(out, outLen, "0");
+            return 0;
+        }
+        if (outLen < digits + 1) {
+            MEMZERO(out, outLen);
+            snprintf(out, outLen, "ERR");
+            return 1;
+        }
+        MEMCPY(out, number, digits);
+        MEMZERO(out + digits, outLen - digits);
+        return 0;
+    }
+
+    // "0." and leading zeros when there is no integer part
+    const size_t len = digits <= decimals ? (size_t) decimals + 2 : digits + 1;
+    if (outLen < len + 1) {
+        MEMZERO(out, outLen);
+        snprintf(out, outLen, "ERR");
+        return 1;
+    }
+
+    if (digits <= decimals) {
+        const size_t zeros = decimals - digits;
+        out[0] = '0';
+        out[1] = '.';
+        MEMSET(out + 2, '0', zeros);
+        MEMCPY(out + 2 + zeros, number, digits);
+    } else {
+        const size_t integerDigits = digits - decimals;
+        MEMCPY(out, number, integerDigits);
+        out[integerDigits] = '.';
+        MEMCPY(out + integerDigits + 1, number + integerDigits, decimals);
+    }
+    MEMZERO(out + len, outLen - len);
+    return 0;
+}
+
+static uint16_t fpuint64_format(char *out, uint16_t outLen, const uint64_t value, uint8_t decimals, uint8_t trim) {
+    uint64_t integerPart = 0;
+    uint64_t fraction = value;
+    if (decimals < 20) {
+        integerPart = value / powers_of_ten[decimals];
+        fraction = value % powers_of_ten[decimals];
+    }
+
+    const uint8_t integerDigits = count_digits(integerPart);
+    uint16_t fractionDigits = decimals;
+    const uint16_t pointLen = decimals > 0 ? 1 : 0;
+    if (outLen < integerDigits + pointLen + fractionDigits + 1) {
+        MEMZERO(out, outLen);
+        snprintf(out, outLen, "ERR");
+        return 0;
+    }
+
+    write_digits_backwards(out + integerDigits, integerPart, integerDigits);
+    if (decimals > 0) {
+        out[integerDigits] = '.';
+        char *fractionStart = out + integerDigits + 1;
+        // fraction digits above the 20 a uint64 can hold are leading zeros
+        uint16_t padding = 0;
+        if (decimals > 20) {
+            padding = decimals - 20;
+            MEMSET(fractionStart, '0', padding);
+        }
+        write_digits_backwards(fractionStart + fractionDigits, fraction, (uint8_t) (fractionDigits - padding));
+
+        if (trim) {
+            // keep at least one decimal, as number_inplace_trimming
+            while (fractionDigits > 1 && fractionStart[fractionDigits - 1] == '0') {
+                fractionDigits--;
+            }
+        }
+    }
+
+    const uint16_t len = integerDigits + pointLen + fractionDigits;
+    MEMZERO(out + len, outLen - len);
+    return len;
+}
+
+uint16_t fpuint64_to_str(char *out, uint16_t outLen, const uint64_t value, uint8_t decimals) {
+    const uint16_t len = fpuint64_format(out, outLen, value, decimals, 0);
+    return len > 0 ? len : (uint16_t) strlen(out);
+}
+
+uint16_t fpuint64_to_str_trimmed(char *out, uint16_t outLen, const uint64_t value, uint8_t decimals) {
+    return fpuint64_format(out, outLen, value, decimals, 1);
+}
+
 uint8_t intstr_to_fpstr_inplace(char *number, size_t number_max_size, uint8_t decimalPlaces) {
     uint16_t numChars = strnlen(number, number_max_size);
     MEMZERO(number + numChars, number_max_size - numChars);
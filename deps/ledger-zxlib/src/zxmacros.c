@@ -37,6 +37,132 @@ size_t asciify_ext(const char *utf8_in, char *ascii_only_out) {
     return q - ascii_only_out;
 }
 
+#if !defined(TARGET_NANOS) && !defined(TARGET_NANOX) && !defined(TARGET_NANOS2)
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+#include <arm_neon.h>
+#endif
+#endif
+
+// UTF-8 DFA by Bjoern Hoehrmann, see http://bjoern.hoehrmann.de/utf-8/decoder/dfa/
+// Bytes are first mapped to a character class, the class then drives the state transition.
+// State 0 accepts, state 12 rejects (overlong forms, surrogates, codepoints above U+10FFFF and stray bytes)
+#define UTF8_ACCEPT 0
+#define UTF8_REJECT 12
+
+static const uint8_t utf8_byte_class[256] = {
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 9, 9, 9, 9, 9, 9, 9, 9, 9, 9, 9, 9, 9, 9, 9, 9,
+        7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7,
+        8, 8, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2,
+        10, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 4, 3, 3, 11, 6, 6, 6, 5, 8, 8, 8, 8, 8, 8, 8, 8, 8, 8, 8,
+};
+
+static const uint8_t utf8_transition[108] = {
+        0, 12, 24, 36, 60, 96, 84, 12, 12, 12, 48, 72,
+        12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12,
+        12, 0, 12, 12, 12, 12, 12, 0, 12, 0, 12, 12,
+        12, 24, 12, 12, 12, 12, 12, 24, 12, 24, 12, 12,
+        12, 12, 12, 12, 12, 12, 12, 24, 12, 12, 12, 12,
+        12, 24, 12, 12, 12, 12, 12, 12, 12, 24, 12, 12,
+        12, 12, 12, 12, 12, 12, 12, 36, 12, 36, 12, 12,
+        12, 36, 12, 12, 12, 12, 12, 36, 12, 36, 12, 12,
+        12, 36, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12,
+};
+
+// Returns the length of the pure ASCII prefix of in. Only host builds take the vector path
+__Z_INLINE size_t ascii_prefix_len(const uint8_t *in, size_t inLen) {
+    size_t i = 0;
+#if !defined(TARGET_NANOS) && !defined(TARGET_NANOX) && !defined(TARGET_NANOS2)
+#if defined(__SSE2__)
+    for (; i + 16 <= inLen; i += 16) {
+        const __m128i chunk = _mm_loadu_si128((const __m128i *) (in + i));
+        if (_mm_movemask_epi8(chunk) != 0) {
+            break;
+        }
+    }
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+    for (; i + 16 <= inLen; i += 16) {
+        if (vmaxvq_u8(vld1q_u8(in + i)) >= 0x80) {
+            break;
+        }
+    }
+#endif
+#endif
+    while (i < inLen && in[i] < 0x80) {
+        i++;
+    }
+    return i;
+}
+
+zxerr_t utf8_validate_asciify(const char *utf8_in, size_t inLen,
+                              char *ascii_out, size_t asciiOutLen,
+                              size_t *foldedLen) {
+    const uint8_t *in = (const uint8_t *) utf8_in;
+    uint32_t state = UTF8_ACCEPT;
+    size_t folded = 0;
+    size_t i = 0;
+
+    *foldedLen = 0;
+    if (ascii_out != NULL && asciiOutLen == 0) {
+        return zxerr_buffer_too_small;
+    }
+
+    while (i < inLen) {
+        if (state == UTF8_ACCEPT) {
+            // Copy ASCII runs in bulk
+            const size_t run = ascii_prefix_len(in + i, inLen - i);
+            if (run > 0) {
+                if (ascii_out != NULL) {
+                    if (folded + run >= asciiOutLen) {
+                        return zxerr_buffer_too_small;
+                    }
+                    for (size_t j = 0; j < run; j++) {
+                        const uint8_t c = in[i + j];
+                        ascii_out[folded + j] = (char) (c >= 32 ? c : '.');
+                    }
+                }
+                folded += run;
+                i += run;
+                continue;
+            }
+        }
+
+        // Only validity matters, the codepoint value itself is always folded
+        state = utf8_transition[state + utf8_byte_class[in[i++]]];
+
+        if (state == UTF8_REJECT) {
+            return zxerr_encoding_failed;
+        }
+
+        if (state == UTF8_ACCEPT) {
+            if (ascii_out != NULL) {
+                if (folded + 1 >= asciiOutLen) {
+                    return zxerr_buffer_too_small;
+                }
+                // every multibyte codepoint is above 0x7F
+                ascii_out[folded] = '.';
+            }
+            folded++;
+        }
+    }
+
+    if (state != UTF8_ACCEPT) {
+        // truncated sequence
+        return zxerr_encoding_failed;
+    }
+
+    if (ascii_out != NULL) {
+        ascii_out[folded] = 0;
+    }
+    *foldedLen = folded;
+    return zxerr_ok;
+}
+
 void handle_stack_overflow() {
     zemu_log("!!!!!!!!!!!!!!!!!!!!!! CANARY TRIGGERED!!! STACK OVERFLOW DETECTED\n");
 #if defined (TARGET_NANOS) || defined(TARGET_NANOX) || defined(TARGET_NANOS2)
@@ -0,0 +1,268 @@
+/*******************************************************************************
+*   (c) 2021 Zondax GmbH
+*
+*  Licensed under the Apache License, Version 2.0 (the "License");
+*  you may not use this file except in compliance with the License.
+*  You may obtain a copy of the License at
+*
+*      http://www.apache.org/licenses/LICENSE-2.0
+*
+*  Unless required by applicable law or agreed to in writing, software
+*  distributed under the License is distributed on an "AS IS" BASIS,
+*  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+*  See the License for the specific language governing permissions and
+*  limitations under the License.
+********************************************************************************/
+#include <gmock/gmock.h>
+#include <zxmacros.h>
+#include <zxformat.h>
+
+#include <limits>
+#include <random>
+#include <string>
+#include <vector>
+
+// Differential tests of the digit pair formatters against the digit at a time code they replaced.
+// The reference code runs on a large backing buffer so that its one byte overflows can be detected
+// instead of corrupting the stack: when its output does not fit in outLen the new code must fail.
+
+namespace {
+    const size_t BACKING_SIZE = 128;
+
+    template<typename T>
+    const char *reference_to_str(char *data, int dataLen, T number) {
+        if (dataLen < 2) return "Buffer too small";
+        MEMZERO(data, dataLen);
+        char *p = data;
+        if (number < 0) { *(p++) = '-'; data++; }
+        else if (number == 0) { *(p++) = '0'; }
+        T tmp;
+        while (number != 0) {
+            if (p - data >= (dataLen - 1)) { return "Buffer too small"; }
+            tmp = number % 10;
+            tmp = tmp < 0 ? -tmp : tmp;
+            *(p++) = (char) ('0' + tmp);
+            number /= 10u;
+        }
+        while (p > data) {
+            p--;
+            char z = *data; *data = *p; *p = z;
+            data++;
+        }
+        return nullptr;
+    }
+
+    uint8_t reference_fpstr_to_str(char *out, uint16_t outLen, const char *number, uint8_t decimals) {
+        MEMZERO(out, outLen);
+        size_t digits = strlen(number);
+
+        if (decimals == 0) {
+            if (digits == 0) {
+                snprintf(out, outLen, "0");
+                return 0;
+            } else if (outLen < digits) {
+                snprintf(out, outLen, "ERR");
+                return 1;
+            }
+            strcpy(out, number);
+            return 0;
+        }
+
+        if ((outLen < decimals + 2) || (outLen < digits + 1)) {
+            snprintf(out, outLen, "ERR");
+            return 1;
+        }
+
+        if (digits <= decimals) {
+            strcpy(out, "0.");
+            out += 2;
+            MEMSET(out, '0', decimals - digits);
+            out += decimals - digits;
+        } else {
+            const size_t shift = digits - decimals;
+            strcpy(out, number);
+            number += shift;
+            out += shift;
+            *out++ = '.';
+        }
+
+        strcpy(out, number);
+        return 0;
+    }
+
+    std::string reference_fpuint64(uint64_t value, uint8_t decimals) {
+        char number[30] = {0};
+        char out[BACKING_SIZE] = {0};
+        reference_to_str<int64_t>(number, sizeof(number), (int64_t) value);
+        reference_fpstr_to_str(out, sizeof(out), number, decimals);
+        return std::string(out);
+    }
+
+    std::vector<uint64_t> sampleValues() {
+        std::vector<uint64_t> values;
+        uint64_t p = 1;
+        for (int i = 0; i < 20; i++) {
+            values.push_back(p);
+            values.push_back(p - 1);
+            values.push_back(p + 1);
+            values.push_back(p * 5);
+            p *= 10;
+        }
+        values.push_back(0);
+        values.push_back(std::numeric_limits<int64_t>::max());
+        values.push_back((uint64_t) std::numeric_limits<int64_t>::max() + 1);
+        values.push_back(std::numeric_limits<uint64_t>::max());
+
+        std::mt19937_64 rng(0x5eed);
+        for (int i = 0; i < 5000; i++) {
+            // spread the random values across every length
+            const uint64_t v = rng();
+            values.push_back(v >> (rng() % 64));
+        }
+        return values;
+    }
+
+    template<typename T>
+    void checkIntegerFormat(T number, const char *(*format)(char *, int, T)) {
+        for (int dataLen = 0; dataLen <= 24; dataLen++) {
+            char expected[BACKING_SIZE] = {0};
+            char have[BACKING_SIZE];
+            MEMSET(have, 'x', sizeof(have));
+
+            const char *refErr = reference_to_str<T>(expected, dataLen, number);
+            const char *err = format(have, dataLen, number);
+
+            if (refErr == nullptr && strlen(expected) + 1 <= (size_t) dataLen) {
+                ASSERT_EQ(err, nullptr) << number << " dataLen " << dataLen;
+                ASSERT_STREQ(have, expected) << number << " dataLen " << dataLen;
+            } else {
+                ASSERT_NE(err, nullptr) << number << " dataLen " << dataLen;
+            }
+            // Nothing is written past dataLen
+            ASSERT_EQ(have[dataLen], 'x');
+        }
+    }
+
+    // The formatters are always inline, they are passed wrapped in captureless lambdas
+    const auto format_uint64 = [](char *data, int dataLen, uint64_t number) {
+        return uint64_to_str(data, dataLen, number);
+    };
+
+    const auto format_int64 = [](char *data, int dataLen, int64_t number) {
+        return int64_to_str(data, dataLen, number);
+    };
+
+    TEST(DECIMAL_FORMAT, uint64_to_str) {
+        for (const auto v : sampleValues()) {
+            checkIntegerFormat<uint64_t>(v, format_uint64);
+        }
+    }
+
+    TEST(DECIMAL_FORMAT, int64_to_str) {
+        std::vector<int64_t> values;
+        for (const auto v : sampleValues()) {
+            values.push_back((int64_t) v);
+            values.push_back(-(int64_t) (v >> 1u));
+        }
+        values.push_back(std::numeric_limits<int64_t>::min());
+        values.push_back(std::numeric_limits<int64_t>::min() + 1);
+        for (const auto v : values) {
+            checkIntegerFormat<int64_t>(v, format_int64);
+        }
+    }
+
+    TEST(DECIMAL_FORMAT, small_values) {
+        for (int64_t v = -20000; v <= 20000; v++) {
+            checkIntegerFormat<int64_t>(v, format_int64);
+        }
+    }
+
+    TEST(DECIMAL_FORMAT, fpstr_to_str) {
+        const auto values = sampleValues();
+        for (size_t i = 0; i < values.size(); i += 16) {
+            std::string number = std::to_string(values[i]);
+            if (values[i] == 0) {
+                number = "";
+            }
+            for (uint8_t decimals = 0; decimals <= 22; decimals++) {
+                for (uint16_t outLen = 1; outLen <= 32; outLen++) {
+                    char expected[BACKING_SIZE] = {0};
+                    char have[BACKING_SIZE];
+                    MEMSET(have, 'x', sizeof(have));
+
+                    const uint8_t refErr = reference_fpstr_to_str(expected, outLen, number.c_str(), decimals);
+                    const uint8_t err = fpstr_to_str(have, outLen, number.c_str(), decimals);
+
+                    if (refErr == 0 && strlen(expected) + 1 <= outLen) {
+                        ASSERT_EQ(err, 0) << number << " " << (int) decimals << " " << outLen;
+                    } else {
+                        ASSERT_EQ(err, 1) << number << " " << (int) decimals << " " << outLen;
+                        snprintf(expected, outLen, "ERR");
+                    }
+                    ASSERT_STREQ(have, expected) << number << " " << (int) decimals << " " << outLen;
+                    ASSERT_EQ(have[outLen], 'x');
+                }
+            }
+        }
+    }
+
+    TEST(DECIMAL_FORMAT, fpuint64_to_str) {
+        for (const auto v : sampleValues()) {
+            for (uint8_t decimals = 0; decimals <= 24; decimals++) {
+                std::string expected;
+                if (v <= (uint64_t) std::numeric_limits<int64_t>::max()) {
+                    expected = reference_fpuint64(v, decimals);
+                } else {
+                    // The reference went through int64, the new code formats the unsigned value
+                    std::string digits = std::to_string(v);
+                    if (decimals > 0) {
+                        if (digits.size() <= decimals) {
+                            digits = "0." + std::string(decimals - digits.size(), '0') + digits;
+                        } else {
+                            digits.insert(digits.size() - decimals, ".");
+                        }
+                    }
+                    expected = digits;
+                }
+
+                char have[BACKING_SIZE];
+                MEMSET(have, 'x', sizeof(have));
+                ASSERT_EQ(fpuint64_to_str(have, 64, v, decimals), expected.size()) << v << " " << (int) decimals;
+                ASSERT_EQ(std::string(have), expected) << v << " " << (int) decimals;
+
+                std::string trimmed = expected;
+                char buffer[BACKING_SIZE] = {0};
+                MEMCPY(buffer, trimmed.c_str(), trimmed.size());
+                number_inplace_trimming(buffer);
+                trimmed = buffer;
+
+                MEMSET(have, 'x', sizeof(have));
+                ASSERT_EQ(fpuint64_to_str_trimmed(have, 64, v, decimals), trimmed.size()) << v << " " << (int) decimals;
+                ASSERT_EQ(std::string(have), trimmed) << v << " " << (int) decimals;
+
+                // Exact fit and one byte short
+                MEMSET(have, 'x', sizeof(have));
+                ASSERT_EQ(fpuint64_to_str(have, (uint16_t) (expected.size() + 1), v, decimals), expected.size());
+                ASSERT_EQ(std::string(have), expected);
+                MEMSET(have, 'x', sizeof(have));
+                ASSERT_EQ(fpuint64_to_str_trimmed(have, (uint16_t) expected.size(), v, decimals), 0);
+                ASSERT_EQ(have[expected.size()], 'x');
+            }
+        }
+    }
+
+    TEST(DECIMAL_FORMAT, fpuint64_dense_ufix64) {
+        // A dense sweep of small UFix64 amounts, as rendered by the parser
+        char have[40];
+        char expected[BACKING_SIZE];
+        for (uint64_t v = 0; v <= 1000000; v++) {
+            const std::string reference = reference_fpuint64(v * 1000 + v % 1000, 8);
+            MEMZERO(expected, sizeof(expected));
+            MEMCPY(expected, reference.c_str(), reference.size());
+            number_inplace_trimming(expected);
+
+            ASSERT_NE(fpuint64_to_str_trimmed(have, sizeof(have), v * 1000 + v % 1000, 8), 0);
+            ASSERT_STREQ(have, expected);
+        }
+    }
+}
@@ -17,6 +17,7 @@
 #include "gmock/gmock.h"
 
 #include <hexutils.h>
+#include <random>
 #include "bignum.h"
 
 using ::testing::TestWithParam;
@@ -74,6 +75,17 @@ TEST_P(BignumLittleEndianTests, print) {
     EXPECT_THAT(std::string(bufferUI), testing::Eq(testcase.expectedOutput));
 }
 
+TEST_P(BignumLittleEndianTests, to_str) {
+    auto testcase = GetParam();
+
+    uint8_t inBuffer[100];
+    auto inBufferLen = parseHexString(inBuffer, sizeof(inBuffer), testcase.hex.c_str());
+
+    char bufferUI[300];
+    EXPECT_TRUE(bignumLittleEndian_to_str(bufferUI, sizeof(bufferUI), inBuffer, static_cast<uint16_t>(inBufferLen)));
+    EXPECT_THAT(std::string(bufferUI), testing::Eq(testcase.expectedOutput));
+}
+
 // Check that bignums are printed properly (range tests)
 TEST(BignumLittleEndianTests, range) {
     uint8_t inBuffer[100];
@@ -141,6 +153,17 @@ TEST_P(BignumBigEndianTests, print) {
     EXPECT_THAT(std::string(bufferUI), testing::Eq(testcase.expectedOutput));
 }
 
+TEST_P(BignumBigEndianTests, to_str) {
+    auto testcase = GetParam();
+
+    uint8_t inBuffer[100];
+    auto inBufferLen = parseHexString(inBuffer, sizeof(inBuffer), testcase.hex.c_str());
+
+    char bufferUI[300];
+    EXPECT_TRUE(bignumBigEndian_to_str(bufferUI, sizeof(bufferUI), inBuffer, static_cast<uint16_t>(inBufferLen)));
+    EXPECT_THAT(std::string(bufferUI), testing::Eq(testcase.expectedOutput));
+}
+
 // Check that bignums are printed properly (range tests)
 TEST(BignumBigEndianTests, range) {
     uint8_t inBuffer[100];
@@ -162,3 +185,63 @@ TEST(BignumBigEndianTests, range) {
         EXPECT_THAT(std::string(bufferUI), testing::Eq(expected.str())) << s.str();
     }
 }
+
+// Compare the limb based conversion with double dabble for random values of every width
+TEST(BignumToStr, matches_bcd) {
+    std::mt19937 rng(0xb16);
+    uint8_t value[BIGNUM_TO_STR_MAX_BYTES];
+    uint8_t bcd[100];
+    char expected[300];
+    char have[300];
+
+    for (uint16_t len = 1; len <= BIGNUM_TO_STR_MAX_BYTES; len++) {
+        for (int i = 0; i < 50; i++) {
+            for (uint16_t j = 0; j < len; j++) {
+                value[j] = static_cast<uint8_t>(rng());
+            }
+            // also cover values with leading zeros and short limbs
+            if (i % 5 == 0) {
+                value[0] = 0;
+                value[len - 1] = 0;
+            }
+
+            bignumBigEndian_to_bcd(bcd, sizeof(bcd), value, len);
+            bignumBigEndian_bcdprint(expected, sizeof(expected), bcd, sizeof(bcd));
+            ASSERT_TRUE(bignumBigEndian_to_str(have, sizeof(have), value, len));
+            ASSERT_EQ(std::string(have), std::string(expected));
+
+            bignumLittleEndian_to_bcd(bcd, sizeof(bcd), value, len);
+            bignumLittleEndian_bcdprint(expected, sizeof(expected), bcd, sizeof(bcd));
+            ASSERT_TRUE(bignumLittleEndian_to_str(have, sizeof(have), value, len));
+            ASSERT_EQ(std::string(have), std::string(expected));
+        }
+    }
+}
+
+TEST(BignumToStr, buffer_too_small) {
+    // 2^64 - 1 = 18446744073709551615 (20 digits)
+    const uint8_t value[8] = {0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF};
+    char have[40];
+
+    EXPECT_TRUE(bignumBigEndian_to_str(have, 21, value, sizeof(value)));
+    EXPECT_EQ(std::string(have), "18446744073709551615");
+
+    EXPECT_FALSE(bignumBigEndian_to_str(have, 20, value, sizeof(value)));
+    EXPECT_EQ(std::string(have), "ERR");
+
+    EXPECT_FALSE(bignumBigEndian_to_str(have, 3, value, sizeof(value)));
+    EXPECT_EQ(std::string(have), "");
+
+    uint8_t wide[BIGNUM_TO_STR_MAX_BYTES + 1];
+    memset(wide, 0xFF, sizeof(wide));
+    EXPECT_FALSE(bignumBigEndian_to_str(have, sizeof(have), wide, sizeof(wide)));
+    EXPECT_EQ(std::string(have), "ERR");
+
+    // leading zero bytes do not count towards the limit
+    char wideOut[200];
+    wide[0] = 0;
+    EXPECT_TRUE(bignumBigEndian_to_str(wideOut, sizeof(wideOut), wide, sizeof(wide)));
+    EXPECT_EQ(strlen(wideOut), 155u);
+    EXPECT_FALSE(bignumLittleEndian_to_str(wideOut, sizeof(wideOut), wide, sizeof(wide)));
+    EXPECT_EQ(std::string(wideOut), "ERR");
+}
@@ -17,6 +17,7 @@
 #include "gmock/gmock.h"
 
 #include <string>
+#include <vector>
 
 #include "hexutils.h"
 
@@ -49,3 +50,78 @@ TEST(HEXUTILS, parseHexString2) {
     ASSERT_THAT(data[3], testing::Eq(0xe7));
     ASSERT_THAT(data[4], testing::Eq(0xee));
 }
+
+namespace {
+    // Nibble at a time reference, as array_to_hexstr used to be
+    std::string referenceEncode(const std::vector<uint8_t> &data) {
+        const char hexchars[] = "0123456789abcdef";
+        std::string s;
+        for (auto b : data) {
+            s += hexchars[b >> 4u];
+            s += hexchars[b & 0x0Fu];
+        }
+        return s;
+    }
+}
+
+TEST(HEXUTILS, encodeDecodeRoundtrip) {
+    // Cover lengths around every vector width
+    for (size_t len = 0; len < 140; len++) {
+        std::vector<uint8_t> data(len);
+        for (size_t i = 0; i < len; i++) {
+            data[i] = (uint8_t) (i * 37 + len);
+        }
+
+        std::vector<char> encoded(2 * len + 1);
+        ASSERT_THAT(hex_encode(encoded.data(), encoded.size(), data.data(), len), testing::Eq(2 * len));
+        const auto expected = referenceEncode(data);
+        ASSERT_THAT(std::string(encoded.data()), testing::Eq(expected));
+
+        std::vector<uint8_t> decoded(len + 1);
+        ASSERT_THAT(hex_decode(decoded.data(), decoded.size(), expected.c_str(), expected.size()), testing::Eq(len));
+        decoded.resize(len);
+        ASSERT_THAT(decoded, testing::Eq(data));
+    }
+}
+
+TEST(HEXUTILS, decodeUppercase) {
+    const std::string s = "BE333BE7EEbe333be7eeBE333BE7EEbe333be7eeBE333BE7EEbe333be7eeBE333BE7EEbe333be7ee";
+    uint8_t data[100];
+
+    ASSERT_THAT(hex_decode(data, sizeof(data), s.c_str(), s.size()), testing::Eq(s.size() / 2));
+    for (size_t i = 0; i < s.size() / 2; i += 5) {
+        ASSERT_THAT(data[i], testing::Eq(0xbe));
+        ASSERT_THAT(data[i + 4], testing::Eq(0xee));
+    }
+}
+
+TEST(HEXUTILS, decodeRejectsInvalidDigits) {
+    const std::string valid(128, 'a');
+    uint8_t data[100];
+
+    // Every position and every character that is not an hex digit
+    for (size_t pos = 0; pos < valid.size(); pos += 7) {
+        for (int c = 0; c < 256; c++) {
+            if (isxdigit(c)) {
+                continue;
+            }
+            auto s = valid;
+            s[pos] = (char) c;
+            ASSERT_THAT(hex_decode(data, sizeof(data), s.c_str(), s.size()), testing::Eq(0)) << pos << " " << c;
+        }
+    }
+
+    // odd length and short output
+    ASSERT_THAT(hex_decode(data, sizeof(data), "abc", 3), testing::Eq(0));
+    ASSERT_THAT(hex_decode(data, 1, "abcd", 4), testing::Eq(0));
+    ASSERT_THAT(parseHexString(data, sizeof(data), "12g4"), testing::Eq(0));
+}
+
+TEST(HEXUTILS, encodeShortBuffer) {
+    const uint8_t data[] = {0x12, 0x34};
+    char s[5];
+
+    ASSERT_THAT(hex_encode(s, 4, data, sizeof(data)), testing::Eq(0));
+    ASSERT_THAT(hex_encode(s, sizeof(s), data, sizeof(data)), testing::Eq(4));
+    ASSERT_THAT(std::string(s), testing::Eq("1234"));
+}
@@ -108,7 +108,8 @@ namespace {
 
         fpstr_to_str(output, sizeof(output), "", 6);
         printf("%10s\n", output);
-        EXPECT_EQ(std::string(output), "0.000000");
+        // the result and its NULL terminator do not fit in 8 bytes
+        EXPECT_EQ(std::string(output), "ERR");
 
         fpstr_to_str(output, sizeof(output), "", 7);
         printf("%10s\n", output);
@@ -129,7 +130,8 @@ namespace {
 
         fpstr_to_str(output, sizeof(output), "123", 6);
         printf("%10s\n", output);
-        EXPECT_EQ(std::string(output), "0.000123");
+        // the result and its NULL terminator do not fit in 8 bytes
+        EXPECT_EQ(std::string(output), "ERR");
 
         fpstr_to_str(output, sizeof(output), "123", 7);
         printf("%10s\n", output);
@@ -150,7 +152,8 @@ namespace {
 
         fpstr_to_str(output, sizeof(output), "123456", 6);
         printf("%10s\n", output);
-        EXPECT_EQ(std::string(output), "0.123456");
+        // the result and its NULL terminator do not fit in 8 bytes
+        EXPECT_EQ(std::string(output), "ERR");
 
         fpstr_to_str(output, sizeof(output), "123456", 7);
         printf("%10s\n", output);
@@ -170,7 +173,8 @@ namespace {
 
         fpstr_to_str(output, sizeof(output), "1234567", 2);
         printf("%10s\n", output);
-        EXPECT_EQ(std::string(output), "12345.67");
+        // the result and its NULL terminator do not fit in 8 bytes
+        EXPECT_EQ(std::string(output), "ERR");
 
         fpstr_to_str(output, sizeof(output), "12345678", 2);
         printf("%10s\n", output);
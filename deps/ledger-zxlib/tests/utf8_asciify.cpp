@@ -0,0 +1,87 @@
+/*******************************************************************************
+*   (c) 2021 Zondax GmbH
+*
+*  Licensed under the Apache License, Version 2.0 (the "License");
+*  you may not use this file except in compliance with the License.
+*  You may obtain a copy of the License at
+*
+*      http://www.apache.org/licenses/LICENSE-2.0
+*
+*  Unless required by applicable law or agreed to in writing, software
+*  distributed under the License is distributed on an "AS IS" BASIS,
+*  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+*  See the License for the specific language governing permissions and
+*  limitations under the License.
+********************************************************************************/
+#include <gmock/gmock.h>
+#include <zxmacros.h>
+
+namespace {
+    zxerr_t fold(const std::string &input, char *out, size_t outLen, size_t *foldedLen) {
+        return utf8_validate_asciify(input.data(), input.size(), out, outLen, foldedLen);
+    }
+
+    TEST(UTF8_ASCIIFY, pure) {
+        // Long enough to take the vector path
+        const std::string input = "This is only ascii, and it is long enough to cover several blocks";
+        char have[100];
+        size_t foldedLen = 0;
+
+        EXPECT_EQ(fold(input, have, sizeof(have), &foldedLen), zxerr_ok);
+        EXPECT_EQ(foldedLen, input.size());
+        EXPECT_STREQ(have, input.c_str());
+    }
+
+    TEST(UTF8_ASCIIFY, same_as_asciify) {
+        const char *inputs[] = {"\05test", "cumpleaños", "哈Something哈", "0123456789abcdef哈0123456789abcdef", ""};
+
+        for (const auto input : inputs) {
+            char want[100];
+            char have[100];
+            size_t foldedLen = 0;
+
+            const size_t wantLen = asciify_ext(input, want);
+            EXPECT_EQ(fold(input, have, sizeof(have), &foldedLen), zxerr_ok) << input;
+            EXPECT_EQ(foldedLen, wantLen) << input;
+            EXPECT_STREQ(have, want) << input;
+        }
+    }
+
+    TEST(UTF8_ASCIIFY, validate_only) {
+        size_t foldedLen = 0;
+
+        EXPECT_EQ(fold("cumpleaños", nullptr, 0, &foldedLen), zxerr_ok);
+        EXPECT_EQ(foldedLen, 10);
+
+        EXPECT_EQ(fold("\xF0\x9F\x98\x80", nullptr, 0, &foldedLen), zxerr_ok);
+        EXPECT_EQ(foldedLen, 1);
+    }
+
+    TEST(UTF8_ASCIIFY, invalid) {
+        size_t foldedLen = 0;
+        char have[100];
+
+        // stray continuation byte
+        EXPECT_EQ(fold("abc\x80", have, sizeof(have), &foldedLen), zxerr_encoding_failed);
+        // overlong encoding of '/'
+        EXPECT_EQ(fold("\xC0\xAF", have, sizeof(have), &foldedLen), zxerr_encoding_failed);
+        // surrogate
+        EXPECT_EQ(fold("\xED\xA0\x80", have, sizeof(have), &foldedLen), zxerr_encoding_failed);
+        // above U+10FFFF
+        EXPECT_EQ(fold("\xF4\x90\x80\x80", have, sizeof(have), &foldedLen), zxerr_encoding_failed);
+        // truncated sequence
+        EXPECT_EQ(fold("abc\xE5\x93", have, sizeof(have), &foldedLen), zxerr_encoding_failed);
+        EXPECT_EQ(fold(std::string("0123456789abcdef0123456789abcdef\xFF"), nullptr, 0, &foldedLen),
+                  zxerr_encoding_failed);
+    }
+
+    TEST(UTF8_ASCIIFY, buffer_too_small) {
+        size_t foldedLen = 0;
+        char have[4];
+
+        EXPECT_EQ(fold("abc", have, sizeof(have), &foldedLen), zxerr_ok);
+        EXPECT_EQ(fold("abcd", have, sizeof(have), &foldedLen), zxerr_buffer_too_small);
+        EXPECT_EQ(fold("ab哈", have, sizeof(have), &foldedLen), zxerr_ok);
+        EXPECT_STREQ(have, "ab.");
+    }
+}
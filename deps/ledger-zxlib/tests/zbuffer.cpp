@@ -0,0 +1,108 @@
+/*******************************************************************************
+*   (c) 2020 Zondax GmbH
+*
+*  Licensed under the Apache License, Version 2.0 (the "License");
+*  you may not use this file except in compliance with the License.
+*  You may obtain a copy of the License at
+*
+*      http://www.apache.org/licenses/LICENSE-2.0
+*
+*  Unless required by applicable law or agreed to in writing, software
+*  distributed under the License is distributed on an "AS IS" BASIS,
+*  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+*  See the License for the specific language governing permissions and
+*  limitations under the License.
+********************************************************************************/
+#include <gmock/gmock.h>
+#include <cstring>
+#include "zbuffer.h"
+
+namespace {
+    TEST(ZBUFFER, scopes) {
+        zb_init();
+
+        zb_mark_t outer;
+        zb_mark(&outer);
+        void *a = nullptr;
+        ASSERT_EQ(zb_alloc(10, &a), zb_no_error);
+        memset(a, 0xAA, 10);
+
+        zb_mark_t inner;
+        zb_mark(&inner);
+        void *b = nullptr;
+        void *c = nullptr;
+        ASSERT_EQ(zb_alloc(100, &b), zb_no_error);
+        ASSERT_EQ(zb_alloc(1, &c), zb_no_error);
+        // blocks are rounded up to 4 bytes and followed by a canary
+        EXPECT_EQ((uint8_t *) b - (uint8_t *) a, 12 + 4);
+        EXPECT_EQ((uint8_t *) c - (uint8_t *) b, 100 + 4);
+        EXPECT_EQ(zb_high_water_mark(), 16 + 104 + 8);
+
+        // releasing the inner scope keeps the outer allocation, the space is reused
+        EXPECT_EQ(zb_release(inner), zb_no_error);
+        EXPECT_EQ(((uint8_t *) a)[9], 0xAA);
+        void *d = nullptr;
+        ASSERT_EQ(zb_alloc(4, &d), zb_no_error);
+        EXPECT_EQ(d, b);
+        EXPECT_EQ(((uint8_t *) d)[0], 0);
+
+        EXPECT_EQ(zb_release(outer), zb_no_error);
+        EXPECT_EQ(zb_high_water_mark(), 16 + 104 + 8);
+        // a mark above the current position is rejected
+        EXPECT_EQ(zb_release(inner), zb_invalid_mark);
+
+        zb_init();
+        EXPECT_EQ(zb_high_water_mark(), 0);
+    }
+
+    TEST(ZBUFFER, limits) {
+        zb_init();
+
+        zb_mark_t start;
+        zb_mark(&start);
+        void *p = nullptr;
+        EXPECT_EQ(zb_alloc(ZB_ARENA_SIZE, &p), zb_no_memory);
+        EXPECT_EQ(p, nullptr);
+        ASSERT_EQ(zb_alloc(ZB_ARENA_SIZE - 4, &p), zb_no_error);
+        EXPECT_EQ(zb_high_water_mark(), ZB_ARENA_SIZE);
+        EXPECT_EQ(zb_release(start), zb_no_error);
+
+        for (uint8_t i = 0; i < ZB_MAX_ALLOCATIONS; i++) {
+            ASSERT_EQ(zb_alloc(4, &p), zb_no_error);
+        }
+        EXPECT_EQ(zb_alloc(4, &p), zb_no_memory);
+        EXPECT_EQ(zb_release(start), zb_no_error);
+    }
+
+    TEST(ZBUFFER, canary) {
+        zb_init();
+
+        zb_mark_t start;
+        zb_mark(&start);
+        void *a = nullptr;
+        void *b = nullptr;
+        ASSERT_EQ(zb_alloc(8, &a), zb_no_error);
+        ASSERT_EQ(zb_alloc(8, &b), zb_no_error);
+        EXPECT_EQ(zb_check_canary(), zb_no_error);
+
+        // writing past the first block breaks its canary
+        memset(a, 0, 9);
+        EXPECT_EQ(zb_check_canary(), zb_canary_broken);
+        EXPECT_EQ(zb_release(start), zb_canary_broken);
+        EXPECT_EQ(zb_check_canary(), zb_no_error);
+    }
+
+    TEST(ZBUFFER, single_block) {
+        zb_init();
+
+        uint8_t *buffer = nullptr;
+        EXPECT_EQ(zb_get(&buffer), zb_not_allocated);
+        EXPECT_EQ(zb_deallocate(), zb_not_allocated);
+
+        ASSERT_EQ(zb_allocate(30), zb_no_error);
+        ASSERT_EQ(zb_get(&buffer), zb_no_error);
+        EXPECT_NE(buffer, nullptr);
+        EXPECT_EQ(zb_deallocate(), zb_no_error);
+        EXPECT_EQ(zb_get(&buffer), zb_not_allocated);
+    }
+}
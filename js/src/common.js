@@ -5,16 +5,44 @@ export const INS = {
   GET_VERSION: 0x00,
   GET_PUBKEY: 0x01,
   SIGN: 0x02,
+  GET_PUBKEYS: 0x03,
+  SIGN_BATCH: 0x04,
 
   SLOT_STATUS: 0x10,
   GET_SLOT: 0x11,
   SET_SLOT: 0x12,
+  EXPORT_SLOTS: 0x13,
+  IMPORT_SLOTS: 0x14,
+  FIND_SLOT: 0x15,
+};
+
+export const SLOT_IMPORT = {
+  INIT: 0x00,
+  ADD: 0x01,
+  REVIEW: 0x02,
 };
 
 export const PAYLOAD_TYPE = {
   INIT: 0x00,
   ADD: 0x01,
   LAST: 0x02,
+  SESSION_PATH: 0x03,
+  SEQ_ADD: 0x04,
+  SEQ_LAST: 0x05,
+  SEQ_STATUS: 0x06,
+};
+
+// Sequenced chunks carry a header (sequence number, offset and, in the last one, total length and CRC-32)
+export const SEQ_HEADER_LEN = 6;
+export const SEQ_LAST_HEADER_LEN = 14;
+export const SEQ_CHUNK_SIZE = 255 - SEQ_HEADER_LEN;
+export const SEQ_LAST_CHUNK_SIZE = 255 - SEQ_LAST_HEADER_LEN;
+export const SEQ_MAX_RETRIES = 3;
+
+// SIGN_BATCH uploads each transaction with INIT / ADD / LAST, then asks for the review and the signatures
+export const BATCH_PAYLOAD_TYPE = {
+  REVIEW: 0x07,
+  SIGNATURE: 0x08,
 };
 
 export const P1_VALUES = {
@@ -26,7 +54,18 @@ export const ERROR_CODE = {
   NoError: 0x9000,
 };
 
+export const SLOT_COUNT = 64;
+// Slot index, account and path
+export const SLOT_EXPORT_ENTRY_LEN = 1 + 8 + 20;
+// Import entries per request
+export const SLOT_IMPORT_PER_REQUEST = 8;
+
 export const PKLEN = 65;
+export const PKLEN_COMPRESSED = 33;
+
+// Keys per GET_PUBKEYS request, limited by the size of the reply
+export const GET_PUBKEYS_MAX = 3;
+export const GET_PUBKEYS_MAX_COMPRESSED = 7;
 
 const ERROR_DESCRIPTION = {
   1: "U2F: Unknown",
@@ -1,4 +1,16 @@
-import {CLA, errorCodeToString, INS, PAYLOAD_TYPE, processErrorResponse} from "./common";
+import {
+  BATCH_PAYLOAD_TYPE,
+  CLA,
+  errorCodeToString,
+  INS,
+  PAYLOAD_TYPE,
+  processErrorResponse,
+  SEQ_CHUNK_SIZE,
+  SEQ_HEADER_LEN,
+  SEQ_LAST_CHUNK_SIZE,
+  SEQ_LAST_HEADER_LEN,
+  SEQ_MAX_RETRIES,
+} from "./common";
 
 const HARDENED = 0x80000000;
 
@@ -74,6 +86,30 @@ export function printBIP44Path(pathBytes) {
   }`;
 }
 
+function processSignResponse(response) {
+  const errorCodeData = response.slice(-2);
+  const returnCode = errorCodeData[0] * 256 + errorCodeData[1];
+  let errorMessage = errorCodeToString(returnCode);
+
+  if (returnCode === 0x6a80 || returnCode === 0x6984) {
+    errorMessage = `${errorMessage} : ${response.slice(0, response.length - 2).toString("ascii")}`;
+  }
+
+  let signatureCompact = null;
+  let signatureDER = null;
+  if (response.length > 2) {
+    signatureCompact = response.slice(0, 65);
+    signatureDER = response.slice(65, response.length - 2);
+  }
+
+  return {
+    signatureCompact,
+    signatureDER,
+    returnCode: returnCode,
+    errorMessage: errorMessage,
+  };
+}
+
 export async function signSendChunkv1(app, chunkIdx, chunkNum, chunk) {
   let payloadType = PAYLOAD_TYPE.ADD;
   if (chunkIdx === 1) {
@@ -84,27 +120,142 @@ export async function signSendChunkv1(app, chunkIdx, chunkNum, chunk) {
   }
   return app.transport
     .send(CLA, INS.SIGN, payloadType, 0, chunk, [0x9000, 0x6984, 0x6a80])
+    .then(processSignResponse, processErrorResponse);
+}
+
+export async function signSessionPathv1(app, path) {
+  return app.transport
+    .send(CLA, INS.SIGN, PAYLOAD_TYPE.SESSION_PATH, 0, serializePathv1(path), [0x9000, 0x6984, 0x6a80])
+    .then(processSignResponse, processErrorResponse);
+}
+
+// CRC-32 (IEEE 802.3), checked by the device against the whole uploaded transaction
+export function crc32(buffer) {
+  let crc = 0xffffffff;
+  for (let i = 0; i < buffer.length; i += 1) {
+    crc ^= buffer[i];
+    for (let b = 0; b < 8; b += 1) {
+      crc = (crc >>> 1) ^ (0xedb88320 & -(crc & 1));
+    }
+  }
+  return (crc ^ 0xffffffff) >>> 0;
+}
+
+function sequencedHeader(length, seq, offset) {
+  const header = Buffer.alloc(length);
+  header.writeUInt16LE(seq, 0);
+  header.writeUInt32LE(offset, 2);
+  return header;
+}
+
+// Acknowledgement of the upload in progress: the next sequence number and the bytes received
+function readAck(response) {
+  return {
+    seq: response.readUInt16LE(0),
+    offset: response.readUInt32LE(2),
+  };
+}
+
+export async function signSequencedStatusv1(app) {
+  return app.transport.send(CLA, INS.SIGN, PAYLOAD_TYPE.SEQ_STATUS, 0, Buffer.alloc(0), [0x9000]).then(readAck);
+}
+
+async function signSequencedUploadv1(app, messageBuffer, start) {
+  let { seq, offset } = start;
+  let retries = 0;
+  while (messageBuffer.length - offset > SEQ_LAST_CHUNK_SIZE) {
+    const chunk = Buffer.concat([
+      sequencedHeader(SEQ_HEADER_LEN, seq, offset),
+      messageBuffer.slice(offset, offset + SEQ_CHUNK_SIZE),
+    ]);
+
+    let ack = { seq, offset };
+    try {
+      // eslint-disable-next-line no-await-in-loop
+      ack = readAck(await app.transport.send(CLA, INS.SIGN, PAYLOAD_TYPE.SEQ_ADD, 0, chunk, [0x9000]));
+      retries = ack.seq === seq + 1 ? 0 : retries + 1;
+    } catch (e) {
+      retries += 1;
+      if (retries > SEQ_MAX_RETRIES) {
+        return processErrorResponse(e);
+      }
+      // The reply may have been lost after the chunk was stored, continue from what the device has
+      try {
+        // eslint-disable-next-line no-await-in-loop
+        ack = await signSequencedStatusv1(app);
+      } catch (statusError) {
+        // the same chunk is sent again, the device drops it if it already has it
+      }
+    }
+
+    if (retries > SEQ_MAX_RETRIES) {
+      return {
+        returnCode: 0x6984,
+        errorMessage: errorCodeToString(0x6984),
+      };
+    }
+    ({ seq, offset } = ack);
+  }
+
+  const header = sequencedHeader(SEQ_LAST_HEADER_LEN, seq, offset);
+  header.writeUInt32LE(messageBuffer.length, 6);
+  header.writeUInt32LE(crc32(messageBuffer), 10);
+  return app.transport
+    .send(CLA, INS.SIGN, PAYLOAD_TYPE.SEQ_LAST, 0, Buffer.concat([header, messageBuffer.slice(offset)]), [
+      0x9000,
+      0x6984,
+      0x6a80,
+    ])
+    .then(processSignResponse, processErrorResponse);
+}
+
+export async function signSequencedv1(app, path, message) {
+  try {
+    await app.transport.send(CLA, INS.SIGN, PAYLOAD_TYPE.INIT, 0, serializePathv1(path), [0x9000]);
+  } catch (e) {
+    return processErrorResponse(e);
+  }
+
+  return signSequencedUploadv1(app, Buffer.from(message), { seq: 0, offset: 0 });
+}
+
+// Continues an interrupted signSequencedv1 from the data the device already holds
+export async function resumeSignSequencedv1(app, message) {
+  let ack;
+  try {
+    ack = await signSequencedStatusv1(app);
+  } catch (e) {
+    return processErrorResponse(e);
+  }
+
+  return signSequencedUploadv1(app, Buffer.from(message), ack);
+}
+
+export async function signBatchSendChunkv1(app, payloadType, chunk) {
+  return app.transport
+    .send(CLA, INS.SIGN_BATCH, payloadType, 0, chunk, [0x9000, 0x6983, 0x6984, 0x6985, 0x6a80])
     .then((response) => {
       const errorCodeData = response.slice(-2);
       const returnCode = errorCodeData[0] * 256 + errorCodeData[1];
       let errorMessage = errorCodeToString(returnCode);
-
-      if (returnCode === 0x6a80 || returnCode === 0x6984) {
+      if (returnCode === 0x6984) {
         errorMessage = `${errorMessage} : ${response.slice(0, response.length - 2).toString("ascii")}`;
       }
-
-      let signatureCompact = null;
-      let signatureDER = null;
-      if (response.length > 2) {
-        signatureCompact = response.slice(0, 65);
-        signatureDER = response.slice(65, response.length - 2);
-      }
-
       return {
-        signatureCompact,
-        signatureDER,
-        returnCode: returnCode,
-        errorMessage: errorMessage,
+        returnCode,
+        errorMessage,
       };
     }, processErrorResponse);
 }
+
+export async function signBatchReviewv1(app) {
+  return app.transport
+    .send(CLA, INS.SIGN_BATCH, BATCH_PAYLOAD_TYPE.REVIEW, 0, Buffer.alloc(0), [0x9000, 0x6985, 0x6986, 0x6f01])
+    .then(processSignResponse, processErrorResponse);
+}
+
+export async function signBatchSignaturev1(app, idx) {
+  return app.transport
+    .send(CLA, INS.SIGN_BATCH, BATCH_PAYLOAD_TYPE.SIGNATURE, 0, Buffer.from([idx]), [0x9000, 0x6984, 0x6985, 0x6f01])
+    .then(processSignResponse, processErrorResponse);
+}
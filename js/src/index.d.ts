@@ -10,6 +10,10 @@ export interface ResponseAddress extends ResponseBase {
   address: string;
 }
 
+export interface ResponsePubKeys extends ResponseBase {
+  publicKeys: Buffer[];
+}
+
 export interface ResponseVersion extends ResponseBase {
   testMode: boolean;
   major: number;
@@ -35,6 +39,10 @@ export interface ResponseSign extends ResponseBase {
   signatureDER: Buffer;
 }
 
+export interface ResponseSignBatch extends ResponseBase {
+  signatures: { signatureCompact: Buffer; signatureDER: Buffer }[];
+}
+
 export interface ResponseSlotStatus extends ResponseBase {
   status: Buffer;
 }
@@ -45,6 +53,10 @@ export interface ResponseSlot extends ResponseBase {
   path: string;
 }
 
+export interface ResponseSlots extends ResponseBase {
+  slots: { slotIdx: number; account: string; path: string }[];
+}
+
 export interface FlowApp {
   new(transport: Transport): FlowApp;
 
@@ -52,10 +64,18 @@ export interface FlowApp {
   getAppInfo(): Promise<ResponseAppInfo>;
   getAddressAndPubKey(path: string): Promise<ResponseAddress>;
   showAddressAndPubKey(path: string): Promise<ResponseAddress>;
+  getPubKeys(paths: string[], compressed?: boolean): Promise<ResponsePubKeys>;
 
   slotStatus(): Promise<ResponseSlotStatus>;
   getSlot(slotIdx: number): Promise<ResponseSlot>;
+  getSlots(): Promise<ResponseSlots>;
+  findSlot(account: string): Promise<ResponseSlot>;
   setSlot(slotIdx: number, account: string, path: string): Promise<ResponseSlot>;
+  importSlots(slots: { slotIdx: number; account: string; path: string }[]): Promise<ResponseBase>;
 
   sign(path: string, message: Buffer): Promise<ResponseSign>;
+  signSequenced(path: string, message: Buffer): Promise<ResponseSign>;
+  resumeSignSequenced(message: Buffer): Promise<ResponseSign>;
+  signSessionPath(path: string): Promise<ResponseSign>;
+  signBatch(path: string, messages: Buffer[]): Promise<ResponseSignBatch>;
 }
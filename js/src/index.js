@@ -15,17 +15,35 @@
  *  limitations under the License.
  ******************************************************************************* */
 
-import {serializePathv1, printBIP44Path, signSendChunkv1} from "./helperV1";
+import {
+  serializePathv1,
+  printBIP44Path,
+  resumeSignSequencedv1,
+  signBatchReviewv1,
+  signBatchSendChunkv1,
+  signBatchSignaturev1,
+  signSendChunkv1,
+  signSequencedv1,
+  signSessionPathv1,
+} from "./helperV1";
 import {
   CHUNK_SIZE,
   CLA,
   ERROR_CODE,
   errorCodeToString,
   getVersion,
+  GET_PUBKEYS_MAX,
+  GET_PUBKEYS_MAX_COMPRESSED,
   INS,
   P1_VALUES,
+  PAYLOAD_TYPE,
   PKLEN,
+  PKLEN_COMPRESSED,
   processErrorResponse,
+  SLOT_COUNT,
+  SLOT_EXPORT_ENTRY_LEN,
+  SLOT_IMPORT,
+  SLOT_IMPORT_PER_REQUEST,
 } from "./common";
 
 function processGetAddrResponse(response) {
@@ -171,6 +189,35 @@ export default class FlowApp {
       .then(processGetAddrResponse, processErrorResponse);
   }
 
+  async getPubKeys(paths, compressed = false) {
+    const keyLen = compressed ? PKLEN_COMPRESSED : PKLEN;
+    const perRequest = compressed ? GET_PUBKEYS_MAX_COMPRESSED : GET_PUBKEYS_MAX;
+    const publicKeys = [];
+
+    for (let i = 0; i < paths.length; i += perRequest) {
+      const batch = paths.slice(i, i + perRequest);
+      const payload = Buffer.concat([Buffer.from([batch.length]), ...batch.map(serializePathv1)]);
+
+      let response;
+      try {
+        // eslint-disable-next-line no-await-in-loop
+        response = await this.transport.send(CLA, INS.GET_PUBKEYS, compressed ? 1 : 0, 0, payload, [0x9000]);
+      } catch (e) {
+        return processErrorResponse(e);
+      }
+
+      for (let k = 0; k < batch.length; k += 1) {
+        publicKeys.push(Buffer.from(response.slice(k * keyLen, (k + 1) * keyLen)));
+      }
+    }
+
+    return {
+      returnCode: ERROR_CODE.NoError,
+      errorMessage: errorCodeToString(ERROR_CODE.NoError),
+      publicKeys,
+    };
+  }
+
   async signSendChunk(chunkIdx, chunkNum, chunk) {
     return signSendChunkv1(this, chunkIdx, chunkNum, chunk);
   }
@@ -204,6 +251,60 @@ export default class FlowApp {
     }, processErrorResponse);
   }
 
+  // Same as sign(), with sequenced chunks: the device acknowledges what it has received, so a chunk
+  // that failed in transit is sent again, and the upload is checked against its length and CRC-32.
+  async signSequenced(path, message) {
+    return signSequencedv1(this, path, message);
+  }
+
+  // Continues a signSequenced() call that failed during the upload, for instance after reconnecting.
+  // Only the chunks the device has not received are sent, the path is the one of the interrupted call.
+  async resumeSignSequenced(message) {
+    return resumeSignSequencedv1(this, message);
+  }
+
+  // Signs the transaction approved by the last sign() call with another path, without uploading it again.
+  // The device only asks to confirm the path.
+  async signSessionPath(path) {
+    return signSessionPathv1(this, path);
+  }
+
+  // Signs several transactions with one review: the device shows counts and totals per transaction type,
+  // then every item of each transaction. Signatures are returned in the order of messages.
+  // Nano S does not support it.
+  async signBatch(path, messages) {
+    let result = await signBatchSendChunkv1(this, PAYLOAD_TYPE.INIT, serializePathv1(path));
+
+    for (let m = 0; m < messages.length && result.returnCode === ERROR_CODE.NoError; m += 1) {
+      const chunks = FlowApp.prepareChunks(Buffer.alloc(0), messages[m]).slice(1);
+      for (let i = 0; i < chunks.length && result.returnCode === ERROR_CODE.NoError; i += 1) {
+        const payloadType = i === chunks.length - 1 ? PAYLOAD_TYPE.LAST : PAYLOAD_TYPE.ADD;
+        // eslint-disable-next-line no-await-in-loop
+        result = await signBatchSendChunkv1(this, payloadType, chunks[i]);
+      }
+    }
+    if (result.returnCode !== ERROR_CODE.NoError) {
+      return { returnCode: result.returnCode, errorMessage: result.errorMessage, signatures: [] };
+    }
+
+    const signatures = [];
+    result = await signBatchReviewv1(this);
+    for (let i = 1; result.returnCode === ERROR_CODE.NoError; i += 1) {
+      signatures.push({ signatureCompact: result.signatureCompact, signatureDER: result.signatureDER });
+      if (i === messages.length) {
+        break;
+      }
+      // eslint-disable-next-line no-await-in-loop
+      result = await signBatchSignaturev1(this, i);
+    }
+
+    return {
+      returnCode: result.returnCode,
+      errorMessage: result.errorMessage,
+      signatures,
+    };
+  }
+
   async slotStatus() {
     return this.transport.send(CLA, INS.SLOT_STATUS, 0, 0).then((response) => {
       const errorCodeData = response.slice(-2);
@@ -244,6 +345,67 @@ export default class FlowApp {
     }, processErrorResponse);
   }
 
+  // Reads every occupied slot, several per request
+  async getSlots() {
+    const slots = [];
+    let next = 0;
+    while (next < SLOT_COUNT) {
+      let response;
+      try {
+        // eslint-disable-next-line no-await-in-loop
+        response = await this.transport.send(CLA, INS.EXPORT_SLOTS, 0, 0, Buffer.from([next]), [0x9000]);
+      } catch (e) {
+        return processErrorResponse(e);
+      }
+
+      const entries = response.slice(1, -2);
+      for (let i = 0; i + SLOT_EXPORT_ENTRY_LEN <= entries.length; i += SLOT_EXPORT_ENTRY_LEN) {
+        slots.push({
+          slotIdx: entries[i],
+          account: entries.slice(i + 1, i + 9).toString("hex"),
+          path: printBIP44Path(entries.slice(i + 9, i + SLOT_EXPORT_ENTRY_LEN)),
+        });
+      }
+      [next] = response;
+    }
+
+    return {
+      returnCode: ERROR_CODE.NoError,
+      errorMessage: errorCodeToString(ERROR_CODE.NoError),
+      slots,
+    };
+  }
+
+  // Looks up the lowest slot holding account
+  async findSlot(account) {
+    const serializedAccount = Buffer.from(account, "hex");
+    if (serializedAccount.length !== 8) {
+      return {
+        returnCode: 0,
+        errorMessage: "account is expected to be a hexstring 16 characters long",
+      };
+    }
+
+    return this.transport.send(CLA, INS.FIND_SLOT, 0, 0, serializedAccount, [0x9000, 0x6982]).then((response) => {
+      const errorCodeData = response.slice(-2);
+      const returnCode = errorCodeData[0] * 256 + errorCodeData[1];
+      if (returnCode !== ERROR_CODE.NoError) {
+        return {
+          returnCode,
+          errorMessage: errorCodeToString(returnCode),
+        };
+      }
+
+      return {
+        returnCode,
+        errorMessage: errorCodeToString(returnCode),
+        slotIdx: response[0],
+        account: response.slice(1, 9).toString("hex"),
+        path: printBIP44Path(response.slice(9, SLOT_EXPORT_ENTRY_LEN)),
+      };
+    }, processErrorResponse);
+  }
+
   async setSlot(slotIdx, account, path) {
     if (isNaN(slotIdx) || slotIdx < 0 || slotIdx > 63) {
       return {
@@ -281,4 +443,40 @@ export default class FlowApp {
     }, processErrorResponse);
   }
 
+  // Sets, updates or deletes (empty account and path "m/0/0/0/0/0") several slots after a single review
+  async importSlots(slots) {
+    const entries = [];
+    for (let i = 0; i < slots.length; i += 1) {
+      const { slotIdx, account, path } = slots[i];
+      const serializedAccount = Buffer.from(account, "hex");
+      if (isNaN(slotIdx) || slotIdx < 0 || slotIdx > 63 || serializedAccount.length !== 8) {
+        return {
+          returnCode: 0,
+          errorMessage: "each slot needs a slotIdx between 0 and 63 and a 16 characters long account",
+        };
+      }
+      entries.push(Buffer.concat([Buffer.from([slotIdx]), serializedAccount, serializePathv1(path)]));
+    }
+
+    try {
+      await this.transport.send(CLA, INS.IMPORT_SLOTS, SLOT_IMPORT.INIT, 0, Buffer.alloc(0), [0x9000]);
+      for (let i = 0; i < entries.length; i += SLOT_IMPORT_PER_REQUEST) {
+        const payload = Buffer.concat(entries.slice(i, i + SLOT_IMPORT_PER_REQUEST));
+        // eslint-disable-next-line no-await-in-loop
+        await this.transport.send(CLA, INS.IMPORT_SLOTS, SLOT_IMPORT.ADD, 0, payload, [0x9000]);
+      }
+    } catch (e) {
+      return processErrorResponse(e);
+    }
+
+    return this.transport.send(CLA, INS.IMPORT_SLOTS, SLOT_IMPORT.REVIEW, 0, Buffer.alloc(0)).then((response) => {
+      const errorCodeData = response.slice(-2);
+      const returnCode = errorCodeData[0] * 256 + errorCodeData[1];
+
+      return {
+        returnCode,
+        errorMessage: errorCodeToString(returnCode),
+      };
+    }, processErrorResponse);
+  }
 }
@@ -0,0 +1,348 @@
+/*******************************************************************************
+*   (c) 2021 Zondax GmbH
+*
+*  Licensed under the Apache License, Version 2.0 (the "License");
+*  you may not use this file except in compliance with the License.
+*  You may obtain a copy of the License at
+*
+*      http://www.apache.org/licenses/LICENSE-2.0
+*
+*  Unless required by applicable law or agreed to in writing, software
+*  distributed under the License is distributed on an "AS IS" BASIS,
+*  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+*  See the License for the specific language governing permissions and
+*  limitations under the License.
+********************************************************************************/
+
+#include "gmock/gmock.h"
+#include <hexutils.h>
+#include <string>
+#include <vector>
+#include "crypto.h"
+#include "crypto_host.h"
+
+namespace {
+    const uint32_t SCHEME_SECP256K1_SHA2 = 0x0201;
+    const uint32_t SCHEME_SECP256K1_SHA3 = 0x0203;
+    const uint32_t SCHEME_P256_SHA2 = 0x0301;
+    const uint32_t SCHEME_P256_SHA3 = 0x0303;
+
+    void setPath(uint32_t path[HDPATH_LEN_DEFAULT], uint32_t scheme) {
+        path[0] = HDPATH_0_DEFAULT;
+        path[1] = HDPATH_1_DEFAULT;
+        path[2] = 0x80000000u | scheme;
+        path[3] = 0;
+        path[4] = 0;
+    }
+
+    std::string toHex(const uint8_t *data, size_t len) {
+        std::vector<char> out(2 * len + 1);
+        array_to_hexstr(out.data(), out.size(), data, len);
+        return std::string(out.data());
+    }
+
+    std::vector<uint8_t> fromHex(const std::string &hex) {
+        std::vector<uint8_t> out(hex.size() / 2);
+        parseHexString(out.data(), out.size(), hex.c_str());
+        return out;
+    }
+
+    TEST(crypto, sha512) {
+        uint8_t digest[64];
+        crypto_host_sha512((const uint8_t *) "abc", 3, digest);
+        EXPECT_EQ(toHex(digest, sizeof(digest)),
+                  "ddaf35a193617abacc417349ae20413112e6fa4e89a97ea20a9eeee64b55d39a"
+                  "2192992a274fc1a836ba3c23a3feebbd454d4423643ce80e2a9ac94fa54ca49f");
+    }
+
+    // Same keys as the Zemu tests (tests_zemu/tests/basic.spec.js)
+    TEST(crypto, extractPublicKey) {
+        uint32_t path[HDPATH_LEN_DEFAULT];
+        uint8_t pubKey[SECP256K1_PK_LEN];
+
+        setPath(path, SCHEME_SECP256K1_SHA2);
+        ASSERT_EQ(crypto_extractPublicKey(path, pubKey, sizeof(pubKey)), zxerr_ok);
+        EXPECT_EQ(toHex(pubKey, sizeof(pubKey)),
+                  "04d7482bbaff7827035d5b238df318b10604673dc613808723efbd23fbc4b9fad3"
+                  "4a415828d924ec7b83ac0eddf22ef115b7c203ee39fb080572d7e51775ee54be");
+
+        setPath(path, SCHEME_P256_SHA2);
+        ASSERT_EQ(crypto_extractPublicKey(path, pubKey, sizeof(pubKey)), zxerr_ok);
+        EXPECT_EQ(toHex(pubKey, sizeof(pubKey)),
+                  "04db0a14364e5bf43a7ddda603522ddfee95c5ff12b48c49480f062e7aa9d20e84"
+                  "215eef9b8b76175f32802f75ed54110e29c7dc76054f24c028c312098e7177a3");
+
+        EXPECT_EQ(crypto_extractPublicKey(path, pubKey, sizeof(pubKey) - 1), zxerr_buffer_too_small);
+
+        setPath(path, 0x0101);
+        EXPECT_EQ(crypto_extractPublicKey(path, pubKey, sizeof(pubKey)), zxerr_invalid_crypto_settings);
+    }
+
+    // RFC6979 A.2.5, P-256 with SHA-256, message "sample"
+    TEST(crypto, rfc6979) {
+        const auto privateKey = fromHex("c9afa9d845ba75166b5c215767b1d6934e50c3db36e89b127b8a622b120f6721");
+        uint8_t digest[32];
+        sha256((const uint8_t *) "sample", 6, digest);
+
+        uint8_t der[73];
+        uint16_t derLen = 0;
+        unsigned int info = 0;
+        ASSERT_EQ(crypto_host_ecdsaSign(CURVE_SECP256R1, privateKey.data(), digest, der, sizeof(der), &derLen, &info),
+                  zxerr_ok);
+
+        uint8_t r[32], s[32], v;
+        ASSERT_EQ(convertDERtoRSV(der, info, r, s, &v), no_error);
+        EXPECT_EQ(toHex(r, 32), "efd48b2aacb6a8fd1140dd9cd45e81d69d2c877b56aaf991c34d0ea84eaf3716");
+        EXPECT_EQ(toHex(s, 32), "f7cb1c942d657c41d436c7a1b6e29f65f3e900dbb9aff4064dc4ab2f843acda8");
+        EXPECT_EQ(derLen, 2 + 2 + 33 + 2 + 33);
+    }
+
+    TEST(crypto, sign) {
+        struct {
+            uint32_t scheme;
+            const char *r;
+            const char *s;
+            uint8_t v;
+        } const cases[] = {
+                {SCHEME_SECP256K1_SHA2,
+                        "14b2c9989c0bd06e9a77e40e5251ad6d429b882eb02ae294a954d0862abcc429",
+                        "68bfb61ba52ed809e73660e5559d27af3dabebefdcc0410f84dc7a63c305f3b2", 0},
+                {SCHEME_SECP256K1_SHA3,
+                        "8d4f0a61b538a4efd4ba6e053525117fc8601b8eb467bd50793c59d15754b7be",
+                        "a62faec22f0b5d3aca9da0e7e9c4a7a3f5a8948ad76084d74958756fa5a21308", 1},
+                {SCHEME_P256_SHA2,
+                        "abf785c6a9c1b33bf6ec7002e96f161a449ff3a5f53132d2b21fff0d8189beda",
+                        "a68951d6f2687210877b3e58bec749b2e04f2e5f62e48d6cebedc0a613df16c1", 1},
+                {SCHEME_P256_SHA3,
+                        "f8fa677303a8d6baf91893716aa560502e2d9d2a2adec52d856f7dea115ab727",
+                        "34e2241b5211897e732f5bb6558b32d1b168434f34c899d5dd2393b57c7f4216", 0},
+        };
+
+        uint8_t message[100];
+        for (uint8_t i = 0; i < sizeof(message); i++) {
+            message[i] = i;
+        }
+
+        for (const auto &c : cases) {
+            uint32_t path[HDPATH_LEN_DEFAULT];
+            setPath(path, c.scheme);
+
+            uint8_t signature[32 + 32 + 1 + 73];
+            uint16_t sigSize = 0;
+            ASSERT_EQ(crypto_sign(path, message, sizeof(message), signature, sizeof(signature), &sigSize), zxerr_ok);
+            EXPECT_EQ(toHex(signature, 32), c.r) << std::hex << c.scheme;
+            EXPECT_EQ(toHex(signature + 32, 32), c.s) << std::hex << c.scheme;
+            EXPECT_EQ(signature[64], c.v) << std::hex << c.scheme;
+            // R || S || V || DER
+            EXPECT_EQ(sigSize, 65 + 2 + signature[65 + 1]);
+        }
+
+        uint32_t path[HDPATH_LEN_DEFAULT];
+        setPath(path, 0x0201 + 1);
+        uint8_t signature[32 + 32 + 1 + 73];
+        uint16_t sigSize = 0;
+        EXPECT_EQ(crypto_sign(path, message, sizeof(message), signature, sizeof(signature), &sigSize),
+                  zxerr_invalid_crypto_settings);
+    }
+
+    TEST(crypto, fillAddress) {
+        uint32_t path[HDPATH_LEN_DEFAULT];
+        setPath(path, SCHEME_SECP256K1_SHA2);
+
+        uint8_t buffer[200];
+        uint16_t addrLen = 0;
+        ASSERT_EQ(crypto_fillAddress(path, buffer, sizeof(buffer), &addrLen), zxerr_ok);
+        EXPECT_EQ(addrLen, SECP256K1_PK_LEN + 2 * SECP256K1_PK_LEN);
+        EXPECT_EQ(std::string((const char *) buffer + SECP256K1_PK_LEN, 2 * SECP256K1_PK_LEN),
+                  toHex(buffer, SECP256K1_PK_LEN));
+    }
+
+    TEST(crypto, fillPublicKeys) {
+        const uint32_t schemes[] = {SCHEME_SECP256K1_SHA2, SCHEME_P256_SHA3, SCHEME_P256_SHA2};
+        uint32_t paths[3][HDPATH_LEN_DEFAULT];
+        for (uint8_t i = 0; i < 3; i++) {
+            setPath(paths[i], schemes[i]);
+            paths[i][4] = i;
+        }
+
+        uint8_t keys[3 * SECP256K1_PK_LEN], compressed[3 * PK_COMPRESSED_LEN];
+        uint16_t keysLen = 0, compressedLen = 0;
+        ASSERT_EQ(crypto_fillPublicKeys(paths[0], 3, false, keys, sizeof(keys), &keysLen), zxerr_ok);
+        ASSERT_EQ(crypto_fillPublicKeys(paths[0], 3, true, compressed, sizeof(compressed), &compressedLen), zxerr_ok);
+        EXPECT_EQ(keysLen, sizeof(keys));
+        EXPECT_EQ(compressedLen, sizeof(compressed));
+
+        for (uint8_t i = 0; i < 3; i++) {
+            uint8_t answer[200];
+            uint16_t addrLen = 0;
+            ASSERT_EQ(crypto_fillAddress(paths[i], answer, sizeof(answer), &addrLen), zxerr_ok);
+            EXPECT_EQ(toHex(keys + i * SECP256K1_PK_LEN, SECP256K1_PK_LEN), toHex(answer, SECP256K1_PK_LEN));
+
+            const uint8_t *key = compressed + i * PK_COMPRESSED_LEN;
+            EXPECT_EQ(key[0], 0x02 + (answer[SECP256K1_PK_LEN - 1] & 1));
+            EXPECT_EQ(toHex(key + 1, 32), toHex(answer + 1, 32));
+        }
+
+        EXPECT_EQ(crypto_fillPublicKeys(paths[0], 3, false, keys, sizeof(keys) - 1, &keysLen), zxerr_buffer_too_small);
+        EXPECT_EQ(keysLen, 0);
+
+        paths[1][2] = 0x80000000u | 0x0101;
+        EXPECT_EQ(crypto_fillPublicKeys(paths[0], 3, true, compressed, sizeof(compressed), &compressedLen),
+                  zxerr_invalid_crypto_settings);
+    }
+
+    TEST(crypto, pubkeyCache) {
+        uint32_t path[HDPATH_LEN_DEFAULT];
+        uint8_t buffer[200], expected[200];
+        uint16_t addrLen = 0;
+        uint32_t hits = 0, misses = 0;
+
+        crypto_pubkeyCacheClear();
+        setPath(path, SCHEME_SECP256K1_SHA2);
+        ASSERT_EQ(crypto_fillAddress(path, expected, sizeof(expected), &addrLen), zxerr_ok);
+        ASSERT_EQ(crypto_fillAddress(path, buffer, sizeof(buffer), &addrLen), zxerr_ok);
+        EXPECT_EQ(MEMCMP(buffer, expected, sizeof(buffer)), 0);
+        crypto_pubkeyCacheStats(&hits, &misses);
+        EXPECT_EQ(hits, 1u);
+        EXPECT_EQ(misses, 1u);
+
+        // path[2] carries the hash, it is a different derivation
+        setPath(path, SCHEME_SECP256K1_SHA3);
+        ASSERT_EQ(crypto_fillAddress(path, buffer, sizeof(buffer), &addrLen), zxerr_ok);
+        EXPECT_NE(MEMCMP(buffer, expected, SECP256K1_PK_LEN), 0);
+        crypto_pubkeyCacheStats(&hits, &misses);
+        EXPECT_EQ(misses, 2u);
+
+        // evicted once more paths than entries have been used
+        for (uint32_t i = 1; i <= PUBKEY_CACHE_SIZE; i++) {
+            setPath(path, SCHEME_P256_SHA2);
+            path[4] = i;
+            ASSERT_EQ(crypto_fillAddress(path, buffer, sizeof(buffer), &addrLen), zxerr_ok);
+        }
+        setPath(path, SCHEME_SECP256K1_SHA2);
+        ASSERT_EQ(crypto_fillAddress(path, buffer, sizeof(buffer), &addrLen), zxerr_ok);
+        EXPECT_EQ(MEMCMP(buffer, expected, sizeof(buffer)), 0);
+        crypto_pubkeyCacheStats(&hits, &misses);
+        EXPECT_EQ(hits, 1u);
+        EXPECT_EQ(misses, 3u + PUBKEY_CACHE_SIZE);
+
+        // errors are not cached
+        setPath(path, 0x0101);
+        EXPECT_EQ(crypto_fillAddress(path, buffer, sizeof(buffer), &addrLen), zxerr_invalid_crypto_settings);
+        EXPECT_EQ(crypto_fillAddress(path, buffer, sizeof(buffer), &addrLen), zxerr_invalid_crypto_settings);
+
+        crypto_pubkeyCacheClear();
+        crypto_pubkeyCacheStats(&hits, &misses);
+        EXPECT_EQ(hits, 0u);
+        EXPECT_EQ(misses, 0u);
+    }
+
+    struct signed_item_t {
+        uint32_t path[HDPATH_LEN_DEFAULT];
+        uint8_t answer[200];
+        std::vector<uint8_t> message;
+        uint8_t signature[32 + 32 + 1 + 73];
+        uint16_t sigSize;
+    };
+
+    // Several keys per scheme and more items than one verification chunk
+    std::vector<signed_item_t> signItems() {
+        const uint32_t schemes[] = {SCHEME_SECP256K1_SHA2, SCHEME_SECP256K1_SHA3, SCHEME_P256_SHA2, SCHEME_P256_SHA3};
+        std::vector<signed_item_t> items;
+        for (uint32_t round = 0; round < 6; round++) {
+            for (uint32_t scheme : schemes) {
+                for (uint32_t account = 0; account < 4; account++) {
+                    signed_item_t item{};
+                    setPath(item.path, scheme);
+                    item.path[4] = account;
+                    uint16_t addrLen = 0;
+                    EXPECT_EQ(crypto_fillAddress(item.path, item.answer, sizeof(item.answer), &addrLen), zxerr_ok);
+                    item.message.resize(50 + round * 40 + account);
+                    for (size_t i = 0; i < item.message.size(); i++) {
+                        item.message[i] = (uint8_t) (i * round + scheme);
+                    }
+                    EXPECT_EQ(crypto_sign(item.path, item.message.data(), item.message.size(),
+                                          item.signature, sizeof(item.signature), &item.sigSize), zxerr_ok);
+                    items.push_back(item);
+                }
+            }
+        }
+        return items;
+    }
+
+    std::vector<crypto_verify_item_t> verifyItems(const std::vector<signed_item_t> &items) {
+        std::vector<crypto_verify_item_t> out;
+        for (const auto &item : items) {
+            out.push_back({item.path, item.answer, item.message.data(), (uint16_t) item.message.size(),
+                           item.signature, item.sigSize});
+        }
+        return out;
+    }
+
+    TEST(crypto, verifyBatch) {
+        const auto items = signItems();
+        const auto verify = verifyItems(items);
+        std::vector<crypto_verify_result_e> results(verify.size(), CRYPTO_VERIFY_FAILED);
+
+        EXPECT_EQ(crypto_verifyBatch(verify.data(), verify.size(), results.data()), verify.size());
+        for (size_t i = 0; i < results.size(); i++) {
+            EXPECT_EQ(results[i], CRYPTO_VERIFY_OK) << i;
+        }
+    }
+
+    TEST(crypto, verifyBatchRejects) {
+        auto items = signItems();
+        items.resize(8);
+
+        // 0: message, 1: S, 2: V, 3: DER disagrees with R, 4: truncated, 5: public key off the curve,
+        // 6: other account's key, 7: unknown scheme
+        items[0].message[3] ^= 1;
+        {
+            // last byte of S, in RSV and in DER so that both still agree
+            uint8_t *der = items[1].signature + 65;
+            items[1].signature[63] ^= 1;
+            der[6 + der[3] + der[5 + der[3]] - 1] ^= 1;
+        }
+        items[2].signature[64] ^= 1;
+        items[3].signature[65 + 10] ^= 1;
+        items[4].sigSize--;
+        items[5].answer[10] ^= 1;
+        MEMCPY(items[6].answer, items[7].answer, SECP256K1_PK_LEN);
+        items[7].path[2] = 0x80000000u | 0x0101;
+
+        const auto verify = verifyItems(items);
+        std::vector<crypto_verify_result_e> results(verify.size(), CRYPTO_VERIFY_OK);
+        EXPECT_EQ(crypto_verifyBatch(verify.data(), verify.size(), results.data()), 0u);
+
+        EXPECT_EQ(results[0], CRYPTO_VERIFY_FAILED);
+        EXPECT_EQ(results[1], CRYPTO_VERIFY_FAILED);
+        EXPECT_EQ(results[2], CRYPTO_VERIFY_INVALID_SIGNATURE);
+        EXPECT_EQ(results[3], CRYPTO_VERIFY_INVALID_SIGNATURE);
+        EXPECT_EQ(results[4], CRYPTO_VERIFY_INVALID_SIGNATURE);
+        EXPECT_EQ(results[5], CRYPTO_VERIFY_INVALID_PUBKEY);
+        EXPECT_EQ(results[6], CRYPTO_VERIFY_FAILED);
+        EXPECT_EQ(results[7], CRYPTO_VERIFY_INVALID_SCHEME);
+    }
+
+    // RFC6979 A.2.5 signature against its public key, without V
+    TEST(crypto, ecdsaVerifyRfc6979) {
+        const auto publicKey = fromHex("0460fed4ba255a9d31c961eb74c6356d68c049b8923b61fa6ce669622e60f29fb6"
+                                       "7903fe1008b8bc99a41ae9e95628bc64f2f1b20c2d7e9f5177a3c294d4462299");
+        const auto r = fromHex("efd48b2aacb6a8fd1140dd9cd45e81d69d2c877b56aaf991c34d0ea84eaf3716");
+        auto s = fromHex("f7cb1c942d657c41d436c7a1b6e29f65f3e900dbb9aff4064dc4ab2f843acda8");
+        uint8_t digest[32];
+        sha256((const uint8_t *) "sample", 6, digest);
+
+        const crypto_host_verify_item_t item = {publicKey.data(), digest, r.data(), s.data(), nullptr};
+        crypto_verify_result_e result;
+        EXPECT_EQ(crypto_host_ecdsaVerifyBatch(CURVE_SECP256R1, &item, 1, &result), 1u);
+        EXPECT_EQ(result, CRYPTO_VERIFY_OK);
+
+        EXPECT_EQ(crypto_host_ecdsaVerifyBatch(CURVE_SECP256K1, &item, 1, &result), 0u);
+        EXPECT_EQ(result, CRYPTO_VERIFY_INVALID_PUBKEY);
+
+        std::fill(s.begin(), s.end(), 0);
+        EXPECT_EQ(crypto_host_ecdsaVerifyBatch(CURVE_SECP256R1, &item, 1, &result), 0u);
+        EXPECT_EQ(result, CRYPTO_VERIFY_INVALID_SIGNATURE);
+    }
+}
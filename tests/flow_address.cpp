@@ -0,0 +1,152 @@
+/*******************************************************************************
+*   (c) 2021 Zondax GmbH
+*
+*  Licensed under the Apache License, Version 2.0 (the "License");
+*  you may not use this file except in compliance with the License.
+*  You may obtain a copy of the License at
+*
+*      http://www.apache.org/licenses/LICENSE-2.0
+*
+*  Unless required by applicable law or agreed to in writing, software
+*  distributed under the License is distributed on an "AS IS" BASIS,
+*  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+*  See the License for the specific language governing permissions and
+*  limitations under the License.
+********************************************************************************/
+
+#include "gmock/gmock.h"
+#include <random>
+#include <vector>
+#include "flow_address.h"
+
+namespace {
+    // Parity check matrix the syndrome tables are derived from
+    const uint32_t parityCheckMatrixColumns[] = {
+            0x00001, 0x00002, 0x00004, 0x00008,
+            0x00010, 0x00020, 0x00040, 0x00080,
+            0x00100, 0x00200, 0x00400, 0x00800,
+            0x01000, 0x02000, 0x04000, 0x08000,
+            0x10000, 0x20000, 0x40000, 0x7328d,
+            0x6689a, 0x6112f, 0x6084b, 0x433fd,
+            0x42aab, 0x41951, 0x233ce, 0x22a81,
+            0x21948, 0x1ef60, 0x1deca, 0x1c639,
+            0x1bdd8, 0x1a535, 0x194ac, 0x18c46,
+            0x1632b, 0x1529b, 0x14a43, 0x13184,
+            0x12942, 0x118c1, 0x0f812, 0x0e027,
+            0x0d00e, 0x0c83c, 0x0b01d, 0x0a831,
+            0x0982b, 0x07034, 0x0682a, 0x05819,
+            0x03807, 0x007d2, 0x00727, 0x0068e,
+            0x0067c, 0x0059d, 0x004eb, 0x003b4,
+            0x0036a, 0x002d9, 0x001c7, 0x0003f,
+    };
+
+    // Bit by bit validation the tables replaced
+    bool referenceValidate(uint64_t chainCodeWord, uint64_t address) {
+        uint64_t codeWord = address ^chainCodeWord;
+        if (codeWord == 0) {
+            return false;
+        }
+        uint64_t parity = 0;
+        for (uint16_t i = 0; i < FLOW_ADDRESS_LINEAR_CODE_N; i++) {
+            if ((codeWord & 1) == 1) {
+                parity ^= parityCheckMatrixColumns[i];
+            }
+            codeWord >>= 1;
+        }
+        return parity == 0;
+    }
+
+    chain_id_e referenceChainID(uint64_t address) {
+        if (referenceValidate(codeword_mainnet, address)) return CHAIN_ID_MAINNET;
+        if (referenceValidate(codeword_testnet, address)) return CHAIN_ID_TESTNET;
+        if (referenceValidate(codeword_emulatornet, address)) return CHAIN_ID_EMULATOR;
+        return CHAIN_ID_UNKNOWN;
+    }
+
+    TEST(flowAddress, syndromeTables) {
+        for (uint8_t bit = 0; bit < FLOW_ADDRESS_LINEAR_CODE_N; bit++) {
+            EXPECT_EQ(flowAddress_syndrome(1ull << bit), parityCheckMatrixColumns[bit]) << (int) bit;
+        }
+    }
+
+    TEST(flowAddress, knownAddresses) {
+        struct {
+            chain_id_e chain;
+            uint64_t index;
+            uint64_t address;
+        } const cases[] = {
+                {CHAIN_ID_MAINNET,  1,       0xe467b9dd11fa00df},
+                {CHAIN_ID_MAINNET,  2,       0xf233dcee88fe0abe},
+                {CHAIN_ID_MAINNET,  3,       0x1654653399040a61},
+                {CHAIN_ID_MAINNET,  4,       0xf919ee77447b7497},
+                {CHAIN_ID_MAINNET,  3564,    0x8d0e87b65159ae63},
+                {CHAIN_ID_MAINNET,  1162956, 0x3c5959b568896393},
+                {CHAIN_ID_TESTNET,  1,       0x8c5303eaa26202d6},
+                {CHAIN_ID_EMULATOR, 1,       0xf8d6e0586b0a20c7},
+        };
+
+        for (const auto &c : cases) {
+            uint64_t address = 0;
+            EXPECT_EQ(flowAddress_fromIndex(c.chain, c.index, &address), PARSER_OK);
+            EXPECT_EQ(address, c.address) << c.index;
+
+            chain_id_e chainID = CHAIN_ID_UNKNOWN;
+            EXPECT_EQ(flowAddress_chainID(c.address, &chainID), PARSER_OK);
+            EXPECT_EQ(chainID, c.chain);
+        }
+    }
+
+    TEST(flowAddress, fromIndexErrors) {
+        uint64_t address = 1;
+        EXPECT_EQ(flowAddress_fromIndex(CHAIN_ID_MAINNET, 0, &address), PARSER_VALUE_OUT_OF_RANGE);
+        EXPECT_EQ(address, 0u);
+        EXPECT_EQ(flowAddress_fromIndex(CHAIN_ID_MAINNET, FLOW_ADDRESS_MAX_INDEX + 1, &address),
+                  PARSER_VALUE_OUT_OF_RANGE);
+        EXPECT_EQ(flowAddress_fromIndex(CHAIN_ID_UNKNOWN, 1, &address), PARSER_UNEXPECTED_VALUE);
+
+        EXPECT_EQ(flowAddress_fromIndex(CHAIN_ID_TESTNET, FLOW_ADDRESS_MAX_INDEX, &address), PARSER_OK);
+        chain_id_e chainID = CHAIN_ID_UNKNOWN;
+        EXPECT_EQ(flowAddress_chainID(address, &chainID), PARSER_OK);
+        EXPECT_EQ(chainID, CHAIN_ID_TESTNET);
+
+        // The chain codewords themselves are index 0
+        EXPECT_EQ(flowAddress_chainID(codeword_mainnet, &chainID), PARSER_UNEXPECTED_VALUE);
+        EXPECT_EQ(flowAddress_chainID(codeword_testnet, &chainID), PARSER_UNEXPECTED_VALUE);
+        EXPECT_EQ(flowAddress_chainID(codeword_emulatornet, &chainID), PARSER_UNEXPECTED_VALUE);
+    }
+
+    TEST(flowAddress, batchMatchesReference) {
+        std::mt19937_64 rng(0xf10);
+        const chain_id_e chains[] = {CHAIN_ID_MAINNET, CHAIN_ID_TESTNET, CHAIN_ID_EMULATOR};
+
+        std::vector<uint64_t> addresses;
+        for (int i = 0; i < 3000; i++) {
+            uint64_t address = 0;
+            const uint64_t index = 1 + rng() % FLOW_ADDRESS_MAX_INDEX;
+            ASSERT_EQ(flowAddress_fromIndex(chains[i % 3], index, &address), PARSER_OK);
+            addresses.push_back(address);
+            // single bit errors are always detected
+            addresses.push_back(address ^ (1ull << (rng() % 64)));
+            addresses.push_back(rng());
+        }
+        const size_t generated = addresses.size();
+        addresses.push_back(codeword_mainnet);
+        addresses.push_back(codeword_testnet);
+        addresses.push_back(codeword_emulatornet);
+
+        std::vector<chain_id_e> chainIDs(addresses.size());
+        const size_t valid = flowAddress_validateBatch(addresses.data(), addresses.size(), chainIDs.data());
+
+        size_t expectedValid = 0;
+        for (size_t i = 0; i < addresses.size(); i++) {
+            const chain_id_e expected = referenceChainID(addresses[i]);
+            expectedValid += expected != CHAIN_ID_UNKNOWN;
+            ASSERT_EQ(chainIDs[i], expected) << std::hex << addresses[i];
+            if (i % 3 == 0 && i < generated) {
+                ASSERT_EQ(chainIDs[i], chains[(i / 3) % 3]);
+                ASSERT_EQ(chainIDs[i + 1], CHAIN_ID_UNKNOWN);
+            }
+        }
+        EXPECT_EQ(valid, expectedValid);
+    }
+}
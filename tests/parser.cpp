@@ -141,3 +141,262 @@ TEST(parser, printOptionalPublicKeys) {
     EXPECT_THAT(pageCountVar, 4);
 }
 
+
+// Numbers are decoded again from the argument, so the last decoded one is kept around
+parser_context_t decodedArgument = {nullptr, 0, 0};
+
+parser_error_t decodeArgument(const char *json, flow_argument_value_t *value) {
+    decodedArgument = {(const uint8_t *) json, (uint16_t) strlen(json), 0};
+    parsed_json_t parsedJson = {false};
+    parser_error_t err = json_parse(&parsedJson, json, strlen(json));
+    if (err != PARSER_OK) {
+        return err;
+    }
+    return json_readArgumentValue(&parsedJson, 0, value);
+}
+
+uint64_t decodedNumber(const flow_argument_value_t *value) {
+    uint64_t number = 0;
+    EXPECT_THAT(parser_argumentNumber(&decodedArgument, value, &number), PARSER_OK);
+    return number;
+}
+
+TEST(parser, decodeUFix64) {
+    flow_argument_value_t value;
+    char outValBuf[40];
+
+    EXPECT_THAT(decodeArgument("{\"type\":\"UFix64\",\"value\":\"545.77\"}", &value), PARSER_OK);
+    EXPECT_THAT(value.type, ARGUMENT_TYPE_UFIX64);
+    EXPECT_TRUE(value.hasValue);
+    EXPECT_THAT(decodedNumber(&value), 54577000000u);
+    EXPECT_THAT(parser_formatArgumentValue(&decodedArgument, &value, outValBuf, sizeof(outValBuf)), PARSER_OK);
+    EXPECT_STREQ(outValBuf, "545.77");
+
+    EXPECT_THAT(decodeArgument("{\"type\":\"UFix64\",\"value\":\"0.0\"}", &value), PARSER_OK);
+    EXPECT_TRUE(value.hasValue);
+    EXPECT_THAT(decodedNumber(&value), 0u);
+    EXPECT_THAT(parser_formatArgumentValue(&decodedArgument, &value, outValBuf, sizeof(outValBuf)), PARSER_OK);
+    EXPECT_STREQ(outValBuf, "0.0");
+
+    EXPECT_THAT(decodeArgument("{\"type\":\"UFix64\",\"value\":\"184467440737.09551615\"}", &value), PARSER_OK);
+    EXPECT_TRUE(value.hasValue);
+    EXPECT_THAT(decodedNumber(&value), UINT64_MAX);
+
+    // Well formed but above 2^64 - 1 when scaled, kept verbatim
+    EXPECT_THAT(decodeArgument("{\"type\":\"UFix64\",\"value\":\"184467440737.9551615\"}", &value), PARSER_OK);
+    EXPECT_FALSE(value.hasValue);
+
+    EXPECT_THAT(decodeArgument("{\"type\":\"UFix64\",\"value\":\"545\"}", &value), PARSER_UNEXPECTED_VALUE);
+    EXPECT_THAT(decodeArgument("{\"type\":\"UFix64\",\"value\":\".5\"}", &value), PARSER_UNEXPECTED_VALUE);
+    EXPECT_THAT(decodeArgument("{\"type\":\"UFix64\",\"value\":\"1.123456789\"}", &value), PARSER_UNEXPECTED_VALUE);
+    EXPECT_THAT(decodeArgument("{\"type\":\"UFix64\",\"value\":\"1.2.3\"}", &value), PARSER_UNEXPECTED_CHARACTERS);
+    EXPECT_THAT(decodeArgument("{\"type\":\"UFix64\",\"value\":\"-1.0\"}", &value), PARSER_UNEXPECTED_CHARACTERS);
+}
+
+TEST(parser, decodeAddress) {
+    flow_argument_value_t value;
+    char outValBuf[40];
+
+    EXPECT_THAT(decodeArgument("{\"type\":\"Address\",\"value\":\"0x99a8ac2c71d4f6bd\"}", &value), PARSER_OK);
+    EXPECT_THAT(value.type, ARGUMENT_TYPE_ADDRESS);
+    EXPECT_TRUE(value.hasValue);
+    EXPECT_THAT(decodedNumber(&value), 0x99a8ac2c71d4f6bdu);
+    EXPECT_THAT(parser_formatArgumentValue(&decodedArgument, &value, outValBuf, sizeof(outValBuf)), PARSER_OK);
+    EXPECT_STREQ(outValBuf, "0x99a8ac2c71d4f6bd");
+
+    chain_id_e chainID;
+    EXPECT_THAT(chainIDFromAddress(0x99a8ac2c71d4f6bdu, &chainID), PARSER_OK);
+    EXPECT_THAT(chainID, CHAIN_ID_TESTNET);
+    EXPECT_THAT(chainIDFromAddress(0xf19c161bc24cf4b4u, &chainID), PARSER_OK);
+    EXPECT_THAT(chainID, CHAIN_ID_MAINNET);
+    EXPECT_THAT(chainIDFromAddress(0xed2d4f9eb8bcd4acu, &chainID), PARSER_OK);
+    EXPECT_THAT(chainID, CHAIN_ID_EMULATOR);
+
+    EXPECT_THAT(decodeArgument("{\"type\":\"Address\",\"value\":\"0x99a8ac2c71d4f6be\"}", &value), PARSER_INVALID_ADDRESS);
+    EXPECT_THAT(decodeArgument("{\"type\":\"Address\",\"value\":\"99a8ac2c71d4f6bd\"}", &value), PARSER_INVALID_ADDRESS);
+    EXPECT_THAT(decodeArgument("{\"type\":\"Address\",\"value\":\"0x99a8ac2c71d4f6bd00\"}", &value), PARSER_INVALID_ADDRESS);
+    EXPECT_THAT(decodeArgument("{\"type\":\"Address\",\"value\":\"0x99a8ac2c71d4f6bg\"}", &value), PARSER_UNEXPECTED_CHARACTERS);
+
+    // Exactly 16 digits, leading zeros included
+    EXPECT_THAT(decodeArgument("{\"type\":\"Address\",\"value\":\"0x099a8ac2c71d4f6bd\"}", &value), PARSER_INVALID_ADDRESS);
+    EXPECT_THAT(decodeArgument("{\"type\":\"Address\",\"value\":\"0x1\"}", &value), PARSER_INVALID_ADDRESS);
+    EXPECT_THAT(decodeArgument("{\"type\":\"Address\",\"value\":\"0x\"}", &value), PARSER_INVALID_ADDRESS);
+}
+
+TEST(parser, decodeUInt) {
+    flow_argument_value_t value;
+
+    EXPECT_THAT(decodeArgument("{\"type\":\"UInt8\",\"value\":\"255\"}", &value), PARSER_OK);
+    EXPECT_THAT(value.type, ARGUMENT_TYPE_UINT8);
+    EXPECT_THAT(decodedNumber(&value), 255u);
+    EXPECT_THAT(decodeArgument("{\"type\":\"UInt8\",\"value\":\"256\"}", &value), PARSER_VALUE_OUT_OF_RANGE);
+
+    EXPECT_THAT(decodeArgument("{\"type\":\"UInt32\",\"value\":\"4294967295\"}", &value), PARSER_OK);
+    EXPECT_THAT(decodedNumber(&value), 4294967295u);
+    EXPECT_THAT(decodeArgument("{\"type\":\"UInt32\",\"value\":\"4294967296\"}", &value), PARSER_VALUE_OUT_OF_RANGE);
+
+    EXPECT_THAT(decodeArgument("{\"type\":\"UInt64\",\"value\":\"18446744073709551615\"}", &value), PARSER_OK);
+    EXPECT_THAT(decodedNumber(&value), UINT64_MAX);
+    EXPECT_THAT(decodeArgument("{\"type\":\"UInt64\",\"value\":\"18446744073709551616\"}", &value), PARSER_VALUE_OUT_OF_RANGE);
+
+    EXPECT_THAT(decodeArgument("{\"type\":\"UInt16\",\"value\":\"\"}", &value), PARSER_UNEXPECTED_VALUE);
+    EXPECT_THAT(decodeArgument("{\"type\":\"UInt16\",\"value\":\"1a\"}", &value), PARSER_UNEXPECTED_CHARACTERS);
+}
+
+TEST(parser, decodeStructure) {
+    flow_argument_value_t value;
+
+    EXPECT_THAT(decodeArgument(token2, &value), PARSER_OK);
+    EXPECT_THAT(value.type, ARGUMENT_TYPE_OPTIONAL);
+    EXPECT_TRUE(value.isNone);
+    EXPECT_FALSE(value.hasValue);
+
+    EXPECT_THAT(decodeArgument(token3, &value), PARSER_OK);
+    EXPECT_THAT(value.type, ARGUMENT_TYPE_OPTIONAL);
+    EXPECT_THAT(value.innerType, ARGUMENT_TYPE_UFIX64);
+    EXPECT_FALSE(value.isNone);
+    EXPECT_TRUE(value.hasValue);
+    EXPECT_THAT(decodedNumber(&value), 54577000000u);
+
+    EXPECT_THAT(decodeArgument(token5, &value), PARSER_OK);
+    EXPECT_THAT(value.type, ARGUMENT_TYPE_OPTIONAL);
+    EXPECT_THAT(value.innerType, ARGUMENT_TYPE_ARRAY);
+    EXPECT_THAT(value.elementCount, 2);
+    EXPECT_FALSE(value.hasValue);
+
+    EXPECT_THAT(decodeArgument("{\"type\":\"Array\",\"value\":[{\"type\":\"UInt8\",\"value\":\"1\"}]}", &value), PARSER_OK);
+    EXPECT_THAT(value.type, ARGUMENT_TYPE_ARRAY);
+    EXPECT_THAT(value.innerType, ARGUMENT_TYPE_UINT8);
+    EXPECT_THAT(value.elementCount, 1);
+
+    // Elements holding arrays of their own are skipped as a whole
+    EXPECT_THAT(decodeArgument("{\"type\":\"Array\",\"value\":["
+                               "{\"type\":\"Array\",\"value\":[{\"type\":\"UInt8\",\"value\":\"1\"},"
+                               "{\"type\":\"UInt8\",\"value\":\"2\"}]},"
+                               "{\"type\":\"Array\",\"value\":[]},"
+                               "{\"type\":\"Array\",\"value\":[{\"type\":\"UInt8\",\"value\":\"3\"}]}]}",
+                               &value), PARSER_OK);
+    EXPECT_THAT(value.innerType, ARGUMENT_TYPE_ARRAY);
+    EXPECT_THAT(value.elementCount, 3);
+    EXPECT_THAT(decodeArgument("{\"type\":\"Array\",\"value\":[]}", &value), PARSER_OK);
+    EXPECT_THAT(value.elementCount, 0);
+
+    // Every element has the type of the first one
+    EXPECT_THAT(decodeArgument("{\"type\":\"Array\",\"value\":[{\"type\":\"UInt8\",\"value\":\"1\"},"
+                               "{\"type\":\"String\",\"value\":\"1\"}]}", &value), PARSER_UNEXPECTED_TYPE);
+
+    EXPECT_THAT(decodeArgument("{\"type\":\"Int\",\"value\":\"-1\"}", &value), PARSER_OK);
+    EXPECT_THAT(value.type, ARGUMENT_TYPE_UNKNOWN);
+    EXPECT_FALSE(value.hasValue);
+
+    EXPECT_THAT(decodeArgument("{\"type\":\"Optional\",\"value\":{\"type\":\"Optional\",\"value\":null}}", &value),
+                PARSER_UNEXPECTED_TYPE);
+}
+
+TEST(parser, printLongString) {
+    char outValBuf[40];
+    uint8_t pageCountVar = 0;
+
+    // Longer than the 256 bytes a string argument used to be limited to
+    std::string longString;
+    for (int i = 0; i < 300; i++) {
+        longString += (char) ('a' + i % 26);
+    }
+    const std::string token = "{\"type\":\"String\",\"value\":\"" + longString + "\"}";
+    parser_context_t ctx = {(const uint8_t *) token.c_str(), (uint16_t) token.size(), 0};
+
+    parser_error_t err = parser_printArgumentString(&ctx, outValBuf, sizeof(outValBuf), 0, &pageCountVar);
+    EXPECT_THAT(err, PARSER_OK);
+    EXPECT_THAT(pageCountVar, 8);
+    EXPECT_STREQ(outValBuf, longString.substr(0, 39).c_str());
+
+    err = parser_printArgumentString(&ctx, outValBuf, sizeof(outValBuf), 7, &pageCountVar);
+    EXPECT_THAT(err, PARSER_OK);
+    EXPECT_STREQ(outValBuf, longString.substr(7 * 39).c_str());
+
+    // pages are numbered from 0, the page after the last one is out of range
+    err = parser_printArgumentString(&ctx, outValBuf, sizeof(outValBuf), 8, &pageCountVar);
+    EXPECT_THAT(err, PARSER_DISPLAY_PAGE_OUT_OF_RANGE);
+    EXPECT_THAT(pageCountVar, 8);
+}
+
+TEST(parser, workBudget) {
+    parsed_json_t parsedJson = {false};
+    parser_work_t work;
+    const parser_context_t ctx = {(const uint8_t *) token3, (uint16_t) strlen(token3), 0};
+
+    // json_parse itself does no accounting
+    parser_resetWork();
+    EXPECT_THAT(json_parse(&parsedJson, token3, strlen(token3)), PARSER_OK);
+    parser_getWork(&work);
+    EXPECT_THAT(parser_getWorkUnits(&work), 0);
+
+    EXPECT_THAT(parser_jsonParse(&parsedJson, &ctx), PARSER_OK);
+    parser_getWork(&work);
+    EXPECT_THAT(work.tokensScanned, parsedJson.numberOfTokens);
+    EXPECT_THAT(work.bytesHashed, 0);
+    EXPECT_THAT(parser_getWorkUnits(&work), parsedJson.numberOfTokens);
+
+    EXPECT_THAT(parser_chargeWork(0, 65, 2), PARSER_OK);
+    parser_getWork(&work);
+    EXPECT_THAT(parser_getWorkUnits(&work), parsedJson.numberOfTokens + 2 + 2);
+
+    // Once the budget is spent the next parse is refused before the tokenizer runs
+    parser_resetWork();
+    parser_setWorkBudget(parsedJson.numberOfTokens);
+    EXPECT_THAT(parser_jsonParse(&parsedJson, &ctx), PARSER_OK);
+    parsed_json_t untouched = {false};
+    EXPECT_THAT(parser_jsonParse(&untouched, &ctx), PARSER_WORK_BUDGET_EXCEEDED);
+    EXPECT_FALSE(untouched.isValid);
+    EXPECT_THAT(untouched.numberOfTokens, 0);
+
+    parser_setWorkBudget(0);
+    parser_resetWork();
+}
+
+TEST(parser, stringUtf8) {
+    char outValBuf[8];
+    uint8_t pageCountVar = 0;
+    flow_argument_value_t value;
+
+    const std::string utf8Token = "{\"type\":\"String\",\"value\":\"cumplea\xC3\xB1os \xE5\x93\x88\"}";
+    parser_context_t ctx = {(const uint8_t *) utf8Token.c_str(), (uint16_t) utf8Token.size(), 0};
+
+    parser_tx_t tx;
+    tx.arguments.argCount = 1;
+    tx.arguments.argCtx[0] = ctx;
+    EXPECT_THAT(_decodeArguments(&tx.arguments), PARSER_OK);
+    EXPECT_TRUE(tx.arguments.argValue[0].validUtf8);
+    EXPECT_FALSE(tx.arguments.argValue[0].isAscii);
+
+    // "cumplea.os ." in pages of 7 characters
+    EXPECT_THAT(parser_printArgumentString(&ctx, outValBuf, sizeof(outValBuf), 0, &pageCountVar), PARSER_OK);
+    EXPECT_THAT(pageCountVar, 2);
+    EXPECT_STREQ(outValBuf, "cumplea");
+    EXPECT_THAT(parser_printArgumentString(&ctx, outValBuf, sizeof(outValBuf), 1, &pageCountVar), PARSER_OK);
+    EXPECT_STREQ(outValBuf, ".os .");
+    EXPECT_THAT(parser_printArgumentString(&ctx, outValBuf, sizeof(outValBuf), 2, &pageCountVar),
+                PARSER_DISPLAY_PAGE_OUT_OF_RANGE);
+
+    const std::string asciiToken = "{\"type\":\"String\",\"value\":\"abc\"}";
+    tx.arguments.argCtx[0] = {(const uint8_t *) asciiToken.c_str(), (uint16_t) asciiToken.size(), 0};
+    EXPECT_THAT(_decodeArguments(&tx.arguments), PARSER_OK);
+    EXPECT_TRUE(tx.arguments.argValue[0].isAscii);
+
+    const std::string invalidToken = "{\"type\":\"String\",\"value\":\"abc\xC0\xAF\"}";
+    tx.arguments.argCtx[0] = {(const uint8_t *) invalidToken.c_str(), (uint16_t) invalidToken.size(), 0};
+    EXPECT_THAT(_decodeArguments(&tx.arguments), PARSER_UNEXPECTED_CHARACTERS);
+
+    const std::string controlToken = "{\"type\":\"String\",\"value\":\"abc\x01\"}";
+    EXPECT_THAT(decodeArgument(controlToken.c_str(), &value), PARSER_UNEXPECTED_CHARACTERS);
+
+    // strings nested in arrays and optionals are displayed too
+    const std::string arrayToken = "{\"type\":\"Array\",\"value\":[{\"type\":\"String\",\"value\":\"ab\"},"
+                                   "{\"type\":\"String\",\"value\":\"c\x1b\"}]}";
+    EXPECT_THAT(decodeArgument(arrayToken.c_str(), &value), PARSER_UNEXPECTED_CHARACTERS);
+    const std::string optionalArrayToken = "{\"type\":\"Optional\",\"value\":{\"type\":\"Array\",\"value\":"
+                                           "[{\"type\":\"String\",\"value\":\"ab\"},{\"type\":\"String\",\"value\":\"c\x7f\"}]}}";
+    EXPECT_THAT(decodeArgument(optionalArrayToken.c_str(), &value), PARSER_UNEXPECTED_CHARACTERS);
+    const std::string optionalToken = "{\"type\":\"Optional\",\"value\":{\"type\":\"String\",\"value\":\"\x0a\"}}";
+    EXPECT_THAT(decodeArgument(optionalToken.c_str(), &value), PARSER_UNEXPECTED_CHARACTERS);
+}
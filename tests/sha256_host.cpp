@@ -0,0 +1,135 @@
+/*******************************************************************************
+*   (c) 2021 Zondax GmbH
+*
+*  Licensed under the Apache License, Version 2.0 (the "License");
+*  you may not use this file except in compliance with the License.
+*  You may obtain a copy of the License at
+*
+*      http://www.apache.org/licenses/LICENSE-2.0
+*
+*  Unless required by applicable law or agreed to in writing, software
+*  distributed under the License is distributed on an "AS IS" BASIS,
+*  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+*  See the License for the specific language governing permissions and
+*  limitations under the License.
+********************************************************************************/
+
+#include "gmock/gmock.h"
+#include <zxformat.h>
+#include <random>
+#include <string>
+#include <vector>
+#include "picosha2.h"
+#include "sha256_host.h"
+
+namespace {
+    std::string toHex(const uint8_t *data, size_t len) {
+        std::vector<char> out(2 * len + 1);
+        array_to_hexstr(out.data(), out.size(), data, len);
+        return std::string(out.data());
+    }
+
+    std::string hostDigest(const std::string &message) {
+        uint8_t digest[SHA256_HOST_DIGEST_SIZE];
+        sha256_host((const uint8_t *) message.data(), message.size(), digest);
+        return toHex(digest, sizeof(digest));
+    }
+
+    std::string picoDigest(const uint8_t *message, size_t len) {
+        uint8_t digest[SHA256_HOST_DIGEST_SIZE];
+        picosha2::hash256(message, message + len, digest, digest + sizeof(digest));
+        return toHex(digest, sizeof(digest));
+    }
+
+    const sha256_host_mode_e modes[] = {SHA256_HOST_AUTO, SHA256_HOST_PORTABLE, SHA256_HOST_SIMD_LANES};
+
+    class SHA256HostTest : public testing::TestWithParam<sha256_host_mode_e> {
+    public:
+        void SetUp() override {
+            if (!sha256_host_setMode(GetParam())) {
+                GTEST_SKIP() << "not supported by this CPU";
+            }
+        }
+
+        void TearDown() override {
+            sha256_host_setMode(SHA256_HOST_AUTO);
+        }
+    };
+
+    // FIPS 180-2 examples
+    TEST_P(SHA256HostTest, knownAnswers) {
+        EXPECT_EQ(hostDigest("abc"), "ba7816bf8f01cfea414140de5dae2223b00361a396177a9cb410ff61f20015ad");
+        EXPECT_EQ(hostDigest(""), "e3b0c44298fc1c149afbf4c8996fb92427ae41e4649b934ca495991b7852b855");
+        EXPECT_EQ(hostDigest("abcdbcdecdefdefgefghfghighijhijkijkljklmklmnlmnomnopnopq"),
+                  "248d6a61d20638b8e5c026930c3e6039a33ce45964ff2167f6ecedd419db06c1");
+        EXPECT_EQ(hostDigest(std::string(1000000, 'a')),
+                  "cdc76e5c9914fb9281a1c7e284d73e67f1809a48a497200e046d39ccc7112cd0");
+    }
+
+    // Every length around the one and two padding block boundaries
+    TEST_P(SHA256HostTest, matchesPicosha2) {
+        std::vector<uint8_t> message(300);
+        for (size_t i = 0; i < message.size(); i++) {
+            message[i] = (uint8_t) (i * 7 + 3);
+        }
+        for (size_t len = 0; len <= message.size(); len++) {
+            uint8_t digest[SHA256_HOST_DIGEST_SIZE];
+            sha256_host(message.data(), len, digest);
+            ASSERT_EQ(toHex(digest, sizeof(digest)), picoDigest(message.data(), len)) << len;
+        }
+    }
+
+    TEST_P(SHA256HostTest, incremental) {
+        std::mt19937 rng(256);
+        std::vector<uint8_t> message(1000);
+        for (auto &b : message) {
+            b = (uint8_t) rng();
+        }
+
+        for (int round = 0; round < 200; round++) {
+            const size_t len = rng() % message.size();
+            sha256_host_ctx_t ctx;
+            sha256_host_init(&ctx);
+            size_t offset = 0;
+            while (offset < len) {
+                const size_t chunk = std::min<size_t>(len - offset, rng() % 150);
+                sha256_host_update(&ctx, message.data() + offset, chunk);
+                offset += chunk;
+            }
+            uint8_t digest[SHA256_HOST_DIGEST_SIZE];
+            sha256_host_final(&ctx, digest);
+            ASSERT_EQ(toHex(digest, sizeof(digest)), picoDigest(message.data(), len)) << len;
+        }
+    }
+
+    // More messages than lanes, with mixed lengths so the lanes finish at different blocks
+    TEST_P(SHA256HostTest, multi) {
+        std::mt19937 rng(8);
+        for (size_t count : {0, 1, 7, 8, 9, 33}) {
+            std::vector<std::vector<uint8_t>> messages(count);
+            std::vector<const uint8_t *> pointers;
+            std::vector<size_t> lens;
+            for (auto &m : messages) {
+                m.resize(rng() % 400);
+                for (auto &b : m) {
+                    b = (uint8_t) rng();
+                }
+                pointers.push_back(m.data());
+                lens.push_back(m.size());
+            }
+
+            std::vector<uint8_t> digests(count * SHA256_HOST_DIGEST_SIZE);
+            sha256_host_multi(pointers.data(), lens.data(), count, digests.data());
+            for (size_t i = 0; i < count; i++) {
+                ASSERT_EQ(toHex(digests.data() + i * SHA256_HOST_DIGEST_SIZE, SHA256_HOST_DIGEST_SIZE),
+                          picoDigest(messages[i].data(), messages[i].size())) << count << " " << i;
+            }
+        }
+    }
+
+    INSTANTIATE_TEST_SUITE_P(
+            Modes,
+            SHA256HostTest,
+            ::testing::ValuesIn(modes)
+    );
+}
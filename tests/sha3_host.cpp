@@ -0,0 +1,156 @@
+/*******************************************************************************
+*   (c) 2021 Zondax GmbH
+*
+*  Licensed under the Apache License, Version 2.0 (the "License");
+*  you may not use this file except in compliance with the License.
+*  You may obtain a copy of the License at
+*
+*      http://www.apache.org/licenses/LICENSE-2.0
+*
+*  Unless required by applicable law or agreed to in writing, software
+*  distributed under the License is distributed on an "AS IS" BASIS,
+*  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+*  See the License for the specific language governing permissions and
+*  limitations under the License.
+********************************************************************************/
+
+#include "gmock/gmock.h"
+#include <zxformat.h>
+#include <random>
+#include <string>
+#include <vector>
+#include "parser.h"
+#include "parser_impl.h"
+#include "sha3_host.h"
+#include "flow_tx_id.h"
+
+namespace {
+    std::string toHex(const uint8_t *data, size_t len) {
+        std::vector<char> out(2 * len + 1);
+        array_to_hexstr(out.data(), out.size(), data, len);
+        return std::string(out.data());
+    }
+
+    std::vector<uint8_t> fromHex(const std::string &hex) {
+        std::vector<uint8_t> out(hex.size() / 2);
+        parseHexString(out.data(), out.size(), hex.c_str());
+        return out;
+    }
+
+    std::string sha3Digest(const uint8_t *message, size_t len) {
+        uint8_t digest[SHA3_256_HOST_DIGEST_SIZE];
+        sha3_256_host(message, len, digest);
+        return toHex(digest, sizeof(digest));
+    }
+
+    TEST(sha3Host, knownAnswers) {
+        EXPECT_EQ(sha3Digest((const uint8_t *) "abc", 3),
+                  "3a985da74fe225b2045c172d6bd390bd855f086e3e9d525b46bfe24511431532");
+        EXPECT_EQ(sha3Digest(nullptr, 0), "a7ffc6f8bf1ed76651c14756a061d662f580ff4de43b49fa82d80a4b80f8434a");
+
+        // one byte short of the rate and a full block, which needs an extra padding block
+        std::vector<uint8_t> block(SHA3_256_HOST_RATE, 'a');
+        EXPECT_EQ(sha3Digest(block.data(), SHA3_256_HOST_RATE - 1),
+                  "8094bb53c44cfb1e67b7c30447f9a1c33696d2463ecc1d9c92538913392843c9");
+        EXPECT_EQ(sha3Digest(block.data(), SHA3_256_HOST_RATE),
+                  "3fc5559f14db8e453a0a3091edbd2bc25e11528d81c66fa570a4efdcc2695ee1");
+
+        const std::string million(1000000, 'a');
+        EXPECT_EQ(sha3Digest((const uint8_t *) million.data(), million.size()),
+                  "5c8875ae474a3634ba4fd55ec85bffd661f32aca75c6d699d0cdcb6c115891c1");
+    }
+
+    TEST(sha3Host, incremental) {
+        std::mt19937 rng(3);
+        std::vector<uint8_t> message(1000);
+        for (auto &b : message) {
+            b = (uint8_t) rng();
+        }
+
+        for (int round = 0; round < 200; round++) {
+            const size_t len = rng() % message.size();
+            sha3_host_ctx_t ctx;
+            sha3_256_host_init(&ctx);
+            size_t offset = 0;
+            while (offset < len) {
+                const size_t chunk = std::min<size_t>(len - offset, rng() % 300);
+                sha3_256_host_update(&ctx, message.data() + offset, chunk);
+                offset += chunk;
+            }
+            uint8_t digest[SHA3_256_HOST_DIGEST_SIZE];
+            sha3_256_host_final(&ctx, digest);
+            ASSERT_EQ(toHex(digest, sizeof(digest)), sha3Digest(message.data(), len)) << len;
+        }
+    }
+
+    // "Example Transaction - Valid Envelope - Empty Authorizers"
+    const char *envelopeNoPayloadSigs =
+            "f9015df90159b86e7472616e73616374696f6e287075626c69634b65793a20537472696e6729207b0a70726570617265287369676e"
+            "65723a20417574684163636f756e7429207b0a7369676e65722e6164645075626c69634b6579287075626c69634b65792e6465636f"
+            "64654865782829290a7d0a7df8b0b8ae7b2274797065223a22537472696e67222c2276616c7565223a2266383437623834303934"
+            "3438386137393561303737303063366662383365303636636635376466643837663932636537306362633831636233626433666561"
+            "3264663762363730373362373065333662343466333537386234336436346433666161326538653431356566366332623566653433"
+            "393064356137386532333835383163366534626330323033383230336538227da0f0e4c2f76c58916ec258f246851bea091d14d424"
+            "7a2fc3e18694461b1816e13b2a88f19c161bc24cf4b4040a88f19c161bc24cf4b4c0c0";
+
+    // Same payload with one payload signature [0, 1, 0x22 * 64]
+    const char *envelopePayloadSig =
+            "f901a4f90159b86e7472616e73616374696f6e287075626c69634b65793a20537472696e6729207b0a70726570617265287369676e"
+            "65723a20417574684163636f756e7429207b0a7369676e65722e6164645075626c69634b6579287075626c69634b65792e6465636f"
+            "64654865782829290a7d0a7df8b0b8ae7b2274797065223a22537472696e67222c2276616c7565223a226638343762383430393434"
+            "3838613739356130373730306336666238336530363663663537646664383766393263653730636263383163623362643366656132"
+            "6466376236373037336237306533366234346633353738623433643634643366616132653865343135656636633262356665343339"
+            "3064356137386532333835383163366534626330323033383230336538227da0f0e4c2f76c58916ec258f246851bea091d14d4247a"
+            "2fc3e18694461b1816e13b2a88f19c161bc24cf4b4040a88f19c161bc24cf4b4c0f846f8448001b840222222222222222222222222"
+            "22222222222222222222222222222222222222222222222222222222222222222222222222222222222222222222222222222222";
+
+    // [[0, 0, 0x11 * 64]]
+    const char *envelopeSig =
+            "f846f8448080b840111111111111111111111111111111111111111111111111111111111111111111111111111111111111111111"
+            "11111111111111111111111111111111111111";
+
+    std::string txId(const char *envelopeHex, const std::string &signaturesHex) {
+        const auto envelope = fromHex(envelopeHex);
+        parser_context_t ctx;
+        EXPECT_EQ(parser_parse(&ctx, envelope.data(), envelope.size()), PARSER_OK);
+
+        const auto signatures = fromHex(signaturesHex);
+        uint8_t id[FLOW_TX_ID_SIZE];
+        EXPECT_EQ(flow_tx_id(&parser_tx_obj, signatures.data(), signatures.size(), id), PARSER_OK);
+        return toHex(id, sizeof(id));
+    }
+
+    // Expected IDs are SHA3-256 of the RLP encoded [payload, payloadSignatures, envelopeSignatures]
+    TEST(flowTxId, fromEnvelope) {
+        EXPECT_EQ(txId(envelopeNoPayloadSigs, "c0"),
+                  "f8bf31d9d015b1bd4152480abb9854e123176ae8d252fce346fe3d7c9787e93d");
+        EXPECT_EQ(txId(envelopeNoPayloadSigs, envelopeSig),
+                  "578800577405d030dbddbf930b8ce3d30cc626d37f3d6a0f346eabb3facb7670");
+        EXPECT_EQ(txId(envelopePayloadSig, envelopeSig),
+                  "e8f2182fabf38d087b2f30544a1f696a6c051e5196aa33352148672f07ef08e5");
+    }
+
+    TEST(flowTxId, errors) {
+        const auto envelope = fromHex(envelopeNoPayloadSigs);
+        parser_context_t ctx;
+        ASSERT_EQ(parser_parse(&ctx, envelope.data(), envelope.size()), PARSER_OK);
+
+        uint8_t id[FLOW_TX_ID_SIZE];
+        const uint8_t notAList[] = {0x80};
+        EXPECT_EQ(flow_tx_id(&parser_tx_obj, notAList, sizeof(notAList), id), PARSER_RLP_ERROR_INVALID_KIND);
+        const uint8_t trailing[] = {0xc0, 0x00};
+        EXPECT_EQ(flow_tx_id(&parser_tx_obj, trailing, sizeof(trailing), id), PARSER_UNEXPECTED_BUFFER_END);
+
+        // the envelope is exactly [payload, payloadSignatures]
+        const uint8_t noSignatures[] = {0xc0};
+        parser_tx_t tx = parser_tx_obj;
+        tx.envelope.bufferLen--;
+        EXPECT_EQ(flow_tx_id(&tx, noSignatures, sizeof(noSignatures), id), PARSER_UNEXPECTED_BUFFER_END);
+
+        std::vector<uint8_t> extraItem(envelope.begin() + 3, envelope.end());
+        extraItem.push_back(0xc0);
+        tx.envelope.buffer = extraItem.data();
+        tx.envelope.bufferLen = extraItem.size();
+        EXPECT_EQ(flow_tx_id(&tx, noSignatures, sizeof(noSignatures), id), PARSER_UNEXPECTED_NUMBER_ITEMS);
+    }
+}
@@ -0,0 +1,216 @@
+/*******************************************************************************
+*   (c) 2021 Zondax GmbH
+*
+*  Licensed under the Apache License, Version 2.0 (the "License");
+*  you may not use this file except in compliance with the License.
+*  You may obtain a copy of the License at
+*
+*      http://www.apache.org/licenses/LICENSE-2.0
+*
+*  Unless required by applicable law or agreed to in writing, software
+*  distributed under the License is distributed on an "AS IS" BASIS,
+*  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+*  See the License for the specific language governing permissions and
+*  limitations under the License.
+********************************************************************************/
+
+#include "gmock/gmock.h"
+#include <json/json.h>
+#include <zxformat.h>
+#include <fstream>
+#include <string>
+#include <vector>
+#include "parser.h"
+#include "tx_batch.h"
+
+namespace {
+    const uint32_t testnetPath[HDPATH_LEN_DEFAULT] = {HDPATH_0_TESTNET, HDPATH_1_TESTNET, 0x80000000u | 0x0301u, 0, 0};
+
+    std::vector<uint8_t> envelope(const std::string &title) {
+        Json::Value cases;
+        std::ifstream inFile("testvectors/manifestEnvelopeCases.json");
+        Json::CharReaderBuilder builder;
+        JSONCPP_STRING errs;
+        EXPECT_TRUE(Json::parseFromStream(builder, inFile, &cases, &errs)) << errs;
+
+        for (const auto &c : cases) {
+            if (c["title"].asString() == title && c["chainID"].asString() == "Testnet") {
+                const std::string hex = c["encodedTransactionEnvelopeHex"].asString();
+                std::vector<uint8_t> out(hex.size() / 2);
+                parseHexString(out.data(), out.size(), hex.c_str());
+                return out;
+            }
+        }
+        ADD_FAILURE() << "missing test vector " << title;
+        return {};
+    }
+
+    // Transactions of the batch one after the other, as in the transaction buffer
+    uint8_t storage[65536];
+    uint32_t storageLen;
+
+    const uint8_t *batchBuffer() {
+        return storage;
+    }
+
+    void reset() {
+        storageLen = 0;
+        tx_batch_reset(testnetPath, batchBuffer);
+    }
+
+    zxerr_t add(const std::string &title, uint8_t tag) {
+        const auto blob = envelope(title);
+        if (storageLen + blob.size() > sizeof(storage)) {
+            ADD_FAILURE() << "batch storage is full";
+            return zxerr_buffer_too_small;
+        }
+        std::copy(blob.begin(), blob.end(), storage + storageLen);
+
+        parser_context_t ctx;
+        EXPECT_EQ(parser_parse(&ctx, storage + storageLen, blob.size()), PARSER_OK) << title;
+
+        uint8_t digest[CRYPTO_DIGEST_SIZE];
+        memset(digest, tag, sizeof(digest));
+        const zxerr_t err = tx_batch_add(&ctx, storageLen, digest);
+        if (err == zxerr_ok) {
+            storageLen += blob.size();
+        }
+        return err;
+    }
+
+    // Items of a transaction reviewed alone
+    std::vector<std::string> items(const std::string &title) {
+        const auto blob = envelope(title);
+        parser_context_t ctx;
+        EXPECT_EQ(parser_parse(&ctx, blob.data(), blob.size()), PARSER_OK) << title;
+
+        std::vector<std::string> out;
+        uint8_t numItems = 0;
+        EXPECT_EQ(parser_getNumItems(&ctx, &numItems), PARSER_OK);
+        for (uint8_t i = 0; i < numItems; i++) {
+            char key[40];
+            char val[60];
+            uint8_t pageCount = 0;
+            EXPECT_EQ(parser_getItem(&ctx, i, key, sizeof(key), val, sizeof(val), 0, &pageCount), PARSER_OK);
+            out.push_back(std::string(key) + " : " + val);
+        }
+        return out;
+    }
+
+    std::vector<std::string> review() {
+        std::vector<std::string> out;
+        uint8_t numItems = 0;
+        EXPECT_EQ(tx_batch_getNumItems(&numItems), zxerr_ok);
+        for (uint8_t i = 0; i < numItems; i++) {
+            char key[40];
+            char val[60];
+            uint8_t pageCount = 0;
+            EXPECT_EQ(tx_batch_getItem(i, key, sizeof(key), val, sizeof(val), 0, &pageCount), zxerr_ok) << (int) i;
+            out.push_back(std::string(key) + " : " + val);
+        }
+        char key[40];
+        char val[60];
+        uint8_t pageCount = 0;
+        EXPECT_EQ(tx_batch_getItem(numItems, key, sizeof(key), val, sizeof(val), 0, &pageCount), zxerr_no_data);
+        return out;
+    }
+
+    TEST(txBatch, summary) {
+        reset();
+        ASSERT_TRUE(tx_batch_active());
+        EXPECT_EQ(tx_batch_getNumItems(nullptr), zxerr_no_data);
+
+        EXPECT_EQ(add("SCO.06 - Stake New Tokens - 1", 1), zxerr_ok);
+        EXPECT_EQ(add("SCO.01 - Setup Staking Collection", 2), zxerr_ok);
+        EXPECT_EQ(add("SCO.10 - Withdraw Rewarded Tokens - 1", 3), zxerr_ok);
+        EXPECT_EQ(tx_batch_count(), 3);
+
+        // a second maximal stake would overflow the total of its type, the batch is left as it was
+        EXPECT_EQ(add("SCO.06 - Stake New Tokens - 2", 4), zxerr_out_of_bounds);
+        EXPECT_EQ(add("SCO.10 - Withdraw Rewarded Tokens - 2", 5), zxerr_out_of_bounds);
+        EXPECT_EQ(tx_batch_count(), 3);
+
+        // the summary, then each transaction as it is reviewed alone, opened by its position
+        std::vector<std::string> expected = {
+                "Transactions : 3",
+                "Type 1 : Stake New Tokens",
+                "Count 1 : 1",
+                "Total 1 : 92233720368.54775808",
+                "Type 2 : Setup Staking Collection",
+                "Count 2 : 1",
+                "Type 3 : Withdraw Reward Tokens",
+                "Count 3 : 1",
+                "Total 3 : 92233720368.54775808",
+        };
+        const char *titles[] = {"SCO.06 - Stake New Tokens - 1",
+                                "SCO.01 - Setup Staking Collection",
+                                "SCO.10 - Withdraw Rewarded Tokens - 1"};
+        for (uint8_t i = 0; i < 3; i++) {
+            auto txItems = items(titles[i]);
+            ASSERT_GT(txItems.size(), 2u);
+            EXPECT_EQ(txItems[0].substr(0, 7), "Type : ");
+            txItems[0] = "Tx " + std::to_string(i + 1) + "/3 : " + txItems[0].substr(7);
+            expected.insert(expected.end(), txItems.begin(), txItems.end());
+        }
+        EXPECT_EQ(review(), expected);
+
+        // the transactions are parsed again out of order
+        char key[40];
+        char val[60];
+        uint8_t pageCount = 0;
+        ASSERT_EQ(tx_batch_getItem(9, key, sizeof(key), val, sizeof(val), 0, &pageCount), zxerr_ok);
+        EXPECT_EQ(std::string(key) + " : " + val, expected[9]);
+    }
+
+    TEST(txBatch, approval) {
+        reset();
+        EXPECT_EQ(add("SCO.07 - Stake Rewarded Tokens - 1", 7), zxerr_ok);
+        EXPECT_EQ(add("SCO.01 - Setup Staking Collection", 8), zxerr_ok);
+
+        // digests are released only after the review
+        uint8_t digest[CRYPTO_DIGEST_SIZE];
+        EXPECT_EQ(tx_batch_digest(0, digest), zxerr_unknown);
+
+        tx_batch_approve();
+        ASSERT_TRUE(tx_batch_approved());
+        ASSERT_EQ(tx_batch_digest(1, digest), zxerr_ok);
+        EXPECT_EQ(digest[0], 8);
+        EXPECT_EQ(tx_batch_digest(2, digest), zxerr_out_of_bounds);
+        EXPECT_EQ(add("SCO.01 - Setup Staking Collection", 9), zxerr_unknown);
+        EXPECT_EQ(tx_batch_path()[2], testnetPath[2]);
+
+        tx_batch_clear();
+        EXPECT_FALSE(tx_batch_active());
+        EXPECT_EQ(tx_batch_digest(0, digest), zxerr_unknown);
+        EXPECT_EQ(add("SCO.01 - Setup Staking Collection", 9), zxerr_unknown);
+
+        // an empty batch can not be approved
+        reset();
+        tx_batch_approve();
+        EXPECT_FALSE(tx_batch_approved());
+    }
+
+    TEST(txBatch, full) {
+        // the batch ends at TX_BATCH_MAX transactions or when the int8_t index of the view can not reach more items
+        const std::string title = "TH.12 - Unstake All FLOW";
+        reset();
+        zxerr_t err = zxerr_ok;
+        uint8_t added = 0;
+        while (err == zxerr_ok) {
+            err = add(title, added);
+            added += err == zxerr_ok ? 1 : 0;
+        }
+        ASSERT_EQ(err, zxerr_buffer_too_small);
+        ASSERT_EQ(tx_batch_count(), added);
+
+        uint8_t numItems = 0;
+        ASSERT_EQ(tx_batch_getNumItems(&numItems), zxerr_ok);
+        EXPECT_LE(numItems, TX_BATCH_MAX_ITEMS);
+        EXPECT_TRUE(added == TX_BATCH_MAX || numItems + items(title).size() > TX_BATCH_MAX_ITEMS);
+
+        const auto review_items = review();
+        ASSERT_EQ(review_items.size(), numItems);
+        EXPECT_EQ(review_items[2], "Count 1 : " + std::to_string(added));
+        EXPECT_EQ(review_items.back(), items(title).back());
+    }
+}
@@ -257,6 +257,95 @@ describe("Basic checks", function () {
         }
     });
 
+    test("slot export", async function () {
+        const sim = new Zemu(APP_PATH);
+        try {
+            await sim.start(simOptions);
+            const app = new FlowApp(sim.getTransport());
+
+            // Nothing stored yet
+            let respSlots = await app.getSlots();
+            expect(respSlots.returnCode).toEqual(0x9000);
+            expect(respSlots.slots).toEqual([]);
+
+            const scheme = FlowApp.Signature.SECP256K1 | FlowApp.Hash.SHA2_256;
+            const expectedPath = `m/44'/539'/${scheme}'/0/0`;
+            const expected = [
+                {slotIdx: 3, account: "0001020304050607", path: expectedPath},
+                {slotIdx: 63, account: "08090a0b0c0d0e0f", path: expectedPath},
+            ];
+            for (const slot of expected) {
+                const respSetRequest = app.setSlot(slot.slotIdx, slot.account, slot.path);
+                await sim.waitUntilScreenIsNot(sim.getMainMenuSnapshot());
+                await verifyAndAccept(sim, 3);
+                expect((await respSetRequest).returnCode).toEqual(0x9000);
+            }
+
+            respSlots = await app.getSlots();
+            expect(respSlots.returnCode).toEqual(0x9000);
+            expect(respSlots.slots).toEqual(expected);
+        } finally {
+            await sim.close();
+        }
+    });
+
+    test("slot import", async function () {
+        const sim = new Zemu(APP_PATH);
+        try {
+            await sim.start(simOptions);
+            const app = new FlowApp(sim.getTransport());
+
+            const scheme = FlowApp.Signature.P256 | FlowApp.Hash.SHA3_256;
+            const slots = [0, 1, 2].map((i) => ({
+                slotIdx: 20 + i,
+                account: `000000000000000${i}`,
+                path: `m/44'/539'/${scheme}'/0/${i}`,
+            }));
+
+            // Summary (4 items) and account and path of each slot
+            const respRequest = app.importSlots(slots);
+            await sim.waitUntilScreenIsNot(sim.getMainMenuSnapshot());
+            await verifyAndAccept(sim, 4 + 2 * slots.length);
+            expect((await respRequest).returnCode).toEqual(0x9000);
+
+            const respSlots = await app.getSlots();
+            expect(respSlots.returnCode).toEqual(0x9000);
+            expect(respSlots.slots).toEqual(slots);
+        } finally {
+            await sim.close();
+        }
+    });
+
+    test("slot find", async function () {
+        const sim = new Zemu(APP_PATH);
+        try {
+            await sim.start(simOptions);
+            const app = new FlowApp(sim.getTransport());
+
+            let respFind = await app.findSlot("0001020304050607");
+            expect(respFind.returnCode).toEqual(0x6982);
+
+            // The same account in two slots is found in the lower one
+            const scheme = FlowApp.Signature.P256 | FlowApp.Hash.SHA3_256;
+            const slots = [40, 9].map((slotIdx) => ({
+                slotIdx,
+                account: "0001020304050607",
+                path: `m/44'/539'/${scheme}'/0/${slotIdx}`,
+            }));
+            const respRequest = app.importSlots(slots);
+            await sim.waitUntilScreenIsNot(sim.getMainMenuSnapshot());
+            await verifyAndAccept(sim, 4 + 2 * slots.length);
+            expect((await respRequest).returnCode).toEqual(0x9000);
+
+            respFind = await app.findSlot("0001020304050607");
+            expect(respFind.returnCode).toEqual(0x9000);
+            expect(respFind.slotIdx).toEqual(9);
+            expect(respFind.path).toEqual(slots[1].path);
+        } finally {
+            await sim.close();
+        }
+    });
+
     // secp256k1
 
     test("get address - secp256k1", async function () {
@@ -285,6 +374,37 @@ describe("Basic checks", function () {
         }
     });
 
+    test("get pubkeys - batch", async function () {
+        const sim = new Zemu(APP_PATH);
+        try {
+            await sim.start(simOptions);
+            const app = new FlowApp(sim.getTransport());
+
+            const scheme = FlowApp.Signature.SECP256K1 | FlowApp.Hash.SHA2_256;
+            const paths = [0, 1, 2, 3, 4, 5, 6, 7, 8, 9].map((i) => `m/44'/539'/${scheme}'/0/${i}`);
+
+            const resp = await app.getPubKeys(paths);
+            expect(resp.returnCode).toEqual(0x9000);
+            expect(resp.publicKeys.length).toEqual(paths.length);
+
+            const respCompressed = await app.getPubKeys(paths, true);
+            expect(respCompressed.returnCode).toEqual(0x9000);
+
+            for (let i = 0; i < paths.length; i += 1) {
+                const single = await app.getAddressAndPubKey(paths[i]);
+                expect(resp.publicKeys[i].toString('hex')).toEqual(single.publicKey.toString('hex'));
+
+                const pk = single.publicKey;
+                expect(respCompressed.publicKeys[i][0]).toEqual(0x02 + (pk[64] & 1));
+                expect(respCompressed.publicKeys[i].slice(1).toString('hex')).toEqual(pk.slice(1, 33).toString('hex'));
+            }
+
+            expect(resp.publicKeys[0].toString('hex')).toEqual("04d7482bbaff7827035d5b238df318b10604673dc613808723efbd23fbc4b9fad34a415828d924ec7b83ac0eddf22ef115b7c203ee39fb080572d7e51775ee54be");
+        } finally {
+            await sim.close();
+        }
+    });
+
     test("show address - secp256k1", async function () {
         const sim = new Zemu(APP_PATH);
         try {
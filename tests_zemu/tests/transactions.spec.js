@@ -76,6 +76,23 @@ function getKeyPath(sigAlgo, hashAlgo) {
     return path;
 }
 
+function verifySignature(txBlob, signature, publicKey, sigAlgo, hashAlgo) {
+    // Prepare digest by hashing transaction
+    let tag = Buffer.alloc(32);
+    tag.write("FLOW-V0.0-transaction");
+
+    const hasher = new jsSHA(hashAlgo.name, "UINT8ARRAY");
+
+    hasher.update(tag);
+    hasher.update(txBlob);
+
+    const digest = hasher.getHash("HEX");
+
+    // Verify transaction signature against the digest
+    const ec = new EC(sigAlgo.name);
+    return ec.verify(digest, signature.toString("hex"), publicKey.toString("hex"), 'hex');
+}
+
 async function transactionTest(txHexBlob, txExpectedPageCount, sigAlgo, hashAlgo) {
 
     const sim = new Zemu(APP_PATH);
@@ -108,23 +125,7 @@ async function transactionTest(txHexBlob, txExpectedPageCount, sigAlgo, hashAlgo
         expect(resp.returnCode).toEqual(0x9000);
         expect(resp.errorMessage).toEqual("No errors");
 
-        // Prepare digest by hashing transaction
-        let tag = Buffer.alloc(32);
-        tag.write("FLOW-V0.0-transaction");
-
-        const hasher = new jsSHA(hashAlgo.name, "UINT8ARRAY");
-
-        hasher.update(tag);
-        hasher.update(txBlob);
-
-        const digest = hasher.getHash("HEX");
-
-        // Verify transaction signature against the digest
-        const ec = new EC(sigAlgo.name);
-        const sig = resp.signatureDER.toString("hex");
-        const pk = pkResponse.publicKey.toString("hex");
-
-        const signatureOk = ec.verify(digest, sig, pk, 'hex');
+        const signatureOk = verifySignature(txBlob, resp.signatureDER, pkResponse.publicKey, sigAlgo, hashAlgo);
         expect(signatureOk).toEqual(true);
     } finally {
         await sim.close();
@@ -180,6 +181,166 @@ describe("Basic transactions", () => {
     });
 })
 
+describe("Signing sessions", () => {
+    test("sign transaction with more paths without uploading it again", async () => {
+        const sim = new Zemu(APP_PATH);
+
+        try {
+            await sim.start(simOptions);
+            const app = new FlowApp(sim.getTransport());
+            const txBlob = Buffer.from(exampleTransferBlob, "hex");
+
+            // No approved transaction yet
+            const noSession = await app.signSessionPath(getKeyPath(ECDSA_P256.code, SHA3_256.code));
+            expect(noSession.returnCode).toEqual(0x6985);
+
+            const signers = [
+                { sigAlgo: ECDSA_SECP256K1, hashAlgo: SHA2_256 },
+                { sigAlgo: ECDSA_P256, hashAlgo: SHA3_256 },
+                { sigAlgo: ECDSA_P256, hashAlgo: SHA2_256 },
+            ];
+
+            for (let i = 0; i < signers.length; i += 1) {
+                const { sigAlgo, hashAlgo } = signers[i];
+                const path = getKeyPath(sigAlgo.code, hashAlgo.code);
+                const pkResponse = await app.getAddressAndPubKey(path);
+                expect(pkResponse.returnCode).toEqual(0x9000);
+
+                // The first signature reviews the whole transaction, the others only the path
+                const signatureRequest = i === 0 ? app.sign(path, txBlob) : app.signSessionPath(path);
+                await verifyAndAccept(sim, i === 0 ? 12 : 1);
+
+                const resp = await signatureRequest;
+                expect(resp.returnCode).toEqual(0x9000);
+                expect(verifySignature(txBlob, resp.signatureDER, pkResponse.publicKey, sigAlgo, hashAlgo)).toEqual(true);
+            }
+        } finally {
+            await sim.close();
+        }
+    });
+
+    test("data appended after the approval ends the session", async () => {
+        const sim = new Zemu(APP_PATH);
+
+        try {
+            await sim.start(simOptions);
+            const app = new FlowApp(sim.getTransport());
+            const transport = sim.getTransport();
+            const txBlob = Buffer.from(exampleTransferBlob, "hex");
+
+            const signatureRequest = app.sign(getKeyPath(ECDSA_SECP256K1.code, SHA2_256.code), txBlob);
+            await verifyAndAccept(sim, 12);
+            const resp = await signatureRequest;
+            expect(resp.returnCode).toEqual(0x9000);
+
+            // Plain and sequenced chunks can not extend the approved transaction
+            const extra = Buffer.from("c0", "hex");
+            let appended = await transport.send(0x33, 0x02, 0x01, 0x00, extra, [0x9000, 0x6985]);
+            expect(appended.readUInt16BE(appended.length - 2)).toEqual(0x6985);
+            appended = await transport.send(0x33, 0x02, 0x04, 0x00, Buffer.concat([Buffer.alloc(6), extra]), [0x9000, 0x6985]);
+            expect(appended.readUInt16BE(appended.length - 2)).toEqual(0x6985);
+
+            const noSession = await app.signSessionPath(getKeyPath(ECDSA_P256.code, SHA3_256.code));
+            expect(noSession.returnCode).toEqual(0x6985);
+        } finally {
+            await sim.close();
+        }
+    });
+});
+
+describe("Sequenced upload", () => {
+    test("sign transaction uploaded with sequenced chunks", async () => {
+        const sim = new Zemu(APP_PATH);
+
+        try {
+            await sim.start(simOptions);
+            const app = new FlowApp(sim.getTransport());
+            const transactions = JSON.parse(fs.readFileSync("../tests/testvectors/manifestEnvelopeCases.json"));
+            const tx = transactions.find((t) => t.title === "SCO.03 - Register Node - 4" && t.chainID === "Mainnet");
+            const txBlob = Buffer.from(tx.encodedTransactionEnvelopeHex, "hex");
+
+            const path = getKeyPath(ECDSA_P256.code, SHA3_256.code);
+            const pkResponse = await app.getAddressAndPubKey(path);
+            expect(pkResponse.returnCode).toEqual(0x9000);
+
+            const signatureRequest = app.signSequenced(path, txBlob);
+            await verifyAndAccept(sim, getTransactionPageCount(tx.envelopeMessage));
+
+            const resp = await signatureRequest;
+            expect(resp.returnCode).toEqual(0x9000);
+            expect(verifySignature(txBlob, resp.signatureDER, pkResponse.publicKey, ECDSA_P256, SHA3_256)).toEqual(true);
+        } finally {
+            await sim.close();
+        }
+    });
+});
+
+describe("Resumed upload", () => {
+    test("resume a sequenced upload from the acknowledged position", async () => {
+        const sim = new Zemu(APP_PATH);
+
+        try {
+            await sim.start(simOptions);
+            const app = new FlowApp(sim.getTransport());
+            const transport = sim.getTransport();
+            const transactions = JSON.parse(fs.readFileSync("../tests/testvectors/manifestEnvelopeCases.json"));
+            const tx = transactions.find((t) => t.title === "SCO.03 - Register Node - 4" && t.chainID === "Mainnet");
+            const txBlob = Buffer.from(tx.encodedTransactionEnvelopeHex, "hex");
+
+            const path = getKeyPath(ECDSA_P256.code, SHA3_256.code);
+            const pkResponse = await app.getAddressAndPubKey(path);
+            expect(pkResponse.returnCode).toEqual(0x9000);
+
+            // Start the upload by hand and stop after the first chunk
+            const pathBuffer = Buffer.alloc(20);
+            const pathValues = [0x8000002c, 0x8000021b, 0x80000000 | ECDSA_P256.code | SHA3_256.code, 0, 0];
+            pathValues.forEach((v, i) => pathBuffer.writeUInt32LE(v >>> 0, 4 * i));
+            await transport.send(0x33, 0x02, 0x00, 0x00, pathBuffer);
+
+            const header = Buffer.alloc(6);
+            const first = Buffer.concat([header, txBlob.slice(0, 249)]);
+            let ack = await transport.send(0x33, 0x02, 0x04, 0x00, first);
+            expect(ack.readUInt16LE(0)).toEqual(1);
+            expect(ack.readUInt32LE(2)).toEqual(249);
+
+            // Sending it again changes nothing
+            ack = await transport.send(0x33, 0x02, 0x04, 0x00, first);
+            expect(ack.readUInt16LE(0)).toEqual(1);
+            expect(ack.readUInt32LE(2)).toEqual(249);
+
+            const signatureRequest = app.resumeSignSequenced(txBlob);
+            await verifyAndAccept(sim, getTransactionPageCount(tx.envelopeMessage));
+
+            const resp = await signatureRequest;
+            expect(resp.returnCode).toEqual(0x9000);
+            expect(verifySignature(txBlob, resp.signatureDER, pkResponse.publicKey, ECDSA_P256, SHA3_256)).toEqual(true);
+        } finally {
+            await sim.close();
+        }
+    });
+});
+
+describe("Batch signing", () => {
+    test("INS_SIGN_BATCH is not available on Nano S", async () => {
+        const sim = new Zemu(APP_PATH);
+
+        try {
+            await sim.start(simOptions);
+            const app = new FlowApp(sim.getTransport());
+            const transactions = JSON.parse(fs.readFileSync("../tests/testvectors/manifestEnvelopeCases.json"));
+            const tx = transactions.find((t) => t.title === "SCO.01 - Setup Staking Collection" && t.chainID === "Mainnet");
+            const txBlob = Buffer.from(tx.encodedTransactionEnvelopeHex, "hex");
+
+            // The batch state does not fit in the RAM of the Nano S, the instruction is left out
+            const resp = await app.signBatch(getKeyPath(ECDSA_P256.code, SHA3_256.code), [txBlob]);
+            expect(resp.returnCode).toEqual(0x6d00);
+            expect(resp.signatures.length).toEqual(0);
+        } finally {
+            await sim.close();
+        }
+    });
+});
+
 describe("Staking transactions", () => {
     const transactions = JSON.parse(fs.readFileSync("../tests/testvectors/manifestEnvelopeCases.json"));
 